@@ -4,11 +4,20 @@
 # an AGC library.  To run this script, type ./buildAgcLib.sh"
 # Chris G. 09/16/2025
 #*****************************************************************************
-Compile="gcc -c -g  -O0 -Iinclude"
+# Set AGC_OPTIONS="-DAGC_FIXED_POINT" to build the fixed-point control law,
+# and add -DAGC_INSTRUMENTATION to measure latencies.  -DAGC_BANK_SCALAR_ONLY
+# leaves the AVX2 kernel out of the AGC bank.
+Compile="gcc -c -g -O2 -Iinclude $AGC_OPTIONS"
 
 # First compile the files of interest.
 $Compile src/AutomaticGainControl.c
 $Compile src/dbfsCalculator.c
+$Compile src/magnitudeEstimator.c
+$Compile src/agcBank.c
+$Compile src/agcInstrumentation.c
+$Compile src/agcTraceRecorder.c
+$Compile src/signalDetector.c
+$Compile src/digitalGain.c
 
 # Create the archive.
 ar rcs lib/libAutomaticGainControl.a *.o
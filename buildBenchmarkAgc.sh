@@ -0,0 +1,32 @@
+#!/bin/sh
+#*****************************************************************************
+# This build script creates the AGC benchmark program.  It assumes that all
+# the libraries have been built already.  If they have not been built type
+# ./buildLibs.sh.  The benchmark is built with optimization, since it
+# measures the performance of the library.
+# Chris G. 09/16/2025
+#*****************************************************************************
+
+Executable="bin/benchmarkAgc"
+
+CcFiles="\
+    src/benchmarkAgc.cc"
+
+Includes="\
+    -I include"
+ 
+# Compile string.
+Compile="g++ -g -O2 -o $Executable $Includes $CcFiles"
+
+# Link options
+LinkOptions="\
+    -O2 \
+    -L lib -lAutomaticGainControl \
+    -lm \
+    -lpthread"
+
+# Build our application.
+$Compile  $LinkOptions
+
+# We're done.
+exit 0
@@ -5,5 +5,6 @@
 # Chris G. 09/16/2025
 #*****************************************************************************
 sh buildAgcLib.sh
+sh buildSimulatorLib.sh
 
 exit 0
@@ -0,0 +1,31 @@
+#!/bin/sh
+#*****************************************************************************
+# This build script creates the recording replay program.  It assumes that all
+# the libraries have been built already.  If they have not been built type
+# ./buildLibs.sh.
+# Chris G. 09/16/2025
+#*****************************************************************************
+
+Executable="bin/replayAgc"
+
+CcFiles="\
+    src/replayAgc.cc"
+
+Includes="\
+    -I include"
+ 
+# Compile string.
+Compile="g++ -g -O2 -o $Executable $Includes $CcFiles"
+
+# Link options
+LinkOptions="\
+    -O2 \
+    -L lib -lAgcSimulator -lAutomaticGainControl \
+    -lm \
+    -lpthread"
+
+# Build our application.
+$Compile  $LinkOptions
+
+# We're done.
+exit 0
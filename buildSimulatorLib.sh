@@ -0,0 +1,21 @@
+#!/bin/sh
+#*****************************************************************************
+# This build script creates a static library that contains the closed-loop
+# AGC simulator and the recording replay.  To run this script, type
+# ./buildSimulatorLib.sh"
+# Chris G. 09/16/2025
+#*****************************************************************************
+Compile="gcc -c -g -O2 -Iinclude"
+
+# First compile the files of interest.
+$Compile src/agcSimulator.c
+$Compile src/agcReplay.c
+
+# Create the archive.
+ar rcs lib/libAgcSimulator.a agcSimulator.o agcReplay.o
+
+# Cleanup.
+rm agcSimulator.o agcReplay.o
+
+# We're done.
+exit 0
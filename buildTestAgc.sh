@@ -20,7 +20,8 @@ Compile="g++ -g -O0 -o $Executable $Includes $CcFiles"
 LinkOptions="\
     -O0 \
     -L lib -lAutomaticGainControl \
-    -lm"
+    -lm \
+    -lpthread"
 
 # Build our application.
 $Compile  $LinkOptions
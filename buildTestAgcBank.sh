@@ -0,0 +1,67 @@
+#!/bin/sh
+#*****************************************************************************
+# This build script creates the AGC bank test program.  It compiles the bank
+# a second time without its AVX2 kernel, so the test can run the vector and
+# scalar builds side by side.  The functions of the scalar build are renamed
+# to scalar_agcBank_xxx(), and its other symbols are made local, so the two
+# builds do not collide.  The vector build comes from the AGC library, so
+# type ./buildLibs.sh first.
+# Chris G. 09/16/2025
+#*****************************************************************************
+
+Executable="bin/testAgcBank"
+
+CcFiles="\
+    src/testAgcBank.cc"
+
+Includes="\
+    -I include"
+
+# The functions that the test invokes in the scalar build.
+ScalarFunctions="\
+    agcBank_create \
+    agcBank_destroy \
+    agcBank_init \
+    agcBank_setOperatingPoint \
+    agcBank_setAgcFilterCoefficient \
+    agcBank_setDeadband \
+    agcBank_setBlankingLimit \
+    agcBank_setGainInDb \
+    agcBank_run \
+    agcBank_getGains"
+
+# Compile the scalar build of the bank.
+gcc -c -g -O2 -Iinclude -DAGC_BANK_SCALAR_ONLY -o scalarAgcBank.o \
+    src/agcBank.c
+
+# Keep only the functions of interest, and rename them.
+KeepOptions=""
+RenameOptions=""
+
+for Function in $ScalarFunctions
+do
+  KeepOptions="$KeepOptions -G $Function"
+  RenameOptions="$RenameOptions --redefine-sym $Function=scalar_$Function"
+done
+
+objcopy $KeepOptions scalarAgcBank.o
+objcopy $RenameOptions scalarAgcBank.o
+
+# Compile string.
+Compile="g++ -g -O2 -o $Executable $Includes $CcFiles"
+
+# Link options
+LinkOptions="\
+    scalarAgcBank.o \
+    -L lib -lAutomaticGainControl \
+    -lm \
+    -lpthread"
+
+# Build our application.
+$Compile $LinkOptions
+
+# Cleanup.
+rm scalarAgcBank.o
+
+# We're done.
+exit 0
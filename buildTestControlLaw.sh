@@ -0,0 +1,67 @@
+#!/bin/sh
+#*****************************************************************************
+# This build script creates the control law test program.  It compiles the
+# AGC both with the floating point control law and with the fixed-point
+# control law, so the test can run both builds side by side.  The functions
+# of the fixed-point build are renamed to fixedPoint_agcInstance_xxx(), and
+# its other symbols are made local, so the two builds do not collide.  The
+# remaining files come from the AGC library, so type ./buildLibs.sh first.
+# Chris G. 09/16/2025
+#*****************************************************************************
+
+Executable="bin/testControlLaw"
+
+CcFiles="\
+    src/testControlLaw.cc"
+
+Includes="\
+    -I include"
+
+# The functions that the test invokes in the fixed-point build.
+FixedPointFunctions="\
+    agcInstance_create \
+    agcInstance_destroy \
+    agcInstance_init \
+    agcInstance_initWithGainSteps \
+    agcInstance_setAgcFilterCoefficient \
+    agcInstance_setDeadband \
+    agcInstance_enable \
+    agcInstance_acceptData"
+
+# Compile both builds of the AGC.
+gcc -c -g -O2 -Iinclude -o floatAgc.o src/AutomaticGainControl.c
+gcc -c -g -O2 -Iinclude -DAGC_FIXED_POINT -o fixedPointAgc.o \
+    src/AutomaticGainControl.c
+
+# Keep only the functions of interest, and rename them.
+KeepOptions=""
+RenameOptions=""
+
+for Function in $FixedPointFunctions
+do
+  KeepOptions="$KeepOptions -G $Function"
+  RenameOptions="$RenameOptions --redefine-sym $Function=fixedPoint_$Function"
+done
+
+objcopy $KeepOptions fixedPointAgc.o
+objcopy $RenameOptions fixedPointAgc.o
+
+# Compile string.
+Compile="g++ -g -O2 -o $Executable $Includes $CcFiles"
+
+# Link options
+LinkOptions="\
+    floatAgc.o \
+    fixedPointAgc.o \
+    -L lib -lAutomaticGainControl \
+    -lm \
+    -lpthread"
+
+# Build our application.
+$Compile $LinkOptions
+
+# Cleanup.
+rm floatAgc.o fixedPointAgc.o
+
+# We're done.
+exit 0
@@ -0,0 +1,23 @@
+#!/bin/sh
+#*****************************************************************************
+# This build script creates the trace file converter.  It does not use the
+# libraries, since it only needs the file format in agcTraceRecorder.h.
+# Chris G. 09/16/2025
+#*****************************************************************************
+
+Executable="bin/traceToCsv"
+
+CcFiles="\
+    src/traceToCsv.cc"
+
+Includes="\
+    -I include"
+ 
+# Compile string.
+Compile="g++ -g -O2 -o $Executable $Includes $CcFiles"
+
+# Build our application.
+$Compile
+
+# We're done.
+exit 0
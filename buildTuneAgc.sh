@@ -0,0 +1,30 @@
+#!/bin/sh
+#*****************************************************************************
+# This build script creates the AGC parameter tuner.  It assumes that all the libraries
+# have been built already.  If they have not been built type ./buildLibs.sh.
+# Chris G. 09/16/2025
+#*****************************************************************************
+
+Executable="bin/tuneAgc"
+
+CcFiles="\
+    src/tuneAgc.cc"
+
+Includes="\
+    -I include"
+ 
+# Compile string.
+Compile="g++ -g -O2 -o $Executable $Includes $CcFiles"
+
+# Link options
+LinkOptions="\
+    -O2 \
+    -L lib -lAgcSimulator -lAutomaticGainControl \
+    -lm \
+    -lpthread"
+
+# Build our application.
+$Compile  $LinkOptions
+
+# We're done.
+exit 0
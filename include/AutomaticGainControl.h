@@ -13,20 +13,305 @@ extern "C" {
 #include <unistd.h>
 #include <stdint.h>
 
+// Opaque handle to an AGC instance.
+struct agcInstance;
+
+// Opaque handle to a trace recorder (see agcTraceRecorder.h).
+struct agcTraceRecorder;
+
+// Magnitude estimation methods for IQ blocks.
+#define AGC_MAGNITUDE_ALPHA_MAX_BETA_MIN (0)
+#define AGC_MAGNITUDE_EXACT (1)
+
+// Signal detectors.
+#define AGC_DETECTOR_NONE (0)
+#define AGC_DETECTOR_MEAN (1)
+#define AGC_DETECTOR_RMS (2)
+#define AGC_DETECTOR_LOG_AVERAGE (3)
+#define AGC_DETECTOR_PEAK (4)
+
+// The longest detector window, in magnitudes.
+#define AGC_DETECTOR_MAX_WINDOW_LENGTH (1024)
+
+// Blanking modes.
+#define AGC_BLANKING_BY_INVOCATIONS (0)
+#define AGC_BLANKING_BY_DURATION (1)
+
+// Ways of discovering gain changes made by others.
+#define AGC_GAIN_SYNC_POLL (0)
+#define AGC_GAIN_SYNC_NOTIFY (1)
+
+// The most steps in a gain table, and the largest gain of a step.
+#define AGC_MAX_GAIN_STEPS (64)
+#define AGC_MAX_GAIN_STEP_IN_DB (255)
+
+// The most stages of a multi-stage amplifier.
+#define AGC_MAX_GAIN_STAGES (4)
+
+// Policies for distributing the gain over the stages.
+#define AGC_DISTRIBUTE_FRONT_FIRST (0)
+#define AGC_DISTRIBUTE_BACK_FIRST (1)
+#define AGC_DISTRIBUTE_EVENLY (2)
+
+// The gain range of a stage of a multi-stage amplifier.
+struct agcGainStage
+{
+  uint32_t minGainInDb;
+  uint32_t maxGainInDb;
+};
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// A snapshot of an AGC, as returned by agcInstance_getStats().  The
+// counters are cleared by initialization, and they never decrease.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+struct agcStats
+{
+  // Configuration.
+  int enabled;
+  uint32_t blankingLimit;
+  float filterCoefficient;
+  uint32_t deadbandInDb;
+  int32_t operatingPointInDbFs;
+  uint32_t maxAmplifierGainInDb;
+
+  // Loop state at the end of the most recent invocation.
+  uint32_t blankingCounter;
+  uint32_t gainInDb;
+  uint32_t signalMagnitude;
+  int32_t signalInDbFs;
+  int32_t normalizedSignalLevelInDbFs;
+
+  // Invocations of the AGC while it was enabled.
+  uint64_t invocationCount;
+
+  // Invocations that were ignored because of blanking.
+  uint64_t blankedCount;
+
+  // Gain errors that were ignored because they were within the deadband.
+  uint64_t deadbandSuppressionCount;
+
+  // Gain errors that were ignored because the gain was at its minimum.
+  uint64_t minGainClampCount;
+
+  // Gain errors that were ignored because the gain was at its maximum.
+  uint64_t maxGainClampCount;
+
+  // Gains that were written to the hardware (or to the gain actuator).
+  uint64_t gainWriteCount;
+
+  // IQ blocks that overloaded the ADC, and overload events (runs of
+  // overloaded blocks).
+  uint64_t overloadBlockCount;
+  uint64_t overloadEventCount;
+
+  // How long the ADC was clipped, in ticks, during the most recent
+  // overload event that has ended and during the longest one, and the
+  // clipped samples of the most recent one.
+  uint64_t lastOverloadDuration;
+  uint64_t longestOverloadDuration;
+  uint64_t lastOverloadClippedCount;
+};
+
+// Latency histograms, available when built with AGC_INSTRUMENTATION.
+#define AGC_LATENCY_INVOCATION (0)
+#define AGC_LATENCY_SET_GAIN_CALLBACK (1)
+#define AGC_LATENCY_GET_GAIN_CALLBACK (2)
+#define AGC_LATENCY_HISTOGRAM_COUNT (3)
+
+// Bucket k counts latencies in [2^k,2^(k+1)) nanoseconds.
+#define AGC_LATENCY_BUCKET_COUNT (32)
+
+struct agcLatencyReport
+{
+  uint64_t bucketCount[AGC_LATENCY_BUCKET_COUNT];
+  uint64_t sampleCount;
+  uint64_t maxLatencyInNs;
+  uint64_t p99LatencyInNs;
+  uint64_t budgetInNs;
+  uint64_t overrunCount;
+};
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// Multi-instance interface.  Each instance controls one amplifier.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+struct agcInstance *agcInstance_create(void);
+void agcInstance_destroy(struct agcInstance *agcPtr);
+
+// The callbacks of an instance are given the context pointer that was
+// passed at initialization, so each instance can find its amplifier.
+int agcInstance_init(struct agcInstance *agcPtr,
+    int32_t operatingPointInDbFs,
+    uint32_t maxAmplifierGainInDb,
+    uint32_t signalMagnitudeBitCount,
+    void (*setGainCallbackPtr)(void *contextPtr,uint32_t gainIndB),
+    uint32_t (*getGainCallbackPtr)(void *contextPtr),
+    void *contextPtr);
+
+int agcInstance_initWithGainSteps(struct agcInstance *agcPtr,
+    int32_t operatingPointInDbFs,
+    const uint32_t *gainStepInDbPtr,
+    uint32_t gainStepCount,
+    uint32_t signalMagnitudeBitCount,
+    void (*setGainStepCallbackPtr)(void *contextPtr,uint32_t gainStep),
+    uint32_t (*getGainStepCallbackPtr)(void *contextPtr),
+    void *contextPtr);
+
+int agcInstance_initWithGainStages(struct agcInstance *agcPtr,
+    int32_t operatingPointInDbFs,
+    const struct agcGainStage *stagePtr,
+    uint32_t stageCount,
+    int policy,
+    uint32_t signalMagnitudeBitCount,
+    void (*setStageGainsCallbackPtr)(void *contextPtr,
+        const uint32_t *stageGainInDbPtr),
+    void (*getStageGainsCallbackPtr)(void *contextPtr,
+        uint32_t *stageGainInDbPtr),
+    void *contextPtr);
+
+void agcInstance_setOperatingPoint(struct agcInstance *agcPtr,
+    int32_t operatingPointInDbFs);
+int agcInstance_setAgcFilterCoefficient(struct agcInstance *agcPtr,
+    float coefficient);
+int agcInstance_setDeadband(struct agcInstance *agcPtr,
+    uint32_t deadbandInDb);
+int agcInstance_setBlankingLimit(struct agcInstance *agcPtr,
+    uint32_t blankingLimit);
+int agcInstance_setBlankingMode(struct agcInstance *agcPtr,
+    int mode);
+void agcInstance_setBlankingDuration(struct agcInstance *agcPtr,
+    uint64_t blankingDuration);
+void agcInstance_getAdjustmentLatency(struct agcInstance *agcPtr,
+    uint64_t *lastLatencyPtr,
+    uint64_t *minLatencyPtr,
+    uint64_t *maxLatencyPtr);
+int agcInstance_enable(struct agcInstance *agcPtr);
+int agcInstance_disable(struct agcInstance *agcPtr);
+int agcInstance_isEnabled(struct agcInstance *agcPtr);
+void agcInstance_acceptData(struct agcInstance *agcPtr,
+    uint32_t signalMagnitude);
+void agcInstance_acceptDataAt(struct agcInstance *agcPtr,
+    uint32_t signalMagnitude,
+    uint64_t timestamp);
+void agcInstance_acceptIqBlockU8(struct agcInstance *agcPtr,
+    const uint8_t *iqPtr,
+    uint32_t sampleCount);
+void agcInstance_acceptIqBlockS8(struct agcInstance *agcPtr,
+    const int8_t *iqPtr,
+    uint32_t sampleCount);
+void agcInstance_acceptIqBlockS16(struct agcInstance *agcPtr,
+    const int16_t *iqPtr,
+    uint32_t sampleCount);
+void agcInstance_acceptMagnitudeBlock(struct agcInstance *agcPtr,
+    const uint32_t *signalMagnitudePtr,
+    uint32_t count);
+void agcInstance_applyResidualGainS8(struct agcInstance *agcPtr,
+    int8_t *iqPtr,
+    uint32_t sampleCount);
+void agcInstance_applyResidualGainS16(struct agcInstance *agcPtr,
+    int16_t *iqPtr,
+    uint32_t sampleCount);
+void agcInstance_applyResidualGainF32(struct agcInstance *agcPtr,
+    float *iqPtr,
+    uint32_t sampleCount);
+int agcInstance_setMagnitudeEstimator(struct agcInstance *agcPtr,
+    int estimator);
+int agcInstance_setDetector(struct agcInstance *agcPtr,
+    int mode,
+    uint32_t windowLength);
+int agcInstance_setDetectorSmoothing(struct agcInstance *agcPtr,
+    float attack,
+    float decay);
+int agcInstance_setOverloadDetection(struct agcInstance *agcPtr,
+    uint32_t clippedSampleLimit,
+    uint32_t gainCutInDb);
+void agcInstance_setResidualGain(struct agcInstance *agcPtr,int enabled);
+int agcInstance_setGainSyncMode(struct agcInstance *agcPtr,
+    int mode);
+void agcInstance_notifyExternalGainChange(struct agcInstance *agcPtr,
+    uint32_t gainInDb);
+int agcInstance_startGainActuator(struct agcInstance *agcPtr);
+int agcInstance_stopGainActuator(struct agcInstance *agcPtr);
+void agcInstance_getGainActuatorCounts(struct agcInstance *agcPtr,
+    uint32_t *appliedCountPtr,
+    uint32_t *coalescedCountPtr,
+    uint32_t *droppedCountPtr);
+void agcInstance_getStats(struct agcInstance *agcPtr,
+    struct agcStats *statsPtr);
+int agcInstance_getLatencyReport(struct agcInstance *agcPtr,
+    int histogram,
+    struct agcLatencyReport *reportPtr);
+int agcInstance_setLatencyBudget(struct agcInstance *agcPtr,
+    int histogram,
+    uint64_t budgetInNs);
+void agcInstance_setTraceRecorder(struct agcInstance *agcPtr,
+    struct agcTraceRecorder *recorderPtr);
+void agcInstance_displayInternalInformation(struct agcInstance *agcPtr,
+    char **displayBufferPtrPtr);
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// Single-instance interface.  These functions operate on a default
+// instance.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
 int agc_init(int32_t operatingPointInDbFs,
     uint32_t maxAmplifierGainInDb,
     uint32_t signalMagnitudeBitCount,
     void (*setGainCallbackPtr)(uint32_t gainIndB),
     uint32_t (*getGainCallbackPtr)(void));
 
+int agc_initWithGainSteps(int32_t operatingPointInDbFs,
+    const uint32_t *gainStepInDbPtr,
+    uint32_t gainStepCount,
+    uint32_t signalMagnitudeBitCount,
+    void (*setGainStepCallbackPtr)(uint32_t gainStep),
+    uint32_t (*getGainStepCallbackPtr)(void));
+
+int agc_initWithGainStages(int32_t operatingPointInDbFs,
+    const struct agcGainStage *stagePtr,
+    uint32_t stageCount,
+    int policy,
+    uint32_t signalMagnitudeBitCount,
+    void (*setStageGainsCallbackPtr)(const uint32_t *stageGainInDbPtr),
+    void (*getStageGainsCallbackPtr)(uint32_t *stageGainInDbPtr));
+
 void agc_setOperatingPoint(int32_t operatingPointInDbFs);
 int agc_setAgcFilterCoefficient(float coefficient);
 int agc_setDeadband(uint32_t deadbandInDb);
 int agc_setBlankingLimit(uint32_t blankingLimit);
+int agc_setBlankingMode(int mode);
+void agc_setBlankingDuration(uint64_t blankingDuration);
+void agc_getAdjustmentLatency(uint64_t *lastLatencyPtr,
+    uint64_t *minLatencyPtr,
+    uint64_t *maxLatencyPtr);
 int agc_enable(void);
 int agc_disable(void);
 int agc_isEnabled(void);
 void agc_acceptData(uint32_t signalMagnitude);
+void agc_acceptDataAt(uint32_t signalMagnitude,uint64_t timestamp);
+void agc_acceptIqBlockU8(const uint8_t *iqPtr,uint32_t sampleCount);
+void agc_acceptIqBlockS8(const int8_t *iqPtr,uint32_t sampleCount);
+void agc_acceptIqBlockS16(const int16_t *iqPtr,uint32_t sampleCount);
+void agc_acceptMagnitudeBlock(const uint32_t *signalMagnitudePtr,
+    uint32_t count);
+void agc_applyResidualGainS8(int8_t *iqPtr,uint32_t sampleCount);
+void agc_applyResidualGainS16(int16_t *iqPtr,uint32_t sampleCount);
+void agc_applyResidualGainF32(float *iqPtr,uint32_t sampleCount);
+int agc_setMagnitudeEstimator(int estimator);
+int agc_setDetector(int mode,uint32_t windowLength);
+int agc_setDetectorSmoothing(float attack,float decay);
+int agc_setOverloadDetection(uint32_t clippedSampleLimit,
+    uint32_t gainCutInDb);
+void agc_setResidualGain(int enabled);
+int agc_setGainSyncMode(int mode);
+void agc_notifyExternalGainChange(uint32_t gainInDb);
+int agc_startGainActuator(void);
+int agc_stopGainActuator(void);
+void agc_getGainActuatorCounts(uint32_t *appliedCountPtr,
+    uint32_t *coalescedCountPtr,
+    uint32_t *droppedCountPtr);
+void agc_getStats(struct agcStats *statsPtr);
+int agc_getLatencyReport(int histogram,struct agcLatencyReport *reportPtr);
+int agc_setLatencyBudget(int histogram,uint64_t budgetInNs);
+void agc_setTraceRecorder(struct agcTraceRecorder *recorderPtr);
 void agc_displayInternalInformation(char **displayBufferPtrPtr);
 
 #ifdef __cplusplus
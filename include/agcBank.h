@@ -0,0 +1,58 @@
+//**************************************************************************
+// file name: agcBank.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements a bank of AGC's that are stepped together.  It
+// is intended for channelizers, where hundreds of narrowband channels
+// each need their own gain.  The state of the channels is stored as
+// parallel arrays, and all channels are processed in one pass.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __AGCBANK__
+#define __AGCBANK__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// Opaque handle to a bank.
+struct agcBank;
+
+struct agcBank *agcBank_create(uint32_t channelCount);
+void agcBank_destroy(struct agcBank *bankPtr);
+
+int agcBank_init(struct agcBank *bankPtr,
+    int32_t operatingPointInDbFs,
+    uint32_t maxAmplifierGainInDb,
+    uint32_t signalMagnitudeBitCount);
+
+int agcBank_setOperatingPoint(struct agcBank *bankPtr,
+    uint32_t channel,
+    int32_t operatingPointInDbFs);
+int agcBank_setAgcFilterCoefficient(struct agcBank *bankPtr,
+    uint32_t channel,
+    float coefficient);
+int agcBank_setDeadband(struct agcBank *bankPtr,
+    uint32_t channel,
+    uint32_t deadbandInDb);
+int agcBank_setBlankingLimit(struct agcBank *bankPtr,
+    uint32_t channel,
+    uint32_t blankingLimit);
+int agcBank_setGainInDb(struct agcBank *bankPtr,
+    uint32_t channel,
+    uint32_t gainInDb);
+
+uint32_t agcBank_run(struct agcBank *bankPtr,
+    const uint32_t *signalMagnitudePtr,
+    uint32_t *changedChannelPtr);
+
+const uint32_t *agcBank_getGains(struct agcBank *bankPtr);
+uint32_t agcBank_getChannelCount(struct agcBank *bankPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __AGCBANK__
@@ -0,0 +1,232 @@
+//**************************************************************************
+// file name: agcControlLaw.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This file implements the gain filter of the AGC,
+// g(n+1) = g(n) + alpha * e(n), followed by the limiting of the gain to
+// [minAmplifierGainInDb,maxAmplifierGainInDb].  Limiting the filter
+// itself, rather than only the gain that is set, keeps it from winding
+// up past a rail, where it would have to climb back before the gain
+// could move again.  Two versions are provided: a floating point
+// version, and a fixed-point version for processors without a floating
+// point unit.  The AGC uses the fixed-point version when
+// AGC_FIXED_POINT is defined.
+//
+// The fixed-point version holds the filtered gain in Q16.16 format and
+// alpha in Q1.15 format.  The product alpha * e(n) is computed exactly,
+// so a single update differs from the floating point update only by the
+// quantization of alpha to 1/32768 and by float rounding, which is less
+// than 0.002dB for any gain error the AGC can produce.  In a closed loop
+// the integer gains can split by 1dB when the filtered gain lands at an
+// integer boundary, and the deadband can then hold the two loops apart.
+// testControlLaw runs the floating point and fixed-point builds of the
+// AGC on the same input, and verifies that once the input has settled
+// their gains never differ by more than 2dB (or 2 gain steps), and that
+// they agree on at least 90 percent of the updates.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __AGCCONTROLLAW__
+#define __AGCCONTROLLAW__
+
+#include <stdint.h>
+
+// Fixed-point formats.
+#define AGC_GAIN_FRACTIONAL_BITS (16)
+#define AGC_ALPHA_FRACTIONAL_BITS (15)
+
+/**************************************************************************
+
+  Name: agcControlLaw_updateFloat
+
+  Purpose: The purpose of this function is to run the gain filter with
+  floating point arithmetic.
+
+  Calling Sequence: filteredGainInDb =
+                      agcControlLaw_updateFloat(filteredGainInDb,
+                                                alpha,
+                                                gainError,
+                                                minAmplifierGainInDb,
+                                                maxAmplifierGainInDb)
+
+  Inputs:
+
+    filteredGainInDb - The filtered gain, g(n), in decibels.
+
+    alpha - The filter coefficient.
+
+    gainError - The gain error, e(n), in decibels.
+
+    minAmplifierGainInDb - The minimum amplifier gain in decibels.
+
+    maxAmplifierGainInDb - The maximum amplifier gain in decibels.
+
+  Outputs:
+
+    filteredGainInDb - The filtered gain, g(n+1), in decibels.
+
+**************************************************************************/
+static inline float agcControlLaw_updateFloat(float filteredGainInDb,
+    float alpha,
+    int32_t gainError,
+    int32_t minAmplifierGainInDb,
+    int32_t maxAmplifierGainInDb)
+{
+
+  //*******************************************************************
+  // Run the AGC algorithm.
+  //*******************************************************************
+  filteredGainInDb = filteredGainInDb + (alpha * (float)gainError);
+
+  //+++++++++++++++++++++++++++++++++++++++++++
+  // Limit the gain to valid values.
+  //+++++++++++++++++++++++++++++++++++++++++++
+  if (filteredGainInDb > maxAmplifierGainInDb)
+  {
+    filteredGainInDb = maxAmplifierGainInDb;
+  } // if
+  else
+  {
+    if (filteredGainInDb < minAmplifierGainInDb)
+    {
+      filteredGainInDb = minAmplifierGainInDb;
+    } // if
+  } // else
+  //*******************************************************************
+
+  return (filteredGainInDb);
+
+} // agcControlLaw_updateFloat
+
+/**************************************************************************
+
+  Name: agcControlLaw_updateFixed
+
+  Purpose: The purpose of this function is to run the gain filter with
+  fixed-point arithmetic.  The Q1.15 by integer product is shifted left
+  by one bit to bring it to Q16.16.
+
+  Calling Sequence: filteredGainQ16 =
+                      agcControlLaw_updateFixed(filteredGainQ16,
+                                                alphaQ15,
+                                                gainError,
+                                                minAmplifierGainInDb,
+                                                maxAmplifierGainInDb)
+
+  Inputs:
+
+    filteredGainQ16 - The filtered gain, g(n), in Q16.16 decibels.
+
+    alphaQ15 - The filter coefficient in Q1.15 format.
+
+    gainError - The gain error, e(n), in decibels.
+
+    minAmplifierGainInDb - The minimum amplifier gain in decibels.
+
+    maxAmplifierGainInDb - The maximum amplifier gain in decibels.
+
+  Outputs:
+
+    filteredGainQ16 - The filtered gain, g(n+1), in Q16.16 decibels.
+
+**************************************************************************/
+static inline int32_t agcControlLaw_updateFixed(int32_t filteredGainQ16,
+    int16_t alphaQ15,
+    int32_t gainError,
+    int32_t minAmplifierGainInDb,
+    int32_t maxAmplifierGainInDb)
+{
+  int32_t minGainQ16;
+  int32_t maxGainQ16;
+
+  minGainQ16 = minAmplifierGainInDb << AGC_GAIN_FRACTIONAL_BITS;
+  maxGainQ16 = maxAmplifierGainInDb << AGC_GAIN_FRACTIONAL_BITS;
+
+  //*******************************************************************
+  // Run the AGC algorithm.
+  //*******************************************************************
+  filteredGainQ16 = filteredGainQ16 + ((alphaQ15 * gainError) *
+    (1 << (AGC_GAIN_FRACTIONAL_BITS - AGC_ALPHA_FRACTIONAL_BITS)));
+
+  //+++++++++++++++++++++++++++++++++++++++++++
+  // Limit the gain to valid values.
+  //+++++++++++++++++++++++++++++++++++++++++++
+  if (filteredGainQ16 > maxGainQ16)
+  {
+    filteredGainQ16 = maxGainQ16;
+  } // if
+  else
+  {
+    if (filteredGainQ16 < minGainQ16)
+    {
+      filteredGainQ16 = minGainQ16;
+    } // if
+  } // else
+  //*******************************************************************
+
+  return (filteredGainQ16);
+
+} // agcControlLaw_updateFixed
+
+/**************************************************************************
+
+  Name: agcControlLaw_alphaToQ15
+
+  Purpose: The purpose of this function is to convert a filter
+  coefficient in the range of [0,1) to Q1.15 format, with rounding.
+
+  Calling Sequence: alphaQ15 = agcControlLaw_alphaToQ15(alpha)
+
+  Inputs:
+
+    alpha - The filter coefficient.
+
+  Outputs:
+
+    alphaQ15 - The filter coefficient in Q1.15 format.
+
+**************************************************************************/
+static inline int16_t agcControlLaw_alphaToQ15(float alpha)
+{
+
+  return ((int16_t)((alpha * (1 << AGC_ALPHA_FRACTIONAL_BITS)) + 0.5f));
+
+} // agcControlLaw_alphaToQ15
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// The AGC refers to the version selected at compile time through the
+// names below.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+#ifdef AGC_FIXED_POINT
+
+typedef int32_t agcFilteredGain;
+typedef int16_t agcCoefficient;
+
+#define agcControlLaw_update agcControlLaw_updateFixed
+#define agcControlLaw_gainFromDb(gainInDb) \
+  ((int32_t)(gainInDb) << AGC_GAIN_FRACTIONAL_BITS)
+#define agcControlLaw_gainToDb(filteredGain) \
+  ((uint32_t)((filteredGain) >> AGC_GAIN_FRACTIONAL_BITS))
+// The same conversion as agcControlLaw_alphaToQ15(), written as an
+// expression so that a constant coefficient can initialize static data.
+#define agcControlLaw_coefficientFromFloat(alpha) \
+  ((int16_t)(((float)(alpha) * (1 << AGC_ALPHA_FRACTIONAL_BITS)) + 0.5f))
+#define agcControlLaw_coefficientToFloat(alpha) \
+  ((float)(alpha) / (1 << AGC_ALPHA_FRACTIONAL_BITS))
+#define agcControlLaw_gainToQ16(filteredGain) (filteredGain)
+
+#else
+
+typedef float agcFilteredGain;
+typedef float agcCoefficient;
+
+#define agcControlLaw_update agcControlLaw_updateFloat
+#define agcControlLaw_gainFromDb(gainInDb) ((float)(gainInDb))
+#define agcControlLaw_gainToDb(filteredGain) ((uint32_t)(filteredGain))
+#define agcControlLaw_coefficientFromFloat(alpha) (alpha)
+#define agcControlLaw_coefficientToFloat(alpha) (alpha)
+#define agcControlLaw_gainToQ16(filteredGain) \
+  ((int32_t)((filteredGain) * (1 << AGC_GAIN_FRACTIONAL_BITS)))
+
+#endif // AGC_FIXED_POINT
+
+#endif // __AGCCONTROLLAW__
@@ -0,0 +1,71 @@
+//**************************************************************************
+// file name: agcInstrumentation.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements latency histograms that are used to measure the
+// time spent in the AGC and in the client callbacks.  Latencies are
+// recorded in nanoseconds into buckets whose width doubles, so that
+// bucket k holds latencies in [2^k,2^(k+1)) nanoseconds.  A histogram
+// has a single writer, and it may be read by any thread.
+//
+// The AGC only records latencies when it is built with
+// AGC_INSTRUMENTATION defined.  Otherwise, the AGC_LATENCY_START() and
+// AGC_LATENCY_STOP() macros expand to nothing.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __AGCINSTRUMENTATION__
+#define __AGCINSTRUMENTATION__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "AutomaticGainControl.h"
+
+struct agcLatencyHistogram
+{
+  uint64_t bucketCount[AGC_LATENCY_BUCKET_COUNT];
+  uint64_t sampleCount;
+  uint64_t maxLatencyInNs;
+
+  // Latencies above the budget are overruns.  Zero means no budget.
+  uint64_t budgetInNs;
+  uint64_t overrunCount;
+};
+
+void agcLatencyHistogram_init(struct agcLatencyHistogram *histogramPtr);
+
+void agcLatencyHistogram_record(struct agcLatencyHistogram *histogramPtr,
+    uint64_t latencyInNs);
+
+void agcLatencyHistogram_setBudget(struct agcLatencyHistogram *histogramPtr,
+    uint64_t budgetInNs);
+
+void agcLatencyHistogram_getReport(struct agcLatencyHistogram *histogramPtr,
+    struct agcLatencyReport *reportPtr);
+
+uint64_t agcInstrumentation_getTimeInNs(void);
+
+#ifdef AGC_INSTRUMENTATION
+
+#define AGC_LATENCY_START(startTime) \
+  uint64_t startTime = agcInstrumentation_getTimeInNs()
+
+#define AGC_LATENCY_STOP(histogramPtr,startTime) \
+  agcLatencyHistogram_record(histogramPtr, \
+    agcInstrumentation_getTimeInNs() - (startTime))
+
+#else
+
+#define AGC_LATENCY_START(startTime)
+#define AGC_LATENCY_STOP(histogramPtr,startTime)
+
+#endif // AGC_INSTRUMENTATION
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __AGCINSTRUMENTATION__
@@ -0,0 +1,113 @@
+//**************************************************************************
+// file name: agcReplay.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class replays a recording of raw IQ samples through an AGC.  The
+// recording was made with the amplifier at a fixed gain.  The replay
+// owns an AGC instance, and it connects the AGC's callbacks to a
+// simulated gain register, so the AGC believes that it is controlling
+// the receiver that made the recording.
+//
+// Each block of the recording is handed over in place; the replay only
+// reads it.  The average magnitude of the block is scaled by the
+// difference between the gain that the AGC has set and the gain of the
+// recording, it saturates at full scale, and it is presented to the
+// AGC.  The gain is modelled per block, so a change takes effect with
+// the next block, and clipping is only seen in the block average.
+//
+// While it runs, the replay measures how quickly the loop first brings
+// the signal within a tolerance of the operating point and holds it
+// there, and it counts the gain writes.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __AGCREPLAY__
+#define __AGCREPLAY__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+struct agcReplayConfig
+{
+  // The sample rate of the recording.
+  uint32_t sampleRate;
+
+  // The amplifier gain range is 0 to maxGainInDb, in 1dB steps.
+  uint32_t maxGainInDb;
+
+  // The gain that the recording was made with.
+  uint32_t recordedGainInDb;
+
+  // The gain that the AGC starts from.
+  uint32_t initialGainInDb;
+
+  // AGC parameters.
+  int32_t operatingPointInDbFs;
+  float filterCoefficient;
+  uint32_t deadbandInDb;
+  uint32_t blankingLimit;
+  int magnitudeEstimator;
+
+  // The loop is converged within operatingPointInDbFs +- toleranceInDb.
+  float toleranceInDb;
+  uint32_t holdTimeInUs;
+};
+
+// One point of the gain/RSSI timeline.
+struct agcReplayPoint
+{
+  // The time of the start of the block.
+  double timeInSeconds;
+
+  // The gain that was applied to the block.
+  uint32_t gainInDb;
+
+  // The signal level at the antenna, referenced to 0dB of gain.
+  float rssiInDbFs;
+
+  // The signal level at the ADC, after the applied gain.
+  float signalInDbFs;
+};
+
+struct agcReplayResults
+{
+  uint64_t sampleCount;
+  uint64_t blockCount;
+
+  // Gains that the AGC wrote to the simulated amplifier.
+  uint64_t hardwareWriteCount;
+
+  // Blocks whose average magnitude saturated the ADC.
+  uint64_t clippedBlockCount;
+
+  // Blocks within the tolerance of the operating point.
+  uint64_t inBandBlockCount;
+
+  // The time at which the loop first converged, or -1 if it never did.
+  double convergenceTimeInSeconds;
+
+  uint32_t finalGainInDb;
+};
+
+struct agcReplay;
+
+void agcReplay_getDefaultConfig(struct agcReplayConfig *configPtr);
+
+struct agcReplay *agcReplay_create(const struct agcReplayConfig *configPtr);
+void agcReplay_destroy(struct agcReplay *replayPtr);
+
+void agcReplay_acceptIqBlockU8(struct agcReplay *replayPtr,
+    const uint8_t *iqPtr,
+    uint32_t sampleCount,
+    struct agcReplayPoint *pointPtr);
+
+void agcReplay_getResults(struct agcReplay *replayPtr,
+    struct agcReplayResults *resultsPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __AGCREPLAY__
@@ -0,0 +1,174 @@
+//**************************************************************************
+// file name: agcSimulator.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements a closed-loop test bench for the AGC.  It models
+// the receiver that the AGC controls: a variable gain amplifier (VGA)
+// with integer decibel steps, an actuation delay and a settling
+// transient, followed by an ADC that quantizes the signal magnitude to
+// a given number of bits and saturates at full scale.  The signal at
+// the antenna is generated by a scenario.
+//
+// The simulator produces one signal magnitude per block.  The
+// application feeds it to the AGC, and it connects the AGC's set gain
+// and get gain callbacks to agcSimulator_setGain() and
+// agcSimulator_getGain().  Since nothing waits for real time, a
+// simulation runs thousands of times faster than real time.
+//
+// While it runs, the simulator measures how well the loop tracks the
+// operating point.  Every disturbance of the scenario (its start, a
+// level step, the start of a burst) is an event.  After an event, the
+// loop has converged once the amplified signal level has stayed within
+// a tolerance of the operating point for a hold time, and the overshoot
+// is the largest excursion past the operating point after the level
+// first reaches it.  Once converged, the loop is in its steady state
+// until the next event.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __AGCSIMULATOR__
+#define __AGCSIMULATOR__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// Scenario types.
+#define AGC_SCENARIO_STEP (0)
+#define AGC_SCENARIO_FADING (1)
+#define AGC_SCENARIO_BURSTY (2)
+#define AGC_SCENARIO_NOISE_ONLY (3)
+#define AGC_SCENARIO_RECORDED (4)
+
+struct agcSimulatorConfig
+{
+  // The ADC has this many magnitude bits.
+  uint32_t signalMagnitudeBitCount;
+
+  // The VGA gain range is 0 to maxGainInDb, in 1dB steps.
+  uint32_t maxGainInDb;
+  uint32_t initialGainInDb;
+
+  // The time that each magnitude represents.
+  uint32_t blockDurationInUs;
+
+  // The time from a gain request to the VGA starting to change.
+  uint32_t actuationDelayInUs;
+
+  // The time constant of the VGA settling to a new gain.
+  uint32_t settlingTimeInUs;
+
+  // A gain glitch in the first block after a gain change.
+  float transientInDb;
+
+  // The noise floor at the antenna, referenced to 0dB of gain.
+  float noiseFloorInDbFs;
+
+  // The standard deviation of the block to block magnitude fluctuation,
+  // relative to the magnitude.
+  float fluctuation;
+
+  // The loop is converged within operatingPointInDbFs +- toleranceInDb.
+  int32_t operatingPointInDbFs;
+  float toleranceInDb;
+  uint32_t holdTimeInUs;
+
+  // Seeds the random number generator.
+  uint32_t seed;
+};
+
+struct agcScenario
+{
+  // AGC_SCENARIO_XXX.
+  int type;
+
+  uint64_t durationInUs;
+
+  // The signal level at the antenna, referenced to 0dB of gain.
+  float levelInDbFs;
+
+  // Step: the level changes by stepInDb at stepTimeInUs.
+  float stepInDb;
+  uint64_t stepTimeInUs;
+
+  // Fading: the level swings by +- depthInDb/2 with this period.
+  float depthInDb;
+  uint64_t periodInUs;
+
+  // Bursty: the signal is on for burstOnInUs out of every periodInUs.
+  uint64_t burstOnInUs;
+
+  // Recorded: block i has the level recordedLevelsPtr[i], and a level
+  // change of at least eventThresholdInDb between blocks is an event.
+  // The levels belong to the caller.
+  const float *recordedLevelsPtr;
+  uint32_t recordedLevelCount;
+  float eventThresholdInDb;
+};
+
+struct agcSimulatorResults
+{
+  uint64_t simulatedTimeInUs;
+  uint64_t blockCount;
+
+  // Gain requests received through agcSimulator_setGain().
+  uint64_t hardwareWriteCount;
+
+  // Blocks that saturated the ADC.
+  uint64_t clippedBlockCount;
+
+  // Blocks within the tolerance of the operating point.
+  uint64_t inBandBlockCount;
+
+  // Events, and the events after which the loop converged.
+  uint32_t eventCount;
+  uint32_t convergedEventCount;
+
+  // Convergence times of the converged events.
+  double meanConvergenceTimeInUs;
+  double maxConvergenceTimeInUs;
+
+  // Like the convergence time, but averaged over all events, with an
+  // event that never converged counting for as long as it was tracked.
+  double meanResponseTimeInUs;
+
+  // The largest overshoot after any event, in decibels.
+  double maxOvershootInDb;
+
+  // The RMS deviation from the operating point once the loop has
+  // converged, while the signal is present.
+  double steadyStateErrorInDb;
+  uint64_t steadyStateBlockCount;
+};
+
+struct agcSimulator;
+
+void agcSimulator_getDefaultConfig(struct agcSimulatorConfig *configPtr);
+
+int agcSimulator_getScenario(const char *namePtr,
+    struct agcScenario *scenarioPtr);
+
+struct agcSimulator *agcSimulator_create(
+    const struct agcSimulatorConfig *configPtr,
+    const struct agcScenario *scenarioPtr);
+
+void agcSimulator_destroy(struct agcSimulator *simulatorPtr);
+
+int agcSimulator_step(struct agcSimulator *simulatorPtr,
+    uint32_t *signalMagnitudePtr,
+    uint64_t *timeInUsPtr);
+
+void agcSimulator_setGain(struct agcSimulator *simulatorPtr,
+    uint32_t gainInDb);
+
+uint32_t agcSimulator_getGain(struct agcSimulator *simulatorPtr);
+
+void agcSimulator_getResults(struct agcSimulator *simulatorPtr,
+    struct agcSimulatorResults *resultsPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __AGCSIMULATOR__
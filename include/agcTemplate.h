@@ -0,0 +1,1021 @@
+//**************************************************************************
+// file name: agcTemplate.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This file implements the AGC as a C++ class template for applications
+// that are written in C++.  It runs the same Harris equations as the C
+// AGC: the signal is converted to dBFS, the gain error is limited at the
+// gain rails and by the deadband, the gain is filtered by the control
+// law, and the hardware is given the new gain, after which the AGC is
+// blanked for blankingLimit invocations.
+//
+// The parts that the C AGC reaches through function pointers or selects
+// at run time are template parameters instead, so the compiler can
+// inline them into the hot path:
+//
+//   Detector - Turns the magnitudes into the magnitude that the
+//   algorithm acts upon.  AgcPassThroughDetector and AgcMeanDetector
+//   are provided.
+//
+//   ControlLaw - The gain filter.  AgcFloatControlLaw and
+//   AgcFixedControlLaw wrap the laws of agcControlLaw.h.
+//
+//   Actuator - Anything that can be invoked as actuator(gainInDb),
+//   normally a lambda or a functor, that sets the hardware gain.
+//
+//   SampleT - The type of the components of IQ blocks: uint8_t,
+//   int8_t or int16_t.
+//
+// An instance holds everything it needs, so it allocates nothing.  It
+// can be moved but not copied, since two copies would drive the same
+// amplifier.  The gain is owned by the instance: it does not poll the
+// hardware, and configuration changes are not synchronized with the
+// thread that runs the AGC, so an instance belongs to one thread.
+//
+// Use makeAgc() to have the actuator type deduced:
+//
+//   auto agc = makeAgc<AgcPassThroughDetector,AgcFloatControlLaw,int8_t>(
+//       -12,49,7,[&](uint32_t gainInDb) { tuner.setGain(gainInDb); });
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __AGCTEMPLATE__
+#define __AGCTEMPLATE__
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <utility>
+
+#include "dbfsCalculator.h"
+#include "magnitudeEstimator.h"
+#include "agcControlLaw.h"
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// Control laws.  Gain is the type of the filtered gain, and Coefficient
+// is the type of the filter coefficient.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+struct AgcFloatControlLaw
+{
+  typedef float Gain;
+  typedef float Coefficient;
+
+  static Gain update(Gain filteredGainInDb,
+      Coefficient alpha,
+      int32_t gainError,
+      int32_t minAmplifierGainInDb,
+      int32_t maxAmplifierGainInDb)
+  {
+    return (agcControlLaw_updateFloat(filteredGainInDb,
+                                      alpha,
+                                      gainError,
+                                      minAmplifierGainInDb,
+                                      maxAmplifierGainInDb));
+  }
+
+  static Gain gainFromDb(uint32_t gainInDb)
+  {
+    return ((float)gainInDb);
+  }
+
+  static uint32_t gainToDb(Gain filteredGainInDb)
+  {
+    return ((uint32_t)filteredGainInDb);
+  }
+
+  static Coefficient coefficientFromFloat(float alpha)
+  {
+    return (alpha);
+  }
+};
+
+struct AgcFixedControlLaw
+{
+  typedef int32_t Gain;
+  typedef int16_t Coefficient;
+
+  static Gain update(Gain filteredGainQ16,
+      Coefficient alphaQ15,
+      int32_t gainError,
+      int32_t minAmplifierGainInDb,
+      int32_t maxAmplifierGainInDb)
+  {
+    return (agcControlLaw_updateFixed(filteredGainQ16,
+                                      alphaQ15,
+                                      gainError,
+                                      minAmplifierGainInDb,
+                                      maxAmplifierGainInDb));
+  }
+
+  static Gain gainFromDb(uint32_t gainInDb)
+  {
+    return ((int32_t)gainInDb << AGC_GAIN_FRACTIONAL_BITS);
+  }
+
+  static uint32_t gainToDb(Gain filteredGainQ16)
+  {
+    return ((uint32_t)(filteredGainQ16 >> AGC_GAIN_FRACTIONAL_BITS));
+  }
+
+  static Coefficient coefficientFromFloat(float alpha)
+  {
+    return (agcControlLaw_alphaToQ15(alpha));
+  }
+};
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// Detectors.  A detector is reset whenever the gain changes, since the
+// magnitudes that it holds were measured with the old gain, and the
+// algorithm does not run until the detector is ready.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+// Acts upon each magnitude as it is presented, like AGC_DETECTOR_NONE.
+struct AgcPassThroughDetector
+{
+  uint32_t magnitude;
+
+  AgcPassThroughDetector() : magnitude(0)
+  {
+  }
+
+  void reset()
+  {
+  }
+
+  void accept(uint32_t signalMagnitude)
+  {
+    magnitude = signalMagnitude;
+  }
+
+  int isReady() const
+  {
+    return (1);
+  }
+
+  uint32_t getMagnitude() const
+  {
+    return (magnitude);
+  }
+};
+
+// The mean of the last WindowLength magnitudes, like AGC_DETECTOR_MEAN.
+template <uint32_t WindowLength>
+struct AgcMeanDetector
+{
+  static_assert(WindowLength != 0,"The window can't be empty.");
+
+  uint32_t window[WindowLength];
+  uint64_t sum;
+  uint32_t count;
+  uint32_t next;
+
+  AgcMeanDetector() : sum(0), count(0), next(0)
+  {
+  }
+
+  void reset()
+  {
+    sum = 0;
+    count = 0;
+    next = 0;
+  }
+
+  void accept(uint32_t signalMagnitude)
+  {
+    if (count == WindowLength)
+    {
+      // The oldest magnitude leaves the window.
+      sum -= window[next];
+    } // if
+    else
+    {
+      count++;
+    } // else
+
+    window[next] = signalMagnitude;
+    sum += signalMagnitude;
+
+    next++;
+
+    if (next == WindowLength)
+    {
+      next = 0;
+    } // if
+  }
+
+  int isReady() const
+  {
+    return (count == WindowLength);
+  }
+
+  uint32_t getMagnitude() const
+  {
+    return ((uint32_t)(sum / WindowLength));
+  }
+};
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// Maps a sample type to the magnitude estimator for its IQ blocks.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+template <typename SampleT>
+struct AgcSampleFormat;
+
+template <>
+struct AgcSampleFormat<uint8_t>
+{
+  static uint32_t averageMagnitude(const uint8_t *iqPtr,
+      uint32_t sampleCount)
+  {
+    return (magnitude_averageU8(iqPtr,
+                                sampleCount,
+                                MAGNITUDE_ALPHA_MAX_BETA_MIN));
+  }
+};
+
+template <>
+struct AgcSampleFormat<int8_t>
+{
+  static uint32_t averageMagnitude(const int8_t *iqPtr,
+      uint32_t sampleCount)
+  {
+    return (magnitude_averageS8(iqPtr,
+                                sampleCount,
+                                MAGNITUDE_ALPHA_MAX_BETA_MIN));
+  }
+};
+
+template <>
+struct AgcSampleFormat<int16_t>
+{
+  static uint32_t averageMagnitude(const int16_t *iqPtr,
+      uint32_t sampleCount)
+  {
+    return (magnitude_averageS16(iqPtr,
+                                 sampleCount,
+                                 MAGNITUDE_ALPHA_MAX_BETA_MIN));
+  }
+};
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// The event counters of an instance, with the meanings of the fields of
+// the same names in struct agcStats.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+struct AgcCounters
+{
+  uint64_t invocationCount;
+  uint64_t blankedCount;
+  uint64_t deadbandSuppressionCount;
+  uint64_t minGainClampCount;
+  uint64_t maxGainClampCount;
+  uint64_t gainWriteCount;
+};
+
+template <typename Detector,
+          typename ControlLaw,
+          typename Actuator,
+          typename SampleT>
+class Agc
+{
+  public:
+
+  Agc(int32_t operatingPointInDbFs,
+      uint32_t maxAmplifierGainInDb,
+      uint32_t signalMagnitudeBitCount,
+      Actuator actuator,
+      Detector detector = Detector());
+
+  // There is one amplifier, so there can't be two instances.
+  Agc(const Agc &) = delete;
+  Agc &operator=(const Agc &) = delete;
+
+  Agc(Agc &&) = default;
+  Agc &operator=(Agc &&) = default;
+
+  int isInitialized() const;
+
+  void setOperatingPoint(int32_t operatingPointInDbFs);
+  int setAgcFilterCoefficient(float coefficient);
+  int setDeadband(uint32_t deadbandInDb);
+  int setBlankingLimit(uint32_t blankingLimit);
+
+  void enable();
+  void disable();
+  int isEnabled() const;
+
+  void acceptData(uint32_t signalMagnitude);
+  void acceptIqBlock(const SampleT *iqPtr,uint32_t sampleCount);
+
+  uint32_t getGainInDb() const;
+  const AgcCounters &getCounters() const;
+
+  private:
+
+  void run(uint32_t signalMagnitude);
+  void runHarris(uint32_t signalMagnitude);
+
+  int initialized;
+  int enabled;
+
+  // Configuration.
+  int32_t operatingPointInDbFs;
+  int32_t deadbandInDb;
+  uint32_t blankingLimit;
+  typename ControlLaw::Coefficient alpha;
+  int32_t maxAmplifierGainInDb;
+
+  // Loop state.
+  uint32_t blankingCounter;
+  int gainWasAdjusted;
+  uint32_t gainInDb;
+  typename ControlLaw::Gain filteredGainInDb;
+
+  AgcCounters counters;
+
+  struct dbfsCalculator dbfs;
+
+  Detector detector;
+  Actuator actuator;
+};
+
+/**************************************************************************
+
+  Name: Agc
+
+  Purpose: The purpose of this function is to construct an AGC
+  instance.  The defaults are those of agcInstance_init(): the gain
+  starts at 24dB, the filter coefficient is 0.8, the deadband is 1dB,
+  the blanking limit is 1, and the AGC is disabled.  The hardware is
+  not given the initial gain.
+
+  Calling Sequence: Agc<Detector,ControlLaw,Actuator,SampleT>
+                      agc(operatingPointInDbFs,
+                          maxAmplifierGainInDb,
+                          signalMagnitudeBitCount,
+                          actuator,
+                          detector)
+
+  Inputs:
+
+    operatingPointInDbFs - The AGC operating point in decibels referenced
+    to full scale.
+
+    maxAmplifierGainInDb - The maximum gain of the amplifier in decibels.
+
+    signalMagnitudeBitCount - The number of magnitude bits in a signal.
+    isInitialized() returns 0 if this is out of range.
+
+    actuator - The actuator, which is invoked with the gain in decibels
+    whenever the gain changes.
+
+    detector - The detector.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+template <typename Detector,
+          typename ControlLaw,
+          typename Actuator,
+          typename SampleT>
+Agc<Detector,ControlLaw,Actuator,SampleT>::Agc(
+    int32_t operatingPointInDbFs,
+    uint32_t maxAmplifierGainInDb,
+    uint32_t signalMagnitudeBitCount,
+    Actuator actuator,
+    Detector detector)
+  : enabled(0),
+    operatingPointInDbFs(operatingPointInDbFs),
+    deadbandInDb(1),
+    blankingLimit(1),
+    alpha(ControlLaw::coefficientFromFloat(0.8f)),
+    maxAmplifierGainInDb((int32_t)maxAmplifierGainInDb),
+    blankingCounter(0),
+    gainWasAdjusted(0),
+    gainInDb(24),
+    filteredGainInDb(ControlLaw::gainFromDb(24)),
+    counters(),
+    detector(std::move(detector)),
+    actuator(std::move(actuator))
+{
+
+  initialized = dbfsCalculator_init(&dbfs,signalMagnitudeBitCount);
+
+} // Agc
+
+/**************************************************************************
+
+  Name: isInitialized
+
+  Purpose: The purpose of this function is to tell whether or not the
+  instance was constructed with valid parameters.  An instance that was
+  not does nothing.
+
+  Calling Sequence: initialized = agc.isInitialized()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    initialized - A flag that indicates whether or not the instance is
+    initialized.
+
+**************************************************************************/
+template <typename Detector,
+          typename ControlLaw,
+          typename Actuator,
+          typename SampleT>
+int Agc<Detector,ControlLaw,Actuator,SampleT>::isInitialized() const
+{
+
+  return (initialized);
+
+} // isInitialized
+
+/**************************************************************************
+
+  Name: setOperatingPoint
+
+  Purpose: The purpose of this function is to set the operating point
+  of the AGC.
+
+  Calling Sequence: agc.setOperatingPoint(operatingPointInDbFs)
+
+  Inputs:
+
+    operatingPointInDbFs - The operating point in decibels referenced to
+    full scale.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+template <typename Detector,
+          typename ControlLaw,
+          typename Actuator,
+          typename SampleT>
+void Agc<Detector,ControlLaw,Actuator,SampleT>::setOperatingPoint(
+    int32_t operatingPointInDbFs)
+{
+
+  this->operatingPointInDbFs = operatingPointInDbFs;
+
+  return;
+
+} // setOperatingPoint
+
+/**************************************************************************
+
+  Name: setAgcFilterCoefficient
+
+  Purpose: The purpose of this function is to set the coefficient of
+  the gain filter.  The range is that of
+  agcInstance_setAgcFilterCoefficient().
+
+  Calling Sequence: success = agc.setAgcFilterCoefficient(coefficient)
+
+  Inputs:
+
+    coefficient - The filter coefficient, 0.001 <= coefficient < 0.999.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the coefficient was
+    updated.
+
+**************************************************************************/
+template <typename Detector,
+          typename ControlLaw,
+          typename Actuator,
+          typename SampleT>
+int Agc<Detector,ControlLaw,Actuator,SampleT>::setAgcFilterCoefficient(
+    float coefficient)
+{
+  int success;
+
+  success = (coefficient >= 0.001f) && (coefficient < 0.999f);
+
+  if (success)
+  {
+    alpha = ControlLaw::coefficientFromFloat(coefficient);
+  } // if
+
+  return (success);
+
+} // setAgcFilterCoefficient
+
+/**************************************************************************
+
+  Name: setDeadband
+
+  Purpose: The purpose of this function is to set the deadband of the
+  AGC.
+
+  Calling Sequence: success = agc.setDeadband(deadbandInDb)
+
+  Inputs:
+
+    deadbandInDb - The deadband in decibels, from 0 to 10.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the deadband was
+    updated.
+
+**************************************************************************/
+template <typename Detector,
+          typename ControlLaw,
+          typename Actuator,
+          typename SampleT>
+int Agc<Detector,ControlLaw,Actuator,SampleT>::setDeadband(
+    uint32_t deadbandInDb)
+{
+  int success;
+
+  success = (deadbandInDb <= 10);
+
+  if (success)
+  {
+    this->deadbandInDb = (int32_t)deadbandInDb;
+  } // if
+
+  return (success);
+
+} // setDeadband
+
+/**************************************************************************
+
+  Name: setBlankingLimit
+
+  Purpose: The purpose of this function is to set the number of
+  invocations that are ignored after a gain adjustment.  The blanking
+  system is reset.
+
+  Calling Sequence: success = agc.setBlankingLimit(blankingLimit)
+
+  Inputs:
+
+    blankingLimit - The number of invocations, from 0 to 10.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the limit was
+    updated.
+
+**************************************************************************/
+template <typename Detector,
+          typename ControlLaw,
+          typename Actuator,
+          typename SampleT>
+int Agc<Detector,ControlLaw,Actuator,SampleT>::setBlankingLimit(
+    uint32_t blankingLimit)
+{
+  int success;
+
+  success = (blankingLimit <= 10);
+
+  if (success)
+  {
+    this->blankingLimit = blankingLimit;
+
+    blankingCounter = 0;
+    gainWasAdjusted = 0;
+  } // if
+
+  return (success);
+
+} // setBlankingLimit
+
+/**************************************************************************
+
+  Name: enable
+
+  Purpose: The purpose of this function is to enable the AGC.
+
+  Calling Sequence: agc.enable()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+template <typename Detector,
+          typename ControlLaw,
+          typename Actuator,
+          typename SampleT>
+void Agc<Detector,ControlLaw,Actuator,SampleT>::enable()
+{
+
+  enabled = 1;
+
+  return;
+
+} // enable
+
+/**************************************************************************
+
+  Name: disable
+
+  Purpose: The purpose of this function is to disable the AGC.
+
+  Calling Sequence: agc.disable()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+template <typename Detector,
+          typename ControlLaw,
+          typename Actuator,
+          typename SampleT>
+void Agc<Detector,ControlLaw,Actuator,SampleT>::disable()
+{
+
+  enabled = 0;
+
+  return;
+
+} // disable
+
+/**************************************************************************
+
+  Name: isEnabled
+
+  Purpose: The purpose of this function is to tell whether or not the
+  AGC is enabled.
+
+  Calling Sequence: enabled = agc.isEnabled()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    enabled - A flag that indicates whether or not the AGC is enabled.
+
+**************************************************************************/
+template <typename Detector,
+          typename ControlLaw,
+          typename Actuator,
+          typename SampleT>
+int Agc<Detector,ControlLaw,Actuator,SampleT>::isEnabled() const
+{
+
+  return (enabled);
+
+} // isEnabled
+
+/**************************************************************************
+
+  Name: acceptData
+
+  Purpose: The purpose of this function is to run the AGC with a
+  signal magnitude.
+
+  Calling Sequence: agc.acceptData(signalMagnitude)
+
+  Inputs:
+
+    signalMagnitude - The magnitude of the signal.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+template <typename Detector,
+          typename ControlLaw,
+          typename Actuator,
+          typename SampleT>
+void Agc<Detector,ControlLaw,Actuator,SampleT>::acceptData(
+    uint32_t signalMagnitude)
+{
+
+  if ((initialized) && (enabled))
+  {
+    run(signalMagnitude);
+  } // if
+
+  return;
+
+} // acceptData
+
+/**************************************************************************
+
+  Name: acceptIqBlock
+
+  Purpose: The purpose of this function is to run the AGC with a block
+  of interleaved IQ samples.  The AGC acts upon the average magnitude
+  of the block, which is computed by the vector kernels of the
+  magnitude estimator.
+
+  Calling Sequence: agc.acceptIqBlock(iqPtr,sampleCount)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+template <typename Detector,
+          typename ControlLaw,
+          typename Actuator,
+          typename SampleT>
+void Agc<Detector,ControlLaw,Actuator,SampleT>::acceptIqBlock(
+    const SampleT *iqPtr,
+    uint32_t sampleCount)
+{
+
+  if ((initialized) && (enabled))
+  {
+    run(AgcSampleFormat<SampleT>::averageMagnitude(iqPtr,sampleCount));
+  } // if
+
+  return;
+
+} // acceptIqBlock
+
+/**************************************************************************
+
+  Name: getGainInDb
+
+  Purpose: The purpose of this function is to retrieve the gain that
+  the AGC last gave the hardware.
+
+  Calling Sequence: gainInDb = agc.getGainInDb()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    gainInDb - The gain in decibels.
+
+**************************************************************************/
+template <typename Detector,
+          typename ControlLaw,
+          typename Actuator,
+          typename SampleT>
+uint32_t Agc<Detector,ControlLaw,Actuator,SampleT>::getGainInDb() const
+{
+
+  return (gainInDb);
+
+} // getGainInDb
+
+/**************************************************************************
+
+  Name: getCounters
+
+  Purpose: The purpose of this function is to retrieve the event
+  counters of the instance.
+
+  Calling Sequence: countersRef = agc.getCounters()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    countersRef - A reference to the counters.
+
+**************************************************************************/
+template <typename Detector,
+          typename ControlLaw,
+          typename Actuator,
+          typename SampleT>
+const AgcCounters &Agc<Detector,ControlLaw,Actuator,SampleT>::getCounters()
+  const
+{
+
+  return (counters);
+
+} // getCounters
+
+/**************************************************************************
+
+  Name: run
+
+  Purpose: The purpose of this function is to run the blanking system
+  and the detector, and to run the AGC algorithm when they allow it.
+
+  Calling Sequence: run(signalMagnitude)
+
+  Inputs:
+
+    signalMagnitude - The magnitude of the signal.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+template <typename Detector,
+          typename ControlLaw,
+          typename Actuator,
+          typename SampleT>
+void Agc<Detector,ControlLaw,Actuator,SampleT>::run(uint32_t signalMagnitude)
+{
+  int allowedToRun;
+
+  counters.invocationCount++;
+
+  // Let the AGC run if no gain adjustment was made.
+  allowedToRun = 1;
+
+  if (gainWasAdjusted)
+  {
+    if (blankingCounter < blankingLimit)
+    {
+      // The system is still blanked.
+      blankingCounter++;
+
+      allowedToRun = 0;
+    } // if
+    else
+    {
+      // We're done blanking.
+      blankingCounter = 0;
+      gainWasAdjusted = 0;
+    } // else
+  } // if
+
+  if (allowedToRun)
+  {
+    detector.accept(signalMagnitude);
+
+    allowedToRun = detector.isReady();
+  } // if
+
+  if (allowedToRun)
+  {
+    runHarris(detector.getMagnitude());
+  } // if
+  else
+  {
+    counters.blankedCount++;
+  } // else
+
+  return;
+
+} // run
+
+/**************************************************************************
+
+  Name: runHarris
+
+  Purpose: The purpose of this function is to run the AGC algorithm, as
+  runHarris() of the C AGC does.
+
+  Calling Sequence: runHarris(signalMagnitude)
+
+  Inputs:
+
+    signalMagnitude - The magnitude of the signal.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+template <typename Detector,
+          typename ControlLaw,
+          typename Actuator,
+          typename SampleT>
+void Agc<Detector,ControlLaw,Actuator,SampleT>::runHarris(
+    uint32_t signalMagnitude)
+{
+  int32_t signalInDbFs;
+  int32_t gainError;
+
+  // Convert to decibels referenced to full scale.
+  signalInDbFs = dbfsCalculator_convertMagnitudeToDbFs(&dbfs,signalMagnitude);
+
+  // Compute the gain adjustment.
+  gainError = operatingPointInDbFs - signalInDbFs;
+
+  // Don't push the gain past the rails.
+  if (gainInDb == (uint32_t)maxAmplifierGainInDb)
+  {
+    if (gainError > 0)
+    {
+      gainError = 0;
+      counters.maxGainClampCount++;
+    } // if
+  } // if
+  else
+  {
+    if (gainInDb == 0)
+    {
+      if (gainError < 0)
+      {
+        gainError = 0;
+        counters.minGainClampCount++;
+      } // if
+    } // if
+  } // else
+
+  // Apply deadband to eliminate gain oscillations.
+  if (abs(gainError) <= deadbandInDb)
+  {
+    if (gainError != 0)
+    {
+      counters.deadbandSuppressionCount++;
+    } // if
+
+    gainError = 0;
+  } // if
+
+  // Run the AGC algorithm, and limit the gain to valid values.
+  filteredGainInDb = ControlLaw::update(filteredGainInDb,
+                                        alpha,
+                                        gainError,
+                                        0,
+                                        maxAmplifierGainInDb);
+
+  gainInDb = ControlLaw::gainToDb(filteredGainInDb);
+
+  // There is no need to update the gain if no change has occurred.
+  if (gainError != 0)
+  {
+    counters.gainWriteCount++;
+
+    actuator(gainInDb);
+
+    gainWasAdjusted = 1;
+
+    // The detector's window was measured with the old gain.
+    detector.reset();
+  } // if
+
+  return;
+
+} // runHarris
+
+/**************************************************************************
+
+  Name: makeAgc
+
+  Purpose: The purpose of this function is to construct an AGC instance
+  with the type of the actuator deduced, so that the actuator can be a
+  lambda.
+
+  Calling Sequence: agc = makeAgc<Detector,ControlLaw,SampleT>(
+                            operatingPointInDbFs,
+                            maxAmplifierGainInDb,
+                            signalMagnitudeBitCount,
+                            actuator)
+
+  Inputs:
+
+    operatingPointInDbFs - The AGC operating point in decibels referenced
+    to full scale.
+
+    maxAmplifierGainInDb - The maximum gain of the amplifier in decibels.
+
+    signalMagnitudeBitCount - The number of magnitude bits in a signal.
+
+    actuator - The actuator.
+
+  Outputs:
+
+    agc - The AGC instance.
+
+**************************************************************************/
+template <typename Detector,
+          typename ControlLaw,
+          typename SampleT,
+          typename Actuator>
+Agc<Detector,ControlLaw,Actuator,SampleT> makeAgc(
+    int32_t operatingPointInDbFs,
+    uint32_t maxAmplifierGainInDb,
+    uint32_t signalMagnitudeBitCount,
+    Actuator actuator)
+{
+
+  return (Agc<Detector,ControlLaw,Actuator,SampleT>(operatingPointInDbFs,
+                                                    maxAmplifierGainInDb,
+                                                    signalMagnitudeBitCount,
+                                                    std::move(actuator)));
+
+} // makeAgc
+
+#endif // __AGCTEMPLATE__
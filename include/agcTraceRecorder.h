@@ -0,0 +1,99 @@
+//**************************************************************************
+// file name: agcTraceRecorder.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements a recorder of the trajectory of an AGC loop.
+// The AGC writes one record per invocation into a single-producer,
+// single-consumer ring buffer, without locks or allocation.  A writer
+// thread drains the ring buffer into a binary file.  If the ring buffer
+// is full, the record is dropped and counted, so the AGC never waits
+// for the writer.
+//
+// The file starts with a header, followed by the records in the
+// native byte order of the machine that wrote them.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __AGCTRACERECORDER__
+#define __AGCTRACERECORDER__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// Identifies a trace file.
+#define AGC_TRACE_MAGIC "AGCTRACE"
+#define AGC_TRACE_VERSION (1)
+
+// Record flags.
+#define AGC_TRACE_BLANKED (0x01)
+#define AGC_TRACE_HARDWARE_WRITE (0x02)
+#define AGC_TRACE_DEADBAND (0x04)
+#define AGC_TRACE_MIN_GAIN_CLAMP (0x08)
+#define AGC_TRACE_MAX_GAIN_CLAMP (0x10)
+#define AGC_TRACE_OVERLOAD (0x20)
+
+struct agcTraceFileHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t recordSize;
+};
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// One invocation of the AGC.  The levels are those of the paper by
+// Harris et. al: x(n) is the signal level before amplification, y(n)
+// is the amplified signal level, e(n) = R - y(n) is the gain error
+// before the gain rails and the deadband are applied, and g(n) is the
+// filtered gain.  The levels are only updated by invocations that were
+// not blanked.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+struct agcTraceRecord
+{
+  // The time of the invocation, in ticks of the AGC clock.
+  uint64_t time;
+
+  // g(n+1), in Q16.16 decibels.
+  int32_t filteredGainQ16;
+
+  // x(n) and y(n), in dBFs.
+  int16_t normalizedSignalLevelInDbFs;
+  int16_t signalInDbFs;
+
+  // e(n), in decibels.
+  int16_t gainError;
+
+  uint16_t blankingCounter;
+
+  // The gain after the invocation, in decibels.
+  uint8_t gainInDb;
+
+  // AGC_TRACE_XXX flags.
+  uint8_t flags;
+
+  uint16_t reserved;
+};
+
+struct agcTraceRecorder;
+
+struct agcTraceRecorder *agcTraceRecorder_create(uint32_t capacity);
+void agcTraceRecorder_destroy(struct agcTraceRecorder *recorderPtr);
+
+int agcTraceRecorder_start(struct agcTraceRecorder *recorderPtr,
+    const char *fileNamePtr);
+int agcTraceRecorder_stop(struct agcTraceRecorder *recorderPtr);
+
+void agcTraceRecorder_record(struct agcTraceRecorder *recorderPtr,
+    const struct agcTraceRecord *recordPtr);
+
+uint64_t agcTraceRecorder_getRecordedCount(
+    struct agcTraceRecorder *recorderPtr);
+uint64_t agcTraceRecorder_getDroppedCount(
+    struct agcTraceRecorder *recorderPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __AGCTRACERECORDER__
@@ -1,25 +1,66 @@
-//**************************************************************************
-// file name: dbfsCalculator.h
-//**************************************************************************
-//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-// This class implements a signal processing block that computes decibles
-// below a full scale value of a finite word length quantity.
-//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-
-#ifndef __DBFSCALCULATOR__
-#define __DBFSCALCULATOR__
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-#include <stdint.h>
-
-int dbfs_init(uint32_t wordLengthInBits);
-int32_t dbfs_convertMagnitudeToDbFs(uint32_t signalMagnitude);
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif // __DBFSCALCULATOR__
+//**************************************************************************
+// file name: dbfsCalculator.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements a signal processing block that computes decibles
+// below a full scale value of a finite word length quantity.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __DBFSCALCULATOR__
+#define __DBFSCALCULATOR__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// Fractional decibel values have 8 fractional bits (Q8).
+#define DBFS_FRACTIONAL_BITS (8)
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// An instance of a calculator.  The full scale constants are held by
+// the instance, and the decibel table is shared by all instances.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+struct dbfsCalculator
+{
+  // The shared decibel table of normalized magnitudes.
+  const int16_t *dbTablePtr;
+
+  // The full scale value is 2^(number of bits) - 1.
+  uint32_t fullScaleValue;
+
+  // The full scale value in Q8 decibels.
+  int32_t fullScaleValueInDbQ8;
+};
+
+int dbfsCalculator_init(struct dbfsCalculator *calculatorPtr,
+    uint32_t wordLengthInBits);
+
+int32_t dbfsCalculator_convertMagnitudeToDbFs(
+    const struct dbfsCalculator *calculatorPtr,
+    uint32_t signalMagnitude);
+
+int32_t dbfsCalculator_convertMagnitudeToDbFsQ8(
+    const struct dbfsCalculator *calculatorPtr,
+    uint32_t signalMagnitude);
+
+void dbfsCalculator_convertBlock(
+    const struct dbfsCalculator *calculatorPtr,
+    const uint32_t *signalMagnitudePtr,
+    int32_t *dbFsQ8Ptr,
+    uint32_t count);
+
+// These functions operate on a default calculator.
+int dbfs_init(uint32_t wordLengthInBits);
+int32_t dbfs_convertMagnitudeToDbFs(uint32_t signalMagnitude);
+int32_t dbfs_convertMagnitudeToDbFsQ8(uint32_t signalMagnitude);
+void dbfs_convertBlock(const uint32_t *signalMagnitudePtr,
+    int32_t *dbFsQ8Ptr,
+    uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __DBFSCALCULATOR__
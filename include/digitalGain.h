@@ -0,0 +1,42 @@
+//**************************************************************************
+// file name: digitalGain.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements a signal processing block that multiplies a
+// block of interleaved IQ samples by a gain, in place.  The gain ramps
+// linearly from a start gain to an end gain across the block, so that
+// a gain change does not produce a step (a click) in the output.  Both
+// components of a sample get the same gain, and the last sample of the
+// block gets the end gain.  Integer samples are rounded to the nearest
+// value and saturated.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __DIGITALGAIN__
+#define __DIGITALGAIN__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+void digitalGain_applyS8(int8_t *iqPtr,
+    uint32_t sampleCount,
+    float startGain,
+    float endGain);
+
+void digitalGain_applyS16(int16_t *iqPtr,
+    uint32_t sampleCount,
+    float startGain,
+    float endGain);
+
+void digitalGain_applyF32(float *iqPtr,
+    uint32_t sampleCount,
+    float startGain,
+    float endGain);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __DIGITALGAIN__
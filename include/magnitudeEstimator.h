@@ -0,0 +1,52 @@
+//**************************************************************************
+// file name: magnitudeEstimator.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements a signal processing block that computes the
+// average magnitude of a block of interleaved IQ samples.  The samples
+// are presented in the formats produced by common receivers.  It also
+// counts the samples of a block that reached the clip level of the ADC.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __MAGNITUDEESTIMATOR__
+#define __MAGNITUDEESTIMATOR__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// Magnitude estimation methods.
+#define MAGNITUDE_ALPHA_MAX_BETA_MIN (0)
+#define MAGNITUDE_EXACT (1)
+
+uint32_t magnitude_averageU8(const uint8_t *iqPtr,
+    uint32_t sampleCount,
+    int method);
+
+uint32_t magnitude_averageS8(const int8_t *iqPtr,
+    uint32_t sampleCount,
+    int method);
+
+uint32_t magnitude_averageS16(const int16_t *iqPtr,
+    uint32_t sampleCount,
+    int method);
+
+uint32_t magnitude_countClippedU8(const uint8_t *iqPtr,
+    uint32_t sampleCount,
+    uint32_t clipLevel);
+
+uint32_t magnitude_countClippedS8(const int8_t *iqPtr,
+    uint32_t sampleCount,
+    uint32_t clipLevel);
+
+uint32_t magnitude_countClippedS16(const int16_t *iqPtr,
+    uint32_t sampleCount,
+    uint32_t clipLevel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MAGNITUDEESTIMATOR__
@@ -0,0 +1,114 @@
+//**************************************************************************
+// file name: signalDetector.h
+//**************************************************************************
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// This class implements the signal detector that sits in front of the
+// AGC algorithm.  It turns the magnitudes that are presented to the AGC
+// into the one magnitude that the algorithm acts upon.  The detector
+// keeps a sliding window of the most recent magnitudes, and measures
+// either their mean, their RMS value, their average in decibels, or
+// their peak.  The peak is kept with a monotonic deque, a queue of the
+// window's magnitudes in decreasing order from which every magnitude
+// that can never be the peak again has been removed, so each magnitude
+// costs O(1) amortized.
+//
+// The measurement is handed to the algorithm in decibels referenced to
+// full scale.  The average in decibels is already in that form, so it
+// is never converted back to a magnitude.
+//
+// The measurement can be smoothed with separate attack and decay
+// coefficients, which are applied once per measurement.  A coefficient
+// of 1 follows the measurement immediately.
+//
+// All storage is part of the detector, so nothing is allocated when
+// the detector is configured or fed.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+#ifndef __SIGNALDETECTOR__
+#define __SIGNALDETECTOR__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "dbfsCalculator.h"
+
+// Detection methods.
+#define DETECTOR_NONE (0)
+#define DETECTOR_MEAN (1)
+#define DETECTOR_RMS (2)
+#define DETECTOR_LOG_AVERAGE (3)
+#define DETECTOR_PEAK (4)
+
+// The longest window, in magnitudes.
+#define DETECTOR_MAX_WINDOW_LENGTH (1024)
+
+// Smoothing coefficients are Q1.15, so this value is 1.
+#define DETECTOR_COEFFICIENT_ONE (1 << 15)
+
+struct signalDetector
+{
+  int mode;
+  uint32_t windowLength;
+  uint32_t attackQ15;
+  uint32_t decayQ15;
+
+  // Converts magnitudes to decibels for the log average.
+  const struct dbfsCalculator *dbfsPtr;
+
+  //*******************************************************************
+  // Mean, RMS and log average: the window holds the magnitudes, their
+  // squares, or their Q8 decibel values, and their running sum.
+  //*******************************************************************
+  int64_t window[DETECTOR_MAX_WINDOW_LENGTH];
+  int64_t sum;
+  uint32_t count;
+  uint32_t next;
+
+  //*******************************************************************
+  // Peak: a circular deque of magnitudes in decreasing order, with the
+  // number of the input that each one was.
+  //*******************************************************************
+  uint32_t dequeMagnitude[DETECTOR_MAX_WINDOW_LENGTH];
+  uint32_t dequeInput[DETECTOR_MAX_WINDOW_LENGTH];
+  uint32_t dequeHead;
+  uint32_t dequeCount;
+  uint32_t inputCount;
+
+  // The smoothed measurement in Q8, and whether it has a value yet.
+  int64_t smoothedQ8;
+  int primed;
+
+  // The sum and the number of the magnitudes of the last block, which
+  // give the magnitude that the log average reports for display.
+  uint64_t blockSum;
+  uint32_t blockCount;
+};
+
+void signalDetector_init(struct signalDetector *detectorPtr,
+    const struct dbfsCalculator *dbfsPtr);
+
+void signalDetector_configure(struct signalDetector *detectorPtr,
+    int mode,
+    uint32_t windowLength,
+    uint32_t attackQ15,
+    uint32_t decayQ15);
+
+void signalDetector_reset(struct signalDetector *detectorPtr);
+
+void signalDetector_accept(struct signalDetector *detectorPtr,
+    const uint32_t *signalMagnitudePtr,
+    uint32_t count);
+
+int signalDetector_isReady(const struct signalDetector *detectorPtr);
+
+int32_t signalDetector_measure(struct signalDetector *detectorPtr,
+    uint32_t *signalMagnitudePtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SIGNALDETECTOR__
@@ -3,670 +3,4922 @@
 //**********************************************************************
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <math.h>
-#include <sys/time.h>
+#include <pthread.h>
+#include <semaphore.h>
 
 #include "AutomaticGainControl.h"
 #include "dbfsCalculator.h"
+#include "magnitudeEstimator.h"
+#include "agcControlLaw.h"
+#include "agcInstrumentation.h"
+#include "agcTraceRecorder.h"
+#include "signalDetector.h"
+#include "digitalGain.h"
+
+// Instances are aligned so that no two of them share a cache line.
+#define AGC_CACHE_LINE_SIZE (64)
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// The parameters that the application may change while the AGC is
+// running are bundled in one structure.  The control thread updates
+// the published copy of the structure, and the sample thread works
+// from a private copy that is refreshed when a new version is
+// published.  The blankingResetCount field is incremented whenever the
+// control thread wants the blanking system to be reset, so that the
+// reset is performed by the sample thread that owns the blanking state.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+struct agcConfiguration
+{
+  // If 1, the AGC is running.
+  int enabled;
+
+  // The setpoint.
+  int32_t operatingPointInDbFs;
+
+  // Yes, we need some deadband.
+  int32_t deadbandInDb;
+
+  // Selects whether blanking counts invocations or time.
+  int blankingMode;
+
+  // The number of invocations to ignore after a gain adjustment.
+  uint32_t blankingLimit;
+
+  // The time, in ticks, to ignore after a gain adjustment.
+  uint64_t blankingDuration;
+
+  // AGC lowpass filter coefficient for baseband gain filtering.  This
+  // is Q1.15 in the fixed-point build.
+  agcCoefficient alpha;
+
+  // The method used to compute the magnitude of IQ blocks.
+  int magnitudeEstimator;
+
+  // Incremented to request a reset of the blanking system.
+  uint32_t blankingResetCount;
+
+  // If 1, gains are written to the hardware by the actuator thread.
+  int gainActuatorEnabled;
+
+  // Selects how gain changes made by others are discovered.
+  int gainSyncMode;
+
+  // If not NULL, each invocation is recorded here.
+  struct agcTraceRecorder *traceRecorderPtr;
+
+  // The signal detector in front of the AGC algorithm.  The attack and
+  // decay coefficients are Q1.15.
+  int detectorMode;
+  uint32_t detectorWindowLength;
+  uint32_t detectorAttackQ15;
+  uint32_t detectorDecayQ15;
+
+  // An IQ block with at least overloadLimit clipped samples overloads
+  // the ADC, and it cuts the gain by overloadGainCutInDb at once.  A
+  // limit of 0 disables the overload path.
+  uint32_t overloadLimit;
+  uint32_t overloadGainCutInDb;
+
+  // If 1, the residual digital gain is applied to IQ blocks.
+  int residualGainEnabled;
+};
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// The event counters of the AGC.  They are maintained by the sample
+// thread, and they are cleared by initialization.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+struct agcCounters
+{
+  uint64_t invocationCount;
+  uint64_t blankedCount;
+  uint64_t deadbandSuppressionCount;
+  uint64_t minGainClampCount;
+  uint64_t maxGainClampCount;
+  uint64_t gainWriteCount;
+  uint64_t overloadBlockCount;
+  uint64_t overloadEventCount;
+};
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// The loop state and counters that the sample thread publishes at the
+// end of each invocation, for agcInstance_getStats().
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+struct agcLoopStats
+{
+  uint32_t blankingCounter;
+  uint32_t gainInDb;
+  uint32_t signalMagnitude;
+  int32_t signalInDbFs;
+  int32_t normalizedSignalLevelInDbFs;
+  uint64_t lastOverloadDuration;
+  uint64_t longestOverloadDuration;
+  uint64_t lastOverloadClippedCount;
+  struct agcCounters counters;
+};
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// All private stuff of an AGC instance is bundled in one structure.
+// The fields that are modified on every invocation of the AGC are
+// placed in the first cache line.  The sample thread's copy of the
+// configuration, and the fields that are only written by
+// agcInstance_init(), start on the next cache line.  The published
+// configuration, which is written by the control thread, starts on a
+// cache line of its own so that updates do not disturb the sample
+// thread until it picks them up.
+//
+// When the gain actuator is running, the AGC does not invoke the set
+// gain callback.  Instead, it posts the gain to a single-slot mailbox
+// and wakes the actuator thread, which writes the most recent gain to
+// the hardware.  The actuator fields start on a cache line of their
+// own, since they are shared by the sample thread and the actuator
+// thread.
+//
+// The signal detector is only used by the sample thread.  It holds
+// its window, so it starts on a cache line of its own after the
+// working configuration.
+//
+// The loop statistics are published the same way, with the sample
+// thread as the only writer, so a monitoring thread can read them
+// without disturbing the AGC.
+//
+// The published configuration is protected by a sequence lock.  A
+// writer takes the configuration lock (writers are serialized), makes
+// the sequence number odd, updates the configuration, and makes the
+// sequence number even again.  The sample thread never takes the lock:
+// on each invocation it compares the sequence number with that of its
+// private copy, and when they differ, it copies the configuration and
+// retries if a writer was active during the copy.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+struct agcInstance
+{
+  //*******************************************************************
+  // Hot section: loop state.
+  //*******************************************************************
+  // Don't run unless the system has been initialized.
+  int initialized;
+
+  // These parameters are sometimes needed to avoid transients.
+  uint32_t blankingCounter;
+  int gainWasAdjusted;
+
+  // System gains.
+  uint32_t gainInDb;
+
+  // Filtered gain.  This is Q16.16 in the fixed-point build.
+  agcFilteredGain filteredGainInDb;
+
+  // The incoming signal magnitude.
+  uint32_t signalMagnitude;
+
+  int32_t signalInDbFs;
+
+  // Signal level before amplification.
+  int32_t normalizedSignalLevelInDbFs;
+
+  // The gain error before the gain rails and the deadband are applied.
+  int32_t gainError;
+
+  // Converts signal magnitudes to dBFs for this instance's word length.
+  struct dbfsCalculator dbfs;
+
+  // The time of the most recent input, in ticks.
+  uint64_t currentTime;
+
+  // Event counters.
+  struct agcCounters counters;
+
+  // The overload event in progress, if any.  The times are in ticks.
+  int overloadActive;
+  uint64_t overloadStartTime;
+  uint64_t overloadEndTime;
+  uint64_t overloadClippedCount;
+
+  // The most recent overload event that has ended, and the longest.
+  uint64_t lastOverloadDuration;
+  uint64_t longestOverloadDuration;
+  uint64_t lastOverloadClippedCount;
+
+  // The linear residual gain that the last sample was given.
+  float residualGain;
+
+  //*******************************************************************
+  // Sample thread section: working configuration and callbacks.
+  //*******************************************************************
+  struct agcConfiguration config
+    __attribute__((aligned(AGC_CACHE_LINE_SIZE)));
+
+  // The sequence number of the published configuration in "config".
+  uint32_t configSequence;
+
+  // The blanking reset count that was last acted upon.
+  uint32_t blankingResetCount;
+
+  // The maximum amplifier gain in decibels
+  uint32_t maxAmplifierGainInDb;
+
+  // The minimum amplifier gain in decibels.
+  uint32_t minAmplifierGainInDb;
+
+  // The gain table of an amplifier with discrete gain steps, and the
+  // nearest step to each gain in decibels.  The callbacks exchange step
+  // indices when there is a table.  A count of 0 means that any whole
+  // number of decibels can be set.
+  uint32_t gainStepCount;
+  uint32_t gainStepInDb[AGC_MAX_GAIN_STEPS];
+  uint8_t gainStepMap[AGC_MAX_GAIN_STEP_IN_DB + 1];
+
+  // The gain stages of a multi-stage amplifier, and the gain of each
+  // stage for each total gain in decibels.  The callbacks exchange the
+  // gains of all of the stages when there are stages.  A count of 0
+  // means that the amplifier is a single stage.
+  uint32_t gainStageCount;
+  struct agcGainStage gainStage[AGC_MAX_GAIN_STAGES];
+  uint32_t stageGainInDb[AGC_MAX_GAIN_STEP_IN_DB + 1][AGC_MAX_GAIN_STAGES];
+  void (*setStageGainsCallbackPtr)(void *contextPtr,
+      const uint32_t *stageGainInDbPtr);
+  void (*getStageGainsCallbackPtr)(void *contextPtr,
+      uint32_t *stageGainInDbPtr);
+
+  // Gain set callback pointer to request client to set gain.
+  void (*setGainCallbackPtr)(void *contextPtr,uint32_t gainIndB);
+
+  // Gain rerieval callback pointer to request gain from e client.
+  uint32_t (*getGainCallbackPtr)(void *contextPtr);
+
+  // The client's context, which is passed to every callback.
+  void *contextPtr;
+
+  // The generation number of the most recent gain request.
+  uint32_t requestedGainGeneration;
+
+  // The generation number of the last external gain change acted upon.
+  uint32_t externalGainGeneration;
+
+  // The time at which the hardware was given the most recent gain.
+  int gainApplied;
+  uint64_t gainAppliedTime;
+
+  //+++++++++++++++++++++++++++++++++++++++++++++++++++
+  // Latency from the hardware being given a gain to
+  // the next gain adjustment, in ticks.  These are
+  // read by the control thread.
+  //+++++++++++++++++++++++++++++++++++++++++++++++++++
+  uint32_t adjustmentLatencyCount;
+  uint64_t lastAdjustmentLatency;
+  uint64_t minAdjustmentLatency;
+  uint64_t maxAdjustmentLatency;
+
+  //*******************************************************************
+  // Detector section: signal detector.
+  //*******************************************************************
+  struct signalDetector detector
+    __attribute__((aligned(AGC_CACHE_LINE_SIZE)));
+
+  //*******************************************************************
+  // Statistics section: published loop statistics.
+  //*******************************************************************
+  uint32_t statsSequence __attribute__((aligned(AGC_CACHE_LINE_SIZE)));
+
+  struct agcLoopStats publishedStats;
+
+  //*******************************************************************
+  // Control thread section: published configuration.
+  //*******************************************************************
+  uint32_t publishedConfigSequence
+    __attribute__((aligned(AGC_CACHE_LINE_SIZE)));
+
+  struct agcConfiguration publishedConfig;
+
+  // Serializes the writers of the published configuration.
+  pthread_mutex_t configLock;
+
+  // The most recent external gain change, with the gain in the lower
+  // 32 bits and its generation number in the upper 32 bits.
+  uint64_t externalGainChange;
+
+  //*******************************************************************
+  // Actuator section: gain actuator thread.
+  //*******************************************************************
+  // The pending gain request, with the gain in the lower 32 bits and
+  // its generation number in the upper 32 bits.  Zero means empty.
+  uint64_t gainMailbox __attribute__((aligned(AGC_CACHE_LINE_SIZE)));
+
+  // The generation number of the most recent gain that was applied.
+  uint32_t appliedGainGeneration;
+
+  // The gain that the actuator last wrote to the hardware.
+  uint32_t actuatorGainInDb;
+
+  // Requests that replaced a request that was not yet applied.
+  uint32_t coalescedGainWriteCount;
+
+  // Requests that were written to the hardware.
+  uint32_t appliedGainWriteCount;
+
+  // Requests that were not written since the hardware had that gain.
+  uint32_t droppedGainWriteCount;
+
+  // Tells the actuator thread to exit.
+  int actuatorStopRequested;
+
+  // Set, under the configuration lock, while a control thread is
+  // starting or stopping the actuator thread without holding the lock.
+  int actuatorBusy;
+
+  // The semaphore lives as long as the instance once it is created.
+  int actuatorSemaphoreCreated;
+  sem_t actuatorSemaphore;
+
+  pthread_t actuatorThread;
+
+#ifdef AGC_INSTRUMENTATION
+  //*******************************************************************
+  // Instrumentation section: latency histograms.
+  //*******************************************************************
+  struct agcLatencyHistogram latency[AGC_LATENCY_HISTOGRAM_COUNT]
+    __attribute__((aligned(AGC_CACHE_LINE_SIZE)));
+#endif
+} __attribute__((aligned(AGC_CACHE_LINE_SIZE)));
+
+// This instance is used by the agc_xxx() functions.
+static struct agcInstance defaultInstance =
+{
+  .configLock = PTHREAD_MUTEX_INITIALIZER
+};
+
+// The callbacks of the agc_xxx() functions carry no context, so they
+// are kept here, and this is the context of the default instance.
+struct agcDefaultCallbacks
+{
+  void (*setGainCallbackPtr)(uint32_t gainIndB);
+  uint32_t (*getGainCallbackPtr)(void);
+  void (*setStageGainsCallbackPtr)(const uint32_t *stageGainInDbPtr);
+  void (*getStageGainsCallbackPtr)(uint32_t *stageGainInDbPtr);
+};
+
+static struct agcDefaultCallbacks defaultCallbacks;
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// The configuration that initialization starts from.  It is constant,
+// so the compiler places it in read-only data, and initialization
+// copies it rather than assigning the fields one at a time.  Fields
+// that are not listed are zero.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+static const struct agcConfiguration defaultConfiguration =
+{
+  // Default to disabled.
+  .enabled = 0,
+
+  // Start with a reasonable deadband.
+  .deadbandInDb = 1,
+
+  // Ignore the invocation that follows a gain adjustment.
+  .blankingMode = AGC_BLANKING_BY_INVOCATIONS,
+  .blankingLimit = 1,
+
+  //+++++++++++++++++++++++++++++++++++++++++++++++++
+  // Set the AGC time constant such that gain
+  // adjustment occurs rapidly while maintaining
+  // system stability.
+  //+++++++++++++++++++++++++++++++++++++++++++++++++
+  .alpha = agcControlLaw_coefficientFromFloat(0.8f),
+
+  // The cheap estimate is good enough for gain control.
+  .magnitudeEstimator = MAGNITUDE_ALPHA_MAX_BETA_MIN,
+
+  // Ask the application for the gain on every invocation.
+  .gainSyncMode = AGC_GAIN_SYNC_POLL,
+
+  // The AGC acts on each magnitude as it is presented.
+  .detectorMode = DETECTOR_NONE,
+  .detectorWindowLength = 1,
+  .detectorAttackQ15 = DETECTOR_COEFFICIENT_ONE,
+  .detectorDecayQ15 = DETECTOR_COEFFICIENT_ONE,
+
+  // The overload path and the residual gain stage are disabled.
+  .overloadLimit = 0,
+  .overloadGainCutInDb = 0,
+  .residualGainEnabled = 0
+};
+
+static int initialize(struct agcInstance *me,
+    int32_t operatingPointInDbFs,
+    uint32_t maxAmplifierGainInDb,
+    uint32_t signalMagnitudeBitCount,
+    void (*setGainCallbackPtr)(void *contextPtr,uint32_t gainIndB),
+    uint32_t (*getGainCallbackPtr)(void *contextPtr),
+    void *contextPtr);
+static void setGainSteps(struct agcInstance *me,
+    const uint32_t *gainStepInDbPtr,
+    uint32_t gainStepCount);
+static void setGainStages(struct agcInstance *me,
+    const struct agcGainStage *stagePtr,
+    uint32_t stageCount,
+    int policy,
+    void (*setStageGainsCallbackPtr)(void *contextPtr,
+        const uint32_t *stageGainInDbPtr),
+    void (*getStageGainsCallbackPtr)(void *contextPtr,
+        uint32_t *stageGainInDbPtr));
+static void setDefaultGain(void *contextPtr,uint32_t gainIndB);
+static uint32_t getDefaultGain(void *contextPtr);
+static void setDefaultStageGains(void *contextPtr,
+    const uint32_t *stageGainInDbPtr);
+static void getDefaultStageGains(void *contextPtr,
+    uint32_t *stageGainInDbPtr);
+static uint32_t quantizeGain(struct agcInstance *me,uint32_t gainInDb);
+static int decodeGainSetting(struct agcInstance *me,
+    uint32_t setting,
+    uint32_t *gainInDbPtr);
+static void beginConfigurationUpdate(struct agcInstance *me);
+static void endConfigurationUpdate(struct agcInstance *me);
+static void applyConfigurationUpdates(struct agcInstance *me);
+static void *runGainActuator(void *argPtr);
+static void postGainRequest(struct agcInstance *me,uint32_t gainInDb);
+static void applyGainRequest(struct agcInstance *me,uint64_t request);
+static int isGainWritePending(struct agcInstance *me);
+static void resetBlankingSystem(struct agcInstance *me);
+static void synchronizeGain(struct agcInstance *me);
+static void publishStatistics(struct agcInstance *me);
+static int isBlankingComplete(struct agcInstance *me);
+static void recordGainAdjustment(struct agcInstance *me);
+static void recordTrace(struct agcInstance *me,
+    struct agcTraceRecorder *recorderPtr,
+    const struct agcCounters *previousCountersPtr,
+    int allowedToRun,
+    int overloaded);
+static int detectOverload(struct agcInstance *me,
+    uint32_t clippedCount,
+    uint32_t sampleCount);
+static void run(struct agcInstance *me,
+    const uint32_t *signalMagnitudePtr,
+    uint32_t count,
+    int overloaded);
+static void runHarris(struct agcInstance *me,
+    uint32_t signalMagnitude,
+    int32_t signalInDbFs);
+static void runFastAttack(struct agcInstance *me,uint32_t signalMagnitude);
+static void applyGainAdjustment(struct agcInstance *me);
+static int updateResidualGain(struct agcInstance *me,
+    float *startGainPtr,
+    float *endGainPtr);
+static void setHardwareGainInDb(struct agcInstance *me,uint32_t gainInDb);
+static uint32_t getHardwareGainInDb(struct agcInstance *me);
+
+/**************************************************************************
+
+  Name: agcInstance_create
+
+  Purpose: The purpose of this function is to allocate an AGC instance.
+  The instance is aligned to a cache line so that instances that are
+  run by different threads do not share cache lines.  The instance
+  must be initialized by agcInstance_init() before it is used.
+
+  Calling Sequence: agcPtr = agcInstance_create()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    agcPtr - A pointer to the AGC instance.  A value of NULL indicates
+    that memory could not be allocated.
+
+**************************************************************************/
+struct agcInstance *agcInstance_create(void)
+{
+  void *memoryPtr;
+  struct agcInstance *agcPtr;
+
+  // Default to failure.
+  agcPtr = NULL;
+
+  if (posix_memalign(&memoryPtr,
+                     AGC_CACHE_LINE_SIZE,
+                     sizeof(struct agcInstance)) == 0)
+  {
+    agcPtr = (struct agcInstance *)memoryPtr;
+
+    // Make sure this indicates we're not initialized.
+    memset(agcPtr,0,sizeof(struct agcInstance));
+
+    pthread_mutex_init(&agcPtr->configLock,NULL);
+  } // if
+
+  return (agcPtr);
+
+} // agcInstance_create
+
+/**************************************************************************
+
+  Name: agcInstance_destroy
+
+  Purpose: The purpose of this function is to release the resources of
+  an AGC instance that was allocated by agcInstance_create().
+
+  Calling Sequence: agcInstance_destroy(me)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.  A value of NULL is ignored.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_destroy(struct agcInstance *me)
+{
+
+  if (me != NULL)
+  {
+    // Make sure the actuator thread is gone.
+    agcInstance_stopGainActuator(me);
+
+    if (me->actuatorSemaphoreCreated)
+    {
+      sem_destroy(&me->actuatorSemaphore);
+    } // if
+
+    pthread_mutex_destroy(&me->configLock);
+
+    free(me);
+  } // if
+
+  return;
+
+} // agcInstance_destroy
+
+/**************************************************************************
+
+  Name: agcInstance_acceptData
+
+  Purpose: The purpose of this function is the interface to run the AGC.
+
+  Calling Sequence: agcInstance_acceptData(me,signalMagnitude)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    signalMagnitude - The magnitude of the signal.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_acceptData(struct agcInstance *me,
+    uint32_t signalMagnitude)
+{
+  AGC_LATENCY_START(startTime);
+
+  // Allow the AGC to poerate if it is configured.
+  if (me->initialized)
+  {
+    // Pick up any parameter changes.
+    applyConfigurationUpdates(me);
+
+    // Without a timestamp, each invocation is one tick.
+    me->currentTime++;
+
+    if (me->config.enabled)
+    {
+      // Process the signal.
+      run(me,&signalMagnitude,1,0);
+    } // if
+  } // if
+
+  AGC_LATENCY_STOP(&me->latency[AGC_LATENCY_INVOCATION],startTime);
+
+  return;
+
+} // agcInstance_acceptData
+
+/**************************************************************************
+
+  Name: agcInstance_acceptDataAt
+
+  Purpose: The purpose of this function is the interface to run the AGC
+  with a signal magnitude that is tagged with the time at which it was
+  measured.  The timestamp is used by the duration blanking mode, and
+  it can be in any units (for example, nanoseconds from
+  CLOCK_MONOTONIC, or a running sample count) as long as it never
+  decreases and the blanking duration is expressed in the same units.
+
+  Calling Sequence: agcInstance_acceptDataAt(me,signalMagnitude,timestamp)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    signalMagnitude - The magnitude of the signal.
+
+    timestamp - The time at which the magnitude was measured.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_acceptDataAt(struct agcInstance *me,
+    uint32_t signalMagnitude,
+    uint64_t timestamp)
+{
+  AGC_LATENCY_START(startTime);
+
+  // Allow the AGC to operate if it is configured.
+  if (me->initialized)
+  {
+    // Pick up any parameter changes.
+    applyConfigurationUpdates(me);
+
+    // The application keeps the time.
+    me->currentTime = timestamp;
+
+    if (me->config.enabled)
+    {
+      // Process the signal.
+      run(me,&signalMagnitude,1,0);
+    } // if
+  } // if
+
+  AGC_LATENCY_STOP(&me->latency[AGC_LATENCY_INVOCATION],startTime);
+
+  return;
+
+} // agcInstance_acceptDataAt
+
+/**************************************************************************
+
+  Name: agcInstance_acceptIqBlockU8
+
+  Purpose: The purpose of this function is the interface to run the AGC
+  with a block of raw interleaved IQ samples that are stored as unsigned
+  offset binary bytes, as produced by the rtl-sdr.  The average
+  magnitude of the block is computed, and the AGC is run with that
+  magnitude.  The magnitude is only computed when the AGC is enabled.
+  When the overload path is enabled, the clipped samples of the block
+  are counted too, and a block that overloads the ADC makes the AGC
+  cut the gain at once (see agcInstance_setOverloadDetection()).
+
+  Calling Sequence: agcInstance_acceptIqBlockU8(me,iqPtr,sampleCount)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_acceptIqBlockU8(struct agcInstance *me,
+    const uint8_t *iqPtr,
+    uint32_t sampleCount)
+{
+  int overloaded;
+  uint32_t signalMagnitude;
+  uint32_t clippedCount;
+  AGC_LATENCY_START(startTime);
+
+  // Allow the AGC to operate if it is configured.
+  if (me->initialized)
+  {
+    // Pick up any parameter changes.
+    applyConfigurationUpdates(me);
+
+    // Each sample is one tick.
+    me->currentTime += sampleCount;
+
+    if (me->config.enabled)
+    {
+      signalMagnitude = magnitude_averageU8(iqPtr,
+                                            sampleCount,
+                                            me->config.magnitudeEstimator);
+
+      clippedCount = 0;
+
+      if (me->config.overloadLimit != 0)
+      {
+        clippedCount = magnitude_countClippedU8(iqPtr,
+                                                sampleCount,
+                                                me->dbfs.fullScaleValue);
+      } // if
+
+      overloaded = detectOverload(me,clippedCount,sampleCount);
+
+      // Process the signal.
+      run(me,&signalMagnitude,1,overloaded);
+    } // if
+  } // if
+
+  AGC_LATENCY_STOP(&me->latency[AGC_LATENCY_INVOCATION],startTime);
+
+  return;
+
+} // agcInstance_acceptIqBlockU8
+
+/**************************************************************************
+
+  Name: agcInstance_acceptIqBlockS8
+
+  Purpose: The purpose of this function is the interface to run the AGC
+  with a block of raw interleaved IQ samples that are stored as signed
+  bytes, as produced by the HackRF.
+
+  Calling Sequence: agcInstance_acceptIqBlockS8(me,iqPtr,sampleCount)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_acceptIqBlockS8(struct agcInstance *me,
+    const int8_t *iqPtr,
+    uint32_t sampleCount)
+{
+  int overloaded;
+  uint32_t signalMagnitude;
+  uint32_t clippedCount;
+  AGC_LATENCY_START(startTime);
+
+  // Allow the AGC to operate if it is configured.
+  if (me->initialized)
+  {
+    // Pick up any parameter changes.
+    applyConfigurationUpdates(me);
+
+    // Each sample is one tick.
+    me->currentTime += sampleCount;
+
+    if (me->config.enabled)
+    {
+      signalMagnitude = magnitude_averageS8(iqPtr,
+                                            sampleCount,
+                                            me->config.magnitudeEstimator);
+
+      clippedCount = 0;
+
+      if (me->config.overloadLimit != 0)
+      {
+        clippedCount = magnitude_countClippedS8(iqPtr,
+                                                sampleCount,
+                                                me->dbfs.fullScaleValue);
+      } // if
+
+      overloaded = detectOverload(me,clippedCount,sampleCount);
+
+      // Process the signal.
+      run(me,&signalMagnitude,1,overloaded);
+    } // if
+  } // if
+
+  AGC_LATENCY_STOP(&me->latency[AGC_LATENCY_INVOCATION],startTime);
+
+  return;
+
+} // agcInstance_acceptIqBlockS8
+
+/**************************************************************************
+
+  Name: agcInstance_acceptIqBlockS16
+
+  Purpose: The purpose of this function is the interface to run the AGC
+  with a block of raw interleaved IQ samples that are stored as signed
+  16-bit quantities.
+
+  Calling Sequence: agcInstance_acceptIqBlockS16(me,iqPtr,sampleCount)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_acceptIqBlockS16(struct agcInstance *me,
+    const int16_t *iqPtr,
+    uint32_t sampleCount)
+{
+  int overloaded;
+  uint32_t signalMagnitude;
+  uint32_t clippedCount;
+  AGC_LATENCY_START(startTime);
+
+  // Allow the AGC to operate if it is configured.
+  if (me->initialized)
+  {
+    // Pick up any parameter changes.
+    applyConfigurationUpdates(me);
+
+    // Each sample is one tick.
+    me->currentTime += sampleCount;
+
+    if (me->config.enabled)
+    {
+      signalMagnitude = magnitude_averageS16(iqPtr,
+                                             sampleCount,
+                                             me->config.magnitudeEstimator);
+
+      clippedCount = 0;
+
+      if (me->config.overloadLimit != 0)
+      {
+        clippedCount = magnitude_countClippedS16(iqPtr,
+                                                 sampleCount,
+                                                 me->dbfs.fullScaleValue);
+      } // if
+
+      overloaded = detectOverload(me,clippedCount,sampleCount);
+
+      // Process the signal.
+      run(me,&signalMagnitude,1,overloaded);
+    } // if
+  } // if
+
+  AGC_LATENCY_STOP(&me->latency[AGC_LATENCY_INVOCATION],startTime);
+
+  return;
+
+} // agcInstance_acceptIqBlockS16
+
+/**************************************************************************
+
+  Name: agcInstance_acceptMagnitudeBlock
+
+  Purpose: The purpose of this function is the interface to run the AGC
+  once with a block of signal magnitudes, for example the magnitudes of
+  the samples of a block.  All of the magnitudes are given to the signal
+  detector, and the AGC acts on the detected magnitude.  Without a
+  detector, the AGC acts on the mean of the block.
+
+  Calling Sequence: agcInstance_acceptMagnitudeBlock(me,
+                                                     signalMagnitudePtr,
+                                                     count)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    signalMagnitudePtr - A pointer to the magnitudes.
+
+    count - The number of magnitudes in the block.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_acceptMagnitudeBlock(struct agcInstance *me,
+    const uint32_t *signalMagnitudePtr,
+    uint32_t count)
+{
+  AGC_LATENCY_START(startTime);
+
+  // Allow the AGC to operate if it is configured.
+  if (me->initialized)
+  {
+    // Pick up any parameter changes.
+    applyConfigurationUpdates(me);
+
+    // Each magnitude is one tick.
+    me->currentTime += count;
+
+    if ((me->config.enabled) && (count != 0))
+    {
+      // Process the signal.
+      run(me,signalMagnitudePtr,count,0);
+    } // if
+  } // if
+
+  AGC_LATENCY_STOP(&me->latency[AGC_LATENCY_INVOCATION],startTime);
+
+  return;
+
+} // agcInstance_acceptMagnitudeBlock
+
+/**************************************************************************
+
+  Name: agcInstance_applyResidualGainS8
+
+  Purpose: The purpose of this function is to apply the residual gain
+  to a block of interleaved IQ samples that are stored as signed bytes,
+  in place.  The hardware gain is a whole number of decibels, and the
+  residual gain is the fraction of a decibel by which the filtered gain
+  exceeds it.  The gain ramps from the residual gain of the previous
+  block to the current one across the block, so a change of the gain
+  does not click.  The block is normally the one that was just presented
+  to agcInstance_acceptIqBlockS8().  Nothing is done if the residual gain
+  stage is disabled and the gain has settled at unity.
+
+  Calling Sequence: agcInstance_applyResidualGainS8(me,iqPtr,sampleCount)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_applyResidualGainS8(struct agcInstance *me,
+    int8_t *iqPtr,
+    uint32_t sampleCount)
+{
+  float startGain;
+  float endGain;
+
+  if (updateResidualGain(me,&startGain,&endGain))
+  {
+    digitalGain_applyS8(iqPtr,sampleCount,startGain,endGain);
+  } // if
+
+  return;
+
+} // agcInstance_applyResidualGainS8
+
+/**************************************************************************
+
+  Name: agcInstance_applyResidualGainS16
+
+  Purpose: The purpose of this function is to apply the residual gain
+  to a block of interleaved IQ samples that are stored as signed 16-bit
+  quantities, in place.  See agcInstance_applyResidualGainS8().
+
+  Calling Sequence: agcInstance_applyResidualGainS16(me,iqPtr,sampleCount)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_applyResidualGainS16(struct agcInstance *me,
+    int16_t *iqPtr,
+    uint32_t sampleCount)
+{
+  float startGain;
+  float endGain;
+
+  if (updateResidualGain(me,&startGain,&endGain))
+  {
+    digitalGain_applyS16(iqPtr,sampleCount,startGain,endGain);
+  } // if
+
+  return;
+
+} // agcInstance_applyResidualGainS16
+
+/**************************************************************************
+
+  Name: agcInstance_applyResidualGainF32
+
+  Purpose: The purpose of this function is to apply the residual gain
+  to a block of interleaved IQ samples that are stored as floats, in
+  place.  See agcInstance_applyResidualGainS8().
+
+  Calling Sequence: agcInstance_applyResidualGainF32(me,iqPtr,sampleCount)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_applyResidualGainF32(struct agcInstance *me,
+    float *iqPtr,
+    uint32_t sampleCount)
+{
+  float startGain;
+  float endGain;
+
+  if (updateResidualGain(me,&startGain,&endGain))
+  {
+    digitalGain_applyF32(iqPtr,sampleCount,startGain,endGain);
+  } // if
+
+  return;
+
+} // agcInstance_applyResidualGainF32
+
+/**************************************************************************
+
+  Name: agcInstance_setMagnitudeEstimator
+
+  Purpose: The purpose of this function is to select the method that is
+  used to compute the magnitude of the IQ blocks that are presented to
+  the agcInstance_acceptIqBlockXxx() functions.
+
+  Calling Sequence: success = agcInstance_setMagnitudeEstimator(me,
+                                                                estimator)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    estimator - The estimation method.  A value of
+    AGC_MAGNITUDE_ALPHA_MAX_BETA_MIN selects the alpha max plus beta min
+    approximation, and a value of AGC_MAGNITUDE_EXACT selects
+    sqrt(I^2 + Q^2).
+
+  Outputs:
+
+    success - A flag that indicates whether or not the estimator was
+    updated.  A value of 1 indicates that the estimator was updated, and
+    a value of 0 indicates that the estimator value was invalid.
+
+**************************************************************************/
+int agcInstance_setMagnitudeEstimator(struct agcInstance *me,
+    int estimator)
+{
+  int success;
+  int magnitudeEstimator;
+
+  // Default to success.
+  success = 1;
+
+  switch (estimator)
+  {
+    case AGC_MAGNITUDE_ALPHA_MAX_BETA_MIN:
+    {
+      magnitudeEstimator = MAGNITUDE_ALPHA_MAX_BETA_MIN;
+      break;
+    } // case
+
+    case AGC_MAGNITUDE_EXACT:
+    {
+      magnitudeEstimator = MAGNITUDE_EXACT;
+      break;
+    } // case
+
+    default:
+    {
+      success = 0;
+      break;
+    } // case
+  } // switch
+
+  if (success)
+  {
+    // Publish the new estimator.
+    beginConfigurationUpdate(me);
+    me->publishedConfig.magnitudeEstimator = magnitudeEstimator;
+    endConfigurationUpdate(me);
+  } // if
+
+  return (success);
+
+} // agcInstance_setMagnitudeEstimator
+
+/**************************************************************************
+
+  Name: agcInstance_setDetector
+
+  Purpose: The purpose of this function is to select the signal
+  detector that sits in front of the AGC algorithm, and the length of
+  its sliding window.  The detector starts over with an empty window.
+
+  Calling Sequence: success = agcInstance_setDetector(me,mode,
+                                                      windowLength)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    mode - The detection method.  A value of AGC_DETECTOR_NONE makes the
+    AGC act on each magnitude as it is presented, AGC_DETECTOR_MEAN
+    selects the mean magnitude of the window, AGC_DETECTOR_RMS selects
+    the RMS magnitude, AGC_DETECTOR_LOG_AVERAGE selects the average of
+    the magnitudes in decibels, and AGC_DETECTOR_PEAK selects the peak
+    magnitude.
+
+    windowLength - The number of magnitudes in the window, from 1 to
+    AGC_DETECTOR_MAX_WINDOW_LENGTH.  It is ignored by AGC_DETECTOR_NONE.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the detector was
+    updated.  A value of 1 indicates that the detector was updated, and
+    a value of 0 indicates that the mode or the window length was
+    invalid.
+
+**************************************************************************/
+int agcInstance_setDetector(struct agcInstance *me,
+    int mode,
+    uint32_t windowLength)
+{
+  int success;
+  int detectorMode;
+
+  // Default to success.
+  success = 1;
+
+  switch (mode)
+  {
+    case AGC_DETECTOR_NONE:
+    {
+      detectorMode = DETECTOR_NONE;
+      windowLength = 1;
+      break;
+    } // case
+
+    case AGC_DETECTOR_MEAN:
+    {
+      detectorMode = DETECTOR_MEAN;
+      break;
+    } // case
+
+    case AGC_DETECTOR_RMS:
+    {
+      detectorMode = DETECTOR_RMS;
+      break;
+    } // case
+
+    case AGC_DETECTOR_LOG_AVERAGE:
+    {
+      detectorMode = DETECTOR_LOG_AVERAGE;
+      break;
+    } // case
+
+    case AGC_DETECTOR_PEAK:
+    {
+      detectorMode = DETECTOR_PEAK;
+      break;
+    } // case
+
+    default:
+    {
+      success = 0;
+      break;
+    } // case
+  } // switch
+
+  if ((windowLength == 0) || (windowLength > DETECTOR_MAX_WINDOW_LENGTH))
+  {
+    success = 0;
+  } // if
+
+  if (success)
+  {
+    // Publish the new detector.
+    beginConfigurationUpdate(me);
+    me->publishedConfig.detectorMode = detectorMode;
+    me->publishedConfig.detectorWindowLength = windowLength;
+    endConfigurationUpdate(me);
+  } // if
+
+  return (success);
+
+} // agcInstance_setDetector
+
+/**************************************************************************
+
+  Name: agcInstance_setDetectorSmoothing
+
+  Purpose: The purpose of this function is to set how the signal
+  detector smooths its measurement.  Each time that the AGC acts, the
+  smoothed measurement moves toward the new measurement by the attack
+  coefficient times the difference when the measurement is rising, and
+  by the decay coefficient times the difference when it is falling.  A
+  fast attack with a slow decay makes the AGC cut the gain quickly and
+  restore it slowly.
+
+  Calling Sequence: success = agcInstance_setDetectorSmoothing(me,attack,
+                                                               decay)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    attack - The attack coefficient, in the range of (0,1].  A value of
+    1 follows a rising measurement immediately.
+
+    decay - The decay coefficient, in the range of (0,1].  A value of 1
+    follows a falling measurement immediately.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the coefficients
+    were updated.  A value of 0 indicates that a coefficient was out of
+    range.
+
+**************************************************************************/
+int agcInstance_setDetectorSmoothing(struct agcInstance *me,
+    float attack,
+    float decay)
+{
+  int success;
+
+  // Default to failure.
+  success = 0;
+
+  if ((attack >= 0.001) && (attack <= 1) &&
+      (decay >= 0.001) && (decay <= 1))
+  {
+    // Publish the coefficients.
+    beginConfigurationUpdate(me);
+    me->publishedConfig.detectorAttackQ15 =
+      (uint32_t)((attack * DETECTOR_COEFFICIENT_ONE) + 0.5f);
+    me->publishedConfig.detectorDecayQ15 =
+      (uint32_t)((decay * DETECTOR_COEFFICIENT_ONE) + 0.5f);
+    endConfigurationUpdate(me);
+
+    // Indicate success.
+    success = 1;
+  } // if
+
+  return (success);
+
+} // agcInstance_setDetectorSmoothing
+
+/**************************************************************************
+
+  Name: agcInstance_setOverloadDetection
+
+  Purpose: The purpose of this function is to configure the overload
+  path of the AGC.  The samples of each IQ block that reached the clip
+  level of the ADC (full scale for signalMagnitudeBitCount) are
+  counted, and a block with at least clippedSampleLimit of them
+  overloads the ADC.  An overloaded block bypasses blanking and the
+  lowpass filter: the gain is cut by gainCutInDb at once, and the
+  filter continues from the new gain.  A run of overloaded blocks is
+  an overload event, and the time that each event lasted is reported
+  by agcInstance_getStats().
+
+  Calling Sequence: success =
+                      agcInstance_setOverloadDetection(me,
+                                                       clippedSampleLimit,
+                                                       gainCutInDb)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    clippedSampleLimit - The number of clipped samples that make a
+    block overload the ADC.  A value of 0 disables the overload path.
+
+    gainCutInDb - The gain cut, in decibels, for an overloaded block.
+    It must be nonzero unless the overload path is disabled.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the overload path
+    was updated.  A value of 0 indicates that the gain cut was invalid.
+
+**************************************************************************/
+int agcInstance_setOverloadDetection(struct agcInstance *me,
+    uint32_t clippedSampleLimit,
+    uint32_t gainCutInDb)
+{
+  int success;
+
+  // Default to failure.
+  success = 0;
+
+  if ((clippedSampleLimit == 0) || (gainCutInDb != 0))
+  {
+    // Publish the overload path.
+    beginConfigurationUpdate(me);
+    me->publishedConfig.overloadLimit = clippedSampleLimit;
+    me->publishedConfig.overloadGainCutInDb = gainCutInDb;
+    endConfigurationUpdate(me);
+
+    // Indicate success.
+    success = 1;
+  } // if
+
+  return (success);
+
+} // agcInstance_setOverloadDetection
+
+/**************************************************************************
+
+  Name: agcInstance_setResidualGain
+
+  Purpose: The purpose of this function is to enable or disable the
+  residual gain stage, which is applied to IQ blocks by the
+  agcInstance_applyResidualGainXxx() functions.  When the stage is
+  disabled, the gain ramps back to unity over the next block.
+
+  Calling Sequence: agcInstance_setResidualGain(me,enabled)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    enabled - A value of 1 enables the residual gain stage, and a value
+    of 0 disables it.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_setResidualGain(struct agcInstance *me,int enabled)
+{
+
+  // Publish the residual gain stage.
+  beginConfigurationUpdate(me);
+  me->publishedConfig.residualGainEnabled = (enabled != 0);
+  endConfigurationUpdate(me);
+
+  return;
+
+} // agcInstance_setResidualGain
+
+/************************************************************************
+
+  Name: agcInstance_init
+
+  Purpose: The purpose of this function is to initialize an AGC
+  instance.
+
+  Calling Sequence: initialized = agcInstance_init(me,
+                                                   operatingPointInDbFs,
+                                                   maxAmplifierGainInDb,
+                                                   signalMagnitudeBitCount,
+                                                   setGainCallbackPtr,
+                                                   getGainCallbackPtr,
+                                                   contextPtr)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    operatingPointInDbFs - The AGC operating point in decibels referenced
+    to full scale.  Full scale represents 0dBFs, otherwise, all other
+    values will be negative.
+
+    maxAmplifierGainInDb - The maximum gain of the amplifier in decibels.
+    It is the responsibility of the application to know the hardware
+    characteristics.
+
+    signalMagnitudeBitCount - The number of magnitude bits in a signal.
+    This is necssary to map a signal magnitude into the log domain so
+    the AGC algorithm can perform all computations in a decibel
+    scale (specifically dBFS).  It follows that linear system theory
+    can be applied.
+
+    setGainCallbackPtr - A pointer to a client callback function that
+    is invoked to request the client application to set the hardware gain.
+    A value of NULL is used if the client does not want to register a
+    callback.
+    If a callback is not registered,the AGC will never modify modify
+    the hardware gain.  In other words, rhe system will have no AGC.
+
+    getGainCallbackPtr - A pointer to a client callback function that
+    is invoked to request the client application to supply the hardware
+    gain.
+    A value of NULL is used if the client does not want to register a
+    callback.
+    In  other words, if a callback is not registered, the AGC will have
+    no knowledge if the gain was modifies by anyone  else. DO THIS AT
+    YOUR OWN RISK.
+
+    contextPtr - A pointer that is passed to every callback, so that a
+    callback can find the amplifier of this instance without a global
+    or thread-local variable.  It may be NULL.
+
+  Outputs:
+
+    initialized - A flag that indicate whether the system was properly
+    initialized, and a value of zero indicates that was not initialized..
+
+**************************************************************************/
+int agcInstance_init(struct agcInstance *me,
+    int32_t operatingPointInDbFs,
+    uint32_t maxAmplifierGainInDb,
+    uint32_t signalMagnitudeBitCount,
+    void (*setGainCallbackPtr)(void *contextPtr,uint32_t gainIndB),
+    uint32_t (*getGainCallbackPtr)(void *contextPtr),
+    void *contextPtr)
+{
+
+  // Any whole number of decibels up to the maximum can be set.
+  setGainSteps(me,NULL,0);
+  setGainStages(me,NULL,0,0,NULL,NULL);
+
+  return (initialize(me,
+                     operatingPointInDbFs,
+                     maxAmplifierGainInDb,
+                     signalMagnitudeBitCount,
+                     setGainCallbackPtr,
+                     getGainCallbackPtr,
+                     contextPtr));
+
+} // agcInstance_init
+
+/************************************************************************
+
+  Name: agcInstance_initWithGainSteps
+
+  Purpose: The purpose of this function is to initialize an AGC
+  instance for an amplifier that has discrete gain steps, such as the
+  LNA of the R820T tuner.  The AGC only sets gains that are in the gain
+  table, and the callbacks exchange indices into the table instead of
+  gains in decibels.  A map from each gain in decibels to the nearest
+  step is computed here, so the AGC finds the step for a gain with one
+  lookup.
+
+  Calling Sequence: initialized =
+                      agcInstance_initWithGainSteps(me,
+                                                    operatingPointInDbFs,
+                                                    gainStepInDbPtr,
+                                                    gainStepCount,
+                                                    signalMagnitudeBitCount,
+                                                    setGainStepCallbackPtr,
+                                                    getGainStepCallbackPtr,
+                                                    contextPtr)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    operatingPointInDbFs - The AGC operating point in decibels referenced
+    to full scale.
+
+    gainStepInDbPtr - A pointer to the gains of the steps, in decibels,
+    in increasing order.  The largest gain is the maximum amplifier
+    gain, and it can be at most AGC_MAX_GAIN_STEP_IN_DB.  The table is
+    copied.
+
+    gainStepCount - The number of steps, from 1 to AGC_MAX_GAIN_STEPS.
+
+    signalMagnitudeBitCount - The number of magnitude bits in a signal.
+
+    setGainStepCallbackPtr - A pointer to a client callback function
+    that is invoked with the index of the step that the hardware should
+    be set to, or NULL.
+
+    getGainStepCallbackPtr - A pointer to a client callback function
+    that returns the index of the step that the hardware is set to, or
+    NULL.
+
+    contextPtr - A pointer that is passed to every callback.
+
+  Outputs:
+
+    initialized - A flag that indicate whether the system was properly
+    initialized.  A value of zero indicates that it was not initialized,
+    possibly because the gain table was invalid.
+
+**************************************************************************/
+int agcInstance_initWithGainSteps(struct agcInstance *me,
+    int32_t operatingPointInDbFs,
+    const uint32_t *gainStepInDbPtr,
+    uint32_t gainStepCount,
+    uint32_t signalMagnitudeBitCount,
+    void (*setGainStepCallbackPtr)(void *contextPtr,uint32_t gainStep),
+    uint32_t (*getGainStepCallbackPtr)(void *contextPtr),
+    void *contextPtr)
+{
+  int initialized;
+  int valid;
+  uint32_t i;
+
+  valid = (gainStepCount != 0) && (gainStepCount <= AGC_MAX_GAIN_STEPS);
+
+  // The steps must increase, and the map has to reach the largest one.
+  for (i = 0; (valid) && (i < gainStepCount); i++)
+  {
+    if (gainStepInDbPtr[i] > AGC_MAX_GAIN_STEP_IN_DB)
+    {
+      valid = 0;
+    } // if
+    else
+    {
+      if ((i != 0) && (gainStepInDbPtr[i] <= gainStepInDbPtr[i - 1]))
+      {
+        valid = 0;
+      } // if
+    } // else
+  } // for
+
+  if (valid)
+  {
+    setGainSteps(me,gainStepInDbPtr,gainStepCount);
+    setGainStages(me,NULL,0,0,NULL,NULL);
+
+    initialized = initialize(me,
+                             operatingPointInDbFs,
+                             gainStepInDbPtr[gainStepCount - 1],
+                             signalMagnitudeBitCount,
+                             setGainStepCallbackPtr,
+                             getGainStepCallbackPtr,
+                             contextPtr);
+  } // if
+  else
+  {
+    // Don't let the AGC run with whatever it had before.
+    me->initialized = 0;
+
+    initialized = 0;
+  } // else
+
+  return (initialized);
+
+} // agcInstance_initWithGainSteps
+
+/************************************************************************
+
+  Name: agcInstance_initWithGainStages
+
+  Purpose: The purpose of this function is to initialize an AGC
+  instance for a receiver whose gain is spread across several stages,
+  such as an LNA, a mixer and a VGA.  The AGC controls the total gain,
+  which ranges from the sum of the minimum gains of the stages to the
+  sum of their maximum gains, and the distribution policy decides which
+  stages a change of the total gain goes to.  A table of the gain of
+  each stage for each total gain is computed here, so an adjustment is
+  one lookup and one invocation of the set callback with the gains of
+  all of the stages.
+
+  Calling Sequence: initialized =
+                      agcInstance_initWithGainStages(me,
+                                                     operatingPointInDbFs,
+                                                     stagePtr,
+                                                     stageCount,
+                                                     policy,
+                                                     signalMagnitudeBitCount,
+                                                     setStageGainsCallbackPtr,
+                                                     getStageGainsCallbackPtr,
+                                                     contextPtr)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    operatingPointInDbFs - The AGC operating point in decibels referenced
+    to full scale.
+
+    stagePtr - A pointer to the gain ranges of the stages, in decibels,
+    with the stage nearest to the antenna first.  The sum of the maximum
+    gains can be at most AGC_MAX_GAIN_STEP_IN_DB.  The ranges are
+    copied.
+
+    stageCount - The number of stages, from 1 to AGC_MAX_GAIN_STAGES.
+
+    policy - The distribution policy.  A value of
+    AGC_DISTRIBUTE_FRONT_FIRST fills the stages from the antenna on,
+    which gives the best noise figure, a value of
+    AGC_DISTRIBUTE_BACK_FIRST fills them from the last stage back,
+    which gives the best linearity, and a value of AGC_DISTRIBUTE_EVENLY
+    spreads the gain evenly over the stages.
+
+    signalMagnitudeBitCount - The number of magnitude bits in a signal.
+
+    setStageGainsCallbackPtr - A pointer to a client callback function
+    that is invoked with the gains, in decibels, that the stages should
+    be set to, or NULL.
+
+    getStageGainsCallbackPtr - A pointer to a client callback function
+    that stores the gains, in decibels, that the stages are set to, or
+    NULL.
+
+    contextPtr - A pointer that is passed to every callback.
+
+  Outputs:
+
+    initialized - A flag that indicate whether the system was properly
+    initialized.  A value of zero indicates that it was not initialized,
+    possibly because a stage or the policy was invalid.
+
+**************************************************************************/
+int agcInstance_initWithGainStages(struct agcInstance *me,
+    int32_t operatingPointInDbFs,
+    const struct agcGainStage *stagePtr,
+    uint32_t stageCount,
+    int policy,
+    uint32_t signalMagnitudeBitCount,
+    void (*setStageGainsCallbackPtr)(void *contextPtr,
+        const uint32_t *stageGainInDbPtr),
+    void (*getStageGainsCallbackPtr)(void *contextPtr,
+        uint32_t *stageGainInDbPtr),
+    void *contextPtr)
+{
+  int initialized;
+  int valid;
+  uint32_t i;
+  uint32_t maxGainInDb;
+
+  valid = (stageCount != 0) && (stageCount <= AGC_MAX_GAIN_STAGES);
+
+  if ((policy != AGC_DISTRIBUTE_FRONT_FIRST) &&
+      (policy != AGC_DISTRIBUTE_BACK_FIRST) &&
+      (policy != AGC_DISTRIBUTE_EVENLY))
+  {
+    valid = 0;
+  } // if
+
+  maxGainInDb = 0;
+
+  // The table has to reach the largest total gain.
+  for (i = 0; (valid) && (i < stageCount); i++)
+  {
+    if ((stagePtr[i].minGainInDb > stagePtr[i].maxGainInDb) ||
+        (stagePtr[i].maxGainInDb > AGC_MAX_GAIN_STEP_IN_DB))
+    {
+      valid = 0;
+    } // if
+    else
+    {
+      maxGainInDb += stagePtr[i].maxGainInDb;
+
+      if (maxGainInDb > AGC_MAX_GAIN_STEP_IN_DB)
+      {
+        valid = 0;
+      } // if
+    } // else
+  } // for
+
+  if (valid)
+  {
+    setGainSteps(me,NULL,0);
+    setGainStages(me,
+                  stagePtr,
+                  stageCount,
+                  policy,
+                  setStageGainsCallbackPtr,
+                  getStageGainsCallbackPtr);
+
+    initialized = initialize(me,
+                             operatingPointInDbFs,
+                             maxGainInDb,
+                             signalMagnitudeBitCount,
+                             NULL,
+                             NULL,
+                             contextPtr);
+  } // if
+  else
+  {
+    // Don't let the AGC run with whatever it had before.
+    me->initialized = 0;
+
+    initialized = 0;
+  } // else
+
+  return (initialized);
+
+} // agcInstance_initWithGainStages
+
+/**************************************************************************
+
+  Name: agcInstance_setDeadband
+
+  Purpose: The purpose of this function is to set the deadband of the
+  AGC.  This presents gain setting oscillations
+
+  Calling Sequence: success = agcInstance_setDeadband(me,deadbandInDb)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    deadbandInDb - The deadband, in decibels, used to prevent unwanted
+    gain setting oscillations.  A window is created such that a gain
+    adjustment will not occur if the current gain is within the window
+    new gain <= current gain += deadband.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the deadband parameter
+    was updated.  A value of 1 indicates that the deadband was
+    updated, and a value of 0 indicates that the parameter was not
+    updated due to an invalid specified deadband value.
+
+**************************************************************************/
+int agcInstance_setDeadband(struct agcInstance *me,
+    uint32_t deadbandInDb)
+{
+  int success;
+
+  // Default to failure.
+  success = 0;
+
+  if ((deadbandInDb >= 0) && (deadbandInDb <= 10))
+  {
+    // Publish the attribute.
+    beginConfigurationUpdate(me);
+    me->publishedConfig.deadbandInDb = deadbandInDb;
+    endConfigurationUpdate(me);
+
+    // Indicate success.
+    success = 1;
+  } // if
+
+  return (success);
+
+} // agcInstance_setDeadband
+
+/**************************************************************************
+
+  Name: agcInstance_setBlankingLimit
+
+  Purpose: The purpose of this function is to set the blanking limit of
+  the AGC.  This presents gain setting oscillations.  What happens if
+  transients exist after an adjustment is made is that the AGC becomes
+  blind to the actual signal that is being received since the transient
+  can swamp the system.
+
+  Calling Sequence: success = agcInstance_setBlankingLimit(me,blankingLimit)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    blankingLimit - The number of measurements to ignore before making
+    the next gain adjustment.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the blanking limit
+    parameter was updated.  A value of 1 indicates that the blanking
+    limit was updated, and a value of 0 indicates that the parameter
+    was not updated due to an invalid specified blanking limit value.
+
+**************************************************************************/
+int agcInstance_setBlankingLimit(struct agcInstance *me,
+    uint32_t blankingLimit)
+{
+  int success;
+
+  // Default to failure.
+  success = 0;
+
+  if ((blankingLimit >= 0) && (blankingLimit <= 10))
+  {
+    beginConfigurationUpdate(me);
+
+    // Publish the attribute.
+    me->publishedConfig.blankingLimit = blankingLimit;
+
+    // Have the blanking system set to its initial state.
+    me->publishedConfig.blankingResetCount++;
+
+    endConfigurationUpdate(me);
+
+    // Indicate success.
+    success = 1;
+  } // if
+
+  return (success);
+
+} // agcInstance_setBlankingLimit
+
+/**************************************************************************
+
+  Name: agcInstance_setBlankingMode
+
+  Purpose: The purpose of this function is to select how the blanking
+  interval that follows a gain adjustment is measured.  It can either
+  be a number of invocations of the AGC, as set by
+  agcInstance_setBlankingLimit(), or a duration, as set by
+  agcInstance_setBlankingDuration().  A duration matches the settling
+  time of the hardware regardless of how often the AGC is invoked.
+
+  Calling Sequence: success = agcInstance_setBlankingMode(me,mode)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    mode - The blanking mode.  A value of AGC_BLANKING_BY_INVOCATIONS
+    selects the blanking limit, and a value of AGC_BLANKING_BY_DURATION
+    selects the blanking duration.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the blanking mode
+    was updated.  A value of 1 indicates that the mode was updated, and
+    a value of 0 indicates that the mode was invalid.
+
+**************************************************************************/
+int agcInstance_setBlankingMode(struct agcInstance *me,
+    int mode)
+{
+  int success;
+
+  // Default to failure.
+  success = 0;
+
+  if ((mode == AGC_BLANKING_BY_INVOCATIONS) ||
+      (mode == AGC_BLANKING_BY_DURATION))
+  {
+    beginConfigurationUpdate(me);
+
+    // Publish the attribute.
+    me->publishedConfig.blankingMode = mode;
+
+    // Have the blanking system set to its initial state.
+    me->publishedConfig.blankingResetCount++;
+
+    endConfigurationUpdate(me);
+
+    // Indicate success.
+    success = 1;
+  } // if
+
+  return (success);
+
+} // agcInstance_setBlankingMode
+
+/**************************************************************************
+
+  Name: agcInstance_setBlankingDuration
+
+  Purpose: The purpose of this function is to set the time that the AGC
+  waits, after the hardware has been given a new gain, before it makes
+  the next gain adjustment.  The duration is used when the blanking
+  mode is AGC_BLANKING_BY_DURATION.
+
+  Calling Sequence: agcInstance_setBlankingDuration(me,blankingDuration)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    blankingDuration - The blanking duration in ticks.  When the AGC is
+    run by agcInstance_acceptDataAt(), a tick is a unit of the
+    timestamp.  When it is run by the agcInstance_acceptIqBlockXxx()
+    functions, a tick is one complex sample, and when it is run by
+    agcInstance_acceptData(), a tick is one invocation.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_setBlankingDuration(struct agcInstance *me,
+    uint64_t blankingDuration)
+{
+
+  beginConfigurationUpdate(me);
+
+  // Publish the attribute.
+  me->publishedConfig.blankingDuration = blankingDuration;
+
+  // Have the blanking system set to its initial state.
+  me->publishedConfig.blankingResetCount++;
+
+  endConfigurationUpdate(me);
+
+  return;
+
+} // agcInstance_setBlankingDuration
+
+/**************************************************************************
+
+  Name: agcInstance_getAdjustmentLatency
+
+  Purpose: The purpose of this function is to retrieve the measured
+  latency from the hardware being given a gain to the next gain
+  adjustment.  This is the blanking interval plus the time that the AGC
+  took to see a gain error outside the deadband, and it is useful for
+  tuning the blanking duration.  The latency is in ticks (see
+  agcInstance_setBlankingDuration()).  All values are zero until two
+  gain adjustments have been made.
+
+  Calling Sequence: agcInstance_getAdjustmentLatency(me,
+                                                     &lastLatency,
+                                                     &minLatency,
+                                                     &maxLatency)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    lastLatencyPtr - A pointer to storage for the most recent latency.
+
+    minLatencyPtr - A pointer to storage for the smallest latency.
+
+    maxLatencyPtr - A pointer to storage for the largest latency.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_getAdjustmentLatency(struct agcInstance *me,
+    uint64_t *lastLatencyPtr,
+    uint64_t *minLatencyPtr,
+    uint64_t *maxLatencyPtr)
+{
+
+  // Default to no measurements.
+  *lastLatencyPtr = 0;
+  *minLatencyPtr = 0;
+  *maxLatencyPtr = 0;
+
+  if (__atomic_load_n(&me->adjustmentLatencyCount,__ATOMIC_ACQUIRE) != 0)
+  {
+    *lastLatencyPtr =
+      __atomic_load_n(&me->lastAdjustmentLatency,__ATOMIC_RELAXED);
+
+    *minLatencyPtr =
+      __atomic_load_n(&me->minAdjustmentLatency,__ATOMIC_RELAXED);
+
+    *maxLatencyPtr =
+      __atomic_load_n(&me->maxAdjustmentLatency,__ATOMIC_RELAXED);
+  } // if
+
+  return;
+
+} // agcInstance_getAdjustmentLatency
+
+/**************************************************************************
+
+  Name: agcInstance_setOperatingPoint
+
+  Purpose: The purpose of this function is to set the operating point
+  of the AGC.
+
+  Calling Sequence: agcInstance_setOperatingPoint(me,operatingPointInDbFs)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    operatingPointInDbFs - The operating point in decibels referenced to
+    the full scale value.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_setOperatingPoint(struct agcInstance *me,
+    int32_t operatingPointInDbFs)
+{
+
+  // Publish the operating point.
+  beginConfigurationUpdate(me);
+  me->publishedConfig.operatingPointInDbFs = operatingPointInDbFs;
+  endConfigurationUpdate(me);
+
+  return;
+
+} // agcInstance_setOperatingPoint
+
+/**************************************************************************
+
+  Name: agcInstance_setAgcFilterCoefficient
+
+  Purpose: The purpose of this function is to set the coefficient of
+  the first order lowpass filter that filters the baseband gain value.
+  In effect, the time constant of the filter is set.
+
+  Calling Sequence: success = agcInstance_setAgcFilterCoefficient(me,coefficient)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    coefficient - The filter coefficient for the lowpass filter that
+    filters the baseband gain value.
+
+  Outputs:
+
+    success - A flag that indicates whether the filter coefficient was
+    updated.  A value of 1 indicates that the coefficient was
+    updated, and a value of 0 indicates that the coefficient was
+    not updated due to an invalid coefficient value.
+
+**************************************************************************/
+int agcInstance_setAgcFilterCoefficient(struct agcInstance *me,
+    float coefficient)
+{
+  int success;
+
+  // Default to failure.
+  success = 0;
+
+  if ((coefficient >= 0.001) && (coefficient < 0.999))
+  {
+    // Publish the attribute.
+    beginConfigurationUpdate(me);
+    me->publishedConfig.alpha =
+      agcControlLaw_coefficientFromFloat(coefficient);
+    endConfigurationUpdate(me);
+
+    // Indicate success.
+    success = 1;
+  } // if
+
+  return (success);
+
+} // agcInstance_setAgcFilterCoefficient
+
+/**************************************************************************
+
+  Name: agcInstance_enable
+
+  Purpose: The purpose of this function is to enable the AGC.
+
+  Calling Sequence: success = agcInstance_enable(me);
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the operation was
+    successful.  A value of 1 indicates that the operation was
+    successful, and a value of 0 indicates that, eitherthe AGC
+    was already enabled, or the radio was not in a receiving state.
+
+**************************************************************************/
+int agcInstance_enable(struct agcInstance *me)
+{
+  int success;
+
+ // Default to failure.
+  success = 0;
+
+  beginConfigurationUpdate(me);
+
+  if (!me->publishedConfig.enabled)
+  {
+    // Have the system set to an initial state.
+    me->publishedConfig.blankingResetCount++;
+
+    // Enable the AGC.
+    me->publishedConfig.enabled = 1;
+
+    // Indicate success.
+    success = 1;
+  } // if
+
+  endConfigurationUpdate(me);
+
+  return (success);
+
+} // agcInstance_enable
+
+/**************************************************************************
+
+  Name: agcInstance_disable
+
+  Purpose: The purpose of this function is to disable the AGC.
+
+  Calling Sequence: success = agcInstance_disable(me);
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the operation was
+    successful.  A value of 1 indicates that the operation was
+    successful, and a value of 0 indicates that the AGC was already
+    disabled.
+
+**************************************************************************/
+int agcInstance_disable(struct agcInstance *me)
+{
+  int success;
+
+ // Default to failure.
+  success = 0;
+
+  beginConfigurationUpdate(me);
+
+  if (me->publishedConfig.enabled)
+  {
+    // Disable the AGC.
+    me->publishedConfig.enabled = 0;
+
+    success = 1;
+  } // if
+
+  endConfigurationUpdate(me);
+
+  return (success);
+
+} // agcInstance_disable
+
+/**************************************************************************
+
+  Name: agcInstance_isEnabled
+
+  Purpose: The purpose of this function is to determine whether or not
+  the AGC is enabled.
+
+  Calling Sequence: status = agcInstance_isEnabled(me)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the AGC is enabled.
+    A value of 1 indicates that the AGC is enabled, and a value of
+    0 indicates that the AGC is disabled.
+
+**************************************************************************/
+int agcInstance_isEnabled(struct agcInstance *me)
+{
+  int enabled;
+
+  pthread_mutex_lock(&me->configLock);
+  enabled = me->publishedConfig.enabled;
+  pthread_mutex_unlock(&me->configLock);
+
+  return (enabled);
+
+} // agcInstance_isEnabled
+
+/**************************************************************************
+
+  Name: agcInstance_setGainSyncMode
+
+  Purpose: The purpose of this function is to select how the AGC learns
+  about gain changes that were made by some other entity.  In the poll
+  mode, the get gain callback is invoked every time that the AGC runs.
+  In the notify mode, the callback is never invoked, and the
+  application calls agcInstance_notifyExternalGainChange() whenever it
+  changes the gain.
+
+  Calling Sequence: success = agcInstance_setGainSyncMode(me,mode)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    mode - The gain synchronization mode.  A value of AGC_GAIN_SYNC_POLL
+    selects the poll mode, and a value of AGC_GAIN_SYNC_NOTIFY selects
+    the notify mode.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the mode was
+    updated.  A value of 1 indicates that the mode was updated, and a
+    value of 0 indicates that the mode was invalid.
+
+**************************************************************************/
+int agcInstance_setGainSyncMode(struct agcInstance *me,
+    int mode)
+{
+  int success;
+
+  // Default to failure.
+  success = 0;
+
+  if ((mode == AGC_GAIN_SYNC_POLL) || (mode == AGC_GAIN_SYNC_NOTIFY))
+  {
+    // Publish the attribute.
+    beginConfigurationUpdate(me);
+    me->publishedConfig.gainSyncMode = mode;
+    endConfigurationUpdate(me);
+
+    // Indicate success.
+    success = 1;
+  } // if
+
+  return (success);
+
+} // agcInstance_setGainSyncMode
+
+/**************************************************************************
+
+  Name: agcInstance_notifyExternalGainChange
+
+  Purpose: The purpose of this function is to tell the AGC that the
+  gain of the amplifier was changed by some entity other than the AGC.
+  The AGC picks up the new gain the next time that it runs.  This is
+  only used in the notify gain synchronization mode, and it may be
+  called from any thread.
+
+  Calling Sequence: agcInstance_notifyExternalGainChange(me,gainInDb)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    gainInDb - The gain, in decibels, that the amplifier now has.  Gains
+    that exceed the maximum amplifier gain are ignored.  With a gain
+    table, this is the index of the step instead.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_notifyExternalGainChange(struct agcInstance *me,
+    uint32_t gainInDb)
+{
+  uint64_t change;
+  uint32_t generation;
+
+  // Notifiers are serialized so that every change gets its own number.
+  pthread_mutex_lock(&me->configLock);
+
+  change = __atomic_load_n(&me->externalGainChange,__ATOMIC_RELAXED);
+  generation = (uint32_t)(change >> 32) + 1;
+
+  change = ((uint64_t)generation << 32) | gainInDb;
+
+  // The gain and its generation number are published together.
+  __atomic_store_n(&me->externalGainChange,change,__ATOMIC_RELEASE);
+
+  pthread_mutex_unlock(&me->configLock);
+
+  return;
+
+} // agcInstance_notifyExternalGainChange
+
+/**************************************************************************
+
+  Name: agcInstance_startGainActuator
+
+  Purpose: The purpose of this function is to start the gain actuator
+  thread.  While the actuator is running, the AGC does not invoke the
+  set gain callback from the thread that runs the AGC.  Instead, the
+  new gain is posted to a single-slot mailbox, and the actuator thread
+  invokes the callback with the most recent gain.  A gain that is
+  replaced before the actuator gets to it is never written.  This is
+  useful when setting the gain is slow, for example, a USB control
+  transfer to an rtl-sdr.  Note that the callback is invoked by the
+  actuator thread.  The thread is created without the configuration
+  lock held, so the callback may invoke the other agcInstance_xxx()
+  functions.
+
+  Calling Sequence: success = agcInstance_startGainActuator(me)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the actuator was
+    started.  A value of 1 indicates that the actuator was started, and
+    a value of 0 indicates that the actuator was already running, or
+    that the thread could not be created.
+
+**************************************************************************/
+int agcInstance_startGainActuator(struct agcInstance *me)
+{
+  int success;
+  int claimed;
+
+  // Default to failure.
+  success = 0;
+  claimed = 0;
+
+  pthread_mutex_lock(&me->configLock);
+
+  // Only one control thread at a time may start or stop the actuator.
+  if ((!me->publishedConfig.gainActuatorEnabled) && (!me->actuatorBusy))
+  {
+    me->actuatorBusy = 1;
+    claimed = 1;
+
+    if (!me->actuatorSemaphoreCreated)
+    {
+      // The sample thread may post to the semaphore at any time.
+      me->actuatorSemaphoreCreated =
+        (sem_init(&me->actuatorSemaphore,0,0) == 0);
+    } // if
+  } // if
+
+  pthread_mutex_unlock(&me->configLock);
+
+  if (claimed)
+  {
+    if (me->actuatorSemaphoreCreated)
+    {
+      // Make sure that the first gain is written.
+      me->actuatorGainInDb = 0xffffffff;
+      me->actuatorStopRequested = 0;
+
+      if (pthread_create(&me->actuatorThread,
+                         NULL,
+                         runGainActuator,
+                         me) == 0)
+      {
+        // Indicate success.
+        success = 1;
+      } // if
+    } // if
+
+    beginConfigurationUpdate(me);
+
+    if (success)
+    {
+      // Let the sample thread know.
+      me->publishedConfig.gainActuatorEnabled = 1;
+    } // if
+
+    me->actuatorBusy = 0;
+
+    endConfigurationUpdate(me);
+  } // if
+
+  return (success);
+
+} // agcInstance_startGainActuator
+
+/**************************************************************************
+
+  Name: agcInstance_stopGainActuator
+
+  Purpose: The purpose of this function is to stop the gain actuator
+  thread.  A gain that is pending when the actuator is stopped is still
+  written to the hardware.  Afterwards, the AGC invokes the set gain
+  callback directly.  The configuration lock is not held while the
+  thread finishes its last hardware write, so the callback may invoke
+  the other agcInstance_xxx() functions, and other control threads are
+  not stalled.
+
+  Calling Sequence: success = agcInstance_stopGainActuator(me)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the actuator was
+    stopped.  A value of 1 indicates that the actuator was stopped, and
+    a value of 0 indicates that the actuator was not running.
+
+**************************************************************************/
+int agcInstance_stopGainActuator(struct agcInstance *me)
+{
+  int success;
+
+  // Default to failure.
+  success = 0;
+
+  pthread_mutex_lock(&me->configLock);
+
+  // Only one control thread at a time may start or stop the actuator.
+  if ((me->publishedConfig.gainActuatorEnabled) && (!me->actuatorBusy))
+  {
+    me->actuatorBusy = 1;
+    success = 1;
+  } // if
+
+  pthread_mutex_unlock(&me->configLock);
+
+  if (success)
+  {
+    // Tell the actuator thread to exit, and wake it up.
+    __atomic_store_n(&me->actuatorStopRequested,1,__ATOMIC_RELEASE);
+    sem_post(&me->actuatorSemaphore);
+
+    pthread_join(me->actuatorThread,NULL);
+
+    beginConfigurationUpdate(me);
+
+    //+++++++++++++++++++++++++++++++++++++++++++++++++++
+    // The sample thread sees this once the actuator
+    // thread is gone, and it takes care of any request
+    // that was posted in the meantime.
+    //+++++++++++++++++++++++++++++++++++++++++++++++++++
+    me->publishedConfig.gainActuatorEnabled = 0;
+    me->actuatorBusy = 0;
+
+    endConfigurationUpdate(me);
+  } // if
+
+  return (success);
+
+} // agcInstance_stopGainActuator
+
+/**************************************************************************
+
+  Name: agcInstance_getGainActuatorCounts
+
+  Purpose: The purpose of this function is to retrieve the counters of
+  the gain actuator.  The counters are cumulative over the lifetime of
+  the instance.
+
+  Calling Sequence: agcInstance_getGainActuatorCounts(me,
+                                                      &appliedCount,
+                                                      &coalescedCount,
+                                                      &droppedCount)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    appliedCountPtr - A pointer to storage for the number of gains that
+    were written to the hardware.
+
+    coalescedCountPtr - A pointer to storage for the number of gains
+    that were replaced by a newer gain before they were written.
+
+    droppedCountPtr - A pointer to storage for the number of gains that
+    were not written because the hardware already had that gain.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_getGainActuatorCounts(struct agcInstance *me,
+    uint32_t *appliedCountPtr,
+    uint32_t *coalescedCountPtr,
+    uint32_t *droppedCountPtr)
+{
+
+  *appliedCountPtr =
+    __atomic_load_n(&me->appliedGainWriteCount,__ATOMIC_RELAXED);
+
+  *coalescedCountPtr =
+    __atomic_load_n(&me->coalescedGainWriteCount,__ATOMIC_RELAXED);
+
+  *droppedCountPtr =
+    __atomic_load_n(&me->droppedGainWriteCount,__ATOMIC_RELAXED);
+
+  return;
+
+} // agcInstance_getGainActuatorCounts
+
+/**************************************************************************
+
+  Name: agcInstance_getStats
+
+  Purpose: The purpose of this function is to retrieve a consistent
+  snapshot of the configuration, the loop state and the counters of the
+  AGC.  The sample thread is never blocked: if it publishes new
+  statistics while they are being copied, the copy is simply repeated.
+  The configuration is the one that was most recently set, and the loop
+  state and the counters are those at the end of the most recent
+  invocation of the AGC.
+
+  Calling Sequence: agcInstance_getStats(me,&stats)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    statsPtr - A pointer to storage for the statistics.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_getStats(struct agcInstance *me,
+    struct agcStats *statsPtr)
+{
+  uint32_t sequence;
+  struct agcConfiguration config;
+  struct agcLoopStats loopStats;
+
+  // Retrieve the configuration that was most recently published.
+  pthread_mutex_lock(&me->configLock);
+  config = me->publishedConfig;
+  pthread_mutex_unlock(&me->configLock);
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Copy the loop statistics, and retry if the sample thread
+  // published new ones in the meantime.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  do
+  {
+    sequence = __atomic_load_n(&me->statsSequence,__ATOMIC_ACQUIRE);
+
+    loopStats = me->publishedStats;
+
+    // The copy must complete before the sequence is checked again.
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  } while ((sequence & 1) ||
+           (sequence != __atomic_load_n(&me->statsSequence,
+                                        __ATOMIC_RELAXED)));
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  statsPtr->enabled = config.enabled;
+  statsPtr->blankingLimit = config.blankingLimit;
+  statsPtr->filterCoefficient = agcControlLaw_coefficientToFloat(config.alpha);
+  statsPtr->deadbandInDb = config.deadbandInDb;
+  statsPtr->operatingPointInDbFs = config.operatingPointInDbFs;
+  statsPtr->maxAmplifierGainInDb = me->maxAmplifierGainInDb;
+
+  statsPtr->blankingCounter = loopStats.blankingCounter;
+  statsPtr->gainInDb = loopStats.gainInDb;
+  statsPtr->signalMagnitude = loopStats.signalMagnitude;
+  statsPtr->signalInDbFs = loopStats.signalInDbFs;
+  statsPtr->normalizedSignalLevelInDbFs =
+    loopStats.normalizedSignalLevelInDbFs;
+
+  statsPtr->invocationCount = loopStats.counters.invocationCount;
+  statsPtr->blankedCount = loopStats.counters.blankedCount;
+  statsPtr->deadbandSuppressionCount =
+    loopStats.counters.deadbandSuppressionCount;
+  statsPtr->minGainClampCount = loopStats.counters.minGainClampCount;
+  statsPtr->maxGainClampCount = loopStats.counters.maxGainClampCount;
+  statsPtr->gainWriteCount = loopStats.counters.gainWriteCount;
+
+  statsPtr->overloadBlockCount = loopStats.counters.overloadBlockCount;
+  statsPtr->overloadEventCount = loopStats.counters.overloadEventCount;
+  statsPtr->lastOverloadDuration = loopStats.lastOverloadDuration;
+  statsPtr->longestOverloadDuration = loopStats.longestOverloadDuration;
+  statsPtr->lastOverloadClippedCount = loopStats.lastOverloadClippedCount;
+
+  return;
+
+} // agcInstance_getStats
+
+/**************************************************************************
+
+  Name: agcInstance_getLatencyReport
+
+  Purpose: The purpose of this function is to retrieve one of the
+  latency histograms of the AGC, along with its maximum, its 99th
+  percentile, and the number of latencies that exceeded its budget.
+  The invocation histogram covers each call to the
+  agcInstance_acceptXxx() functions, and the callback histograms cover
+  each invocation of the set gain and get gain callbacks.  Latencies are
+  only measured when the library is built with AGC_INSTRUMENTATION
+  defined.
+
+  Calling Sequence: success = agcInstance_getLatencyReport(me,
+                                                           histogram,
+                                                           &report)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    histogram - The histogram of interest.  Valid values are
+    AGC_LATENCY_INVOCATION, AGC_LATENCY_SET_GAIN_CALLBACK, and
+    AGC_LATENCY_GET_GAIN_CALLBACK.
+
+    reportPtr - A pointer to storage for the report.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the report was
+    retrieved.  A value of 1 indicates that the report was retrieved,
+    and a value of 0 indicates that the histogram is invalid, or that
+    the library was built without instrumentation.
+
+**************************************************************************/
+int agcInstance_getLatencyReport(struct agcInstance *me,
+    int histogram,
+    struct agcLatencyReport *reportPtr)
+{
+  int success;
+
+  // Default to failure.
+  success = 0;
+
+#ifdef AGC_INSTRUMENTATION
+  if ((histogram >= 0) && (histogram < AGC_LATENCY_HISTOGRAM_COUNT))
+  {
+    agcLatencyHistogram_getReport(&me->latency[histogram],reportPtr);
+
+    // Indicate success.
+    success = 1;
+  } // if
+#else
+  // Without instrumentation, there is no histogram to report.
+  (void)me;
+  (void)histogram;
+  (void)reportPtr;
+#endif
+
+  return (success);
+
+} // agcInstance_getLatencyReport
+
+/**************************************************************************
+
+  Name: agcInstance_setLatencyBudget
+
+  Purpose: The purpose of this function is to set the latency budget of
+  one of the latency histograms of the AGC.  Latencies that exceed the
+  budget are counted as overruns, which makes it easy to spot a
+  callback that occasionally blocks.
+
+  Calling Sequence: success = agcInstance_setLatencyBudget(me,
+                                                           histogram,
+                                                           budgetInNs)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    histogram - The histogram of interest.  See
+    agcInstance_getLatencyReport() for valid values.
+
+    budgetInNs - The budget in nanoseconds.  A value of 0 disables
+    overrun counting.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the budget was
+    updated.  A value of 1 indicates that the budget was updated, and a
+    value of 0 indicates that the histogram is invalid, or that the
+    library was built without instrumentation.
+
+**************************************************************************/
+int agcInstance_setLatencyBudget(struct agcInstance *me,
+    int histogram,
+    uint64_t budgetInNs)
+{
+  int success;
+
+  // Default to failure.
+  success = 0;
+
+#ifdef AGC_INSTRUMENTATION
+  if ((histogram >= 0) && (histogram < AGC_LATENCY_HISTOGRAM_COUNT))
+  {
+    agcLatencyHistogram_setBudget(&me->latency[histogram],budgetInNs);
+
+    // Indicate success.
+    success = 1;
+  } // if
+#else
+  // Without instrumentation, there is no histogram to budget.
+  (void)me;
+  (void)histogram;
+  (void)budgetInNs;
+#endif
+
+  return (success);
+
+} // agcInstance_setLatencyBudget
+
+/**************************************************************************
+
+  Name: agcInstance_setTraceRecorder
+
+  Purpose: The purpose of this function is to attach a trace recorder
+  to an AGC instance, or to detach it.  While a recorder is attached,
+  the AGC adds one record to it on every invocation.  A recorder may
+  only be attached to one AGC at a time.  Before a recorder is
+  destroyed, it must be detached, and the AGC must have been invoked
+  at least once since then (or no longer be invoked), so that the
+  sample thread is known to be done with it.
+
+  Calling Sequence: agcInstance_setTraceRecorder(me,recorderPtr)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    recorderPtr - A pointer to the recorder.  A value of NULL detaches
+    the current recorder.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_setTraceRecorder(struct agcInstance *me,
+    struct agcTraceRecorder *recorderPtr)
+{
+
+  // Publish the recorder.
+  beginConfigurationUpdate(me);
+  me->publishedConfig.traceRecorderPtr = recorderPtr;
+  endConfigurationUpdate(me);
+
+  return;
+
+} // agcInstance_setTraceRecorder
+
+/**************************************************************************
+
+  Name: agcInstance_displayInternalInformation
+
+  Purpose: The purpose of this function is to display information in the
+  AGC.  rather than actually display this information, the formatted
+  indormation is printed to a string so that the client software can
+  display the information is it sees fit.  This way, the AGC focuses on
+  perofming its main function rather than printing information.  in
+  general, this information provides a glass box view of the AGC that is
+  useful for system level debugging.  The information is taken from
+  agcInstance_getStats(), which is the better choice for programs that
+  monitor the AGC.
+
+  Calling Sequence: agcInstance_displayInternalInformation(me,&displayBuffer)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    displayBuffer - A pointer to a pointer to a display buffer provided
+    by the caller.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcInstance_displayInternalInformation(struct agcInstance *me,
+    char **displayBufferPtrPtr)
+{
+  char *p;;
+  int n;
+  struct agcStats stats;
+
+  // Reference caller's display buffer.
+  p = *displayBufferPtrPtr;
+
+  // Work from a consistent snapshot.
+  agcInstance_getStats(me,&stats);
+
+  n = sprintf(p,"\n--------------------------------------------\n");
+  p += n;
+
+  n = sprintf(p,"AGC Internal Information\n");
+  p += n;
+
+  n = sprintf(p,"--------------------------------------------\n");
+  p += n;
+
+  if (stats.enabled)
+  {
+    n = sprintf(p,"AGC Emabled                : Yes\n");
+    p += n;
+  } // if
+  else
+  {
+    n = sprintf(p,"AGC Emabled                : No\n");
+    p += n;
+  } // else
+
+  n = sprintf(p,"Blanking Counter           : %u ticks\n",
+          stats.blankingCounter);
+  p += n;
+
+  n = sprintf(p,"Blanking Limit             : %u ticks\n",
+          stats.blankingLimit);
+  p += n;
+
+  n = sprintf(p,"Lowpass Filter Coefficient : %0.3f\n",
+          stats.filterCoefficient);
+  p += n;
+
+  n = sprintf(p,"Deadband                   : %u dB\n",
+          stats.deadbandInDb);
+  p += n;
+
+  n = sprintf(p,"Operating Point            : %d dBFs\n",
+          stats.operatingPointInDbFs);
+  p += n;
+
+  n = sprintf(p,"Maximum Amplifier Gain     : %u dB\n",
+          stats.maxAmplifierGainInDb);
+  p += n;
+
+  n = sprintf(p,"Gain                       : %u dB\n",
+          stats.gainInDb);
+  p += n;
+
+  n = sprintf(p,"/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/\n");
+  p += n;
+
+  n = sprintf(p,"Signal Magnitude           : %u\n",
+          stats.signalMagnitude);
+  p += n;
+
+  n = sprintf(p,"RSSI (Before Amp)          : %d dBFs\n",
+          stats.normalizedSignalLevelInDbFs);
+  p += n;
+
+  n = sprintf(p,"/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/\n");
+  p += n;
+
+  // Terminate string.
+  *p = 0;
+
+  return;
+
+} // agcInstance_displayInternalInformation
+
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// Default instance functions.  These functions preserve the
+// original single-AGC interface by operating on a default
+// instance.  See the agcInstance_xxx() counterparts for the
+// description of the parameters.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+/**************************************************************************
+
+  Name: agc_init
+
+  Purpose: The purpose of this function is to invoke agcInstance_init()
+  on the default AGC instance.  The callbacks are saved, and adapters
+  that invoke them are registered in their place.
+
+**************************************************************************/
+int agc_init(int32_t operatingPointInDbFs,
+    uint32_t maxAmplifierGainInDb,
+    uint32_t signalMagnitudeBitCount,
+    void (*setGainCallbackPtr)(uint32_t gainIndB),
+    uint32_t (*getGainCallbackPtr)(void))
+{
+  void (*setAdapterPtr)(void *contextPtr,uint32_t gainIndB);
+  uint32_t (*getAdapterPtr)(void *contextPtr);
+
+  defaultCallbacks.setGainCallbackPtr = setGainCallbackPtr;
+  defaultCallbacks.getGainCallbackPtr = getGainCallbackPtr;
+
+  // A missing callback stays missing.
+  setAdapterPtr = NULL;
+  getAdapterPtr = NULL;
+
+  if (setGainCallbackPtr != NULL)
+  {
+    setAdapterPtr = setDefaultGain;
+  } // if
+
+  if (getGainCallbackPtr != NULL)
+  {
+    getAdapterPtr = getDefaultGain;
+  } // if
+
+  return (agcInstance_init(&defaultInstance,
+                           operatingPointInDbFs,
+                           maxAmplifierGainInDb,
+                           signalMagnitudeBitCount,
+                           setAdapterPtr,
+                           getAdapterPtr,
+                           &defaultCallbacks));
+
+} // agc_init
+
+/**************************************************************************
+
+  Name: agc_initWithGainSteps
+
+  Purpose: The purpose of this function is to invoke
+  agcInstance_initWithGainSteps() on the default AGC instance.
+
+**************************************************************************/
+int agc_initWithGainSteps(int32_t operatingPointInDbFs,
+    const uint32_t *gainStepInDbPtr,
+    uint32_t gainStepCount,
+    uint32_t signalMagnitudeBitCount,
+    void (*setGainStepCallbackPtr)(uint32_t gainStep),
+    uint32_t (*getGainStepCallbackPtr)(void))
+{
+  void (*setAdapterPtr)(void *contextPtr,uint32_t gainStep);
+  uint32_t (*getAdapterPtr)(void *contextPtr);
+
+  // The step callbacks have the same form as the gain callbacks.
+  defaultCallbacks.setGainCallbackPtr = setGainStepCallbackPtr;
+  defaultCallbacks.getGainCallbackPtr = getGainStepCallbackPtr;
+
+  setAdapterPtr = NULL;
+  getAdapterPtr = NULL;
+
+  if (setGainStepCallbackPtr != NULL)
+  {
+    setAdapterPtr = setDefaultGain;
+  } // if
+
+  if (getGainStepCallbackPtr != NULL)
+  {
+    getAdapterPtr = getDefaultGain;
+  } // if
+
+  return (agcInstance_initWithGainSteps(&defaultInstance,
+                                        operatingPointInDbFs,
+                                        gainStepInDbPtr,
+                                        gainStepCount,
+                                        signalMagnitudeBitCount,
+                                        setAdapterPtr,
+                                        getAdapterPtr,
+                                        &defaultCallbacks));
+
+} // agc_initWithGainSteps
+
+/**************************************************************************
+
+  Name: agc_initWithGainStages
+
+  Purpose: The purpose of this function is to invoke
+  agcInstance_initWithGainStages() on the default AGC instance.
+
+**************************************************************************/
+int agc_initWithGainStages(int32_t operatingPointInDbFs,
+    const struct agcGainStage *stagePtr,
+    uint32_t stageCount,
+    int policy,
+    uint32_t signalMagnitudeBitCount,
+    void (*setStageGainsCallbackPtr)(const uint32_t *stageGainInDbPtr),
+    void (*getStageGainsCallbackPtr)(uint32_t *stageGainInDbPtr))
+{
+  void (*setAdapterPtr)(void *contextPtr,const uint32_t *stageGainInDbPtr);
+  void (*getAdapterPtr)(void *contextPtr,uint32_t *stageGainInDbPtr);
+
+  defaultCallbacks.setStageGainsCallbackPtr = setStageGainsCallbackPtr;
+  defaultCallbacks.getStageGainsCallbackPtr = getStageGainsCallbackPtr;
+
+  setAdapterPtr = NULL;
+  getAdapterPtr = NULL;
+
+  if (setStageGainsCallbackPtr != NULL)
+  {
+    setAdapterPtr = setDefaultStageGains;
+  } // if
+
+  if (getStageGainsCallbackPtr != NULL)
+  {
+    getAdapterPtr = getDefaultStageGains;
+  } // if
+
+  return (agcInstance_initWithGainStages(&defaultInstance,
+                                         operatingPointInDbFs,
+                                         stagePtr,
+                                         stageCount,
+                                         policy,
+                                         signalMagnitudeBitCount,
+                                         setAdapterPtr,
+                                         getAdapterPtr,
+                                         &defaultCallbacks));
+
+} // agc_initWithGainStages
+
+/**************************************************************************
+
+  Name: agc_setDeadband
+
+  Purpose: The purpose of this function is to invoke agcInstance_setDeadband()
+  on the default AGC instance.
+
+**************************************************************************/
+int agc_setDeadband(uint32_t deadbandInDb)
+{
+
+  return (agcInstance_setDeadband(&defaultInstance,deadbandInDb));
+
+} // agc_setDeadband
+
+/**************************************************************************
+
+  Name: agc_setBlankingLimit
+
+  Purpose: The purpose of this function is to invoke agcInstance_setBlankingLimit()
+  on the default AGC instance.
+
+**************************************************************************/
+int agc_setBlankingLimit(uint32_t blankingLimit)
+{
+
+  return (agcInstance_setBlankingLimit(&defaultInstance,blankingLimit));
+
+} // agc_setBlankingLimit
+
+/**************************************************************************
+
+  Name: agc_setBlankingMode
+
+  Purpose: The purpose of this function is to invoke agcInstance_setBlankingMode()
+  on the default AGC instance.
+
+**************************************************************************/
+int agc_setBlankingMode(int mode)
+{
+
+  return (agcInstance_setBlankingMode(&defaultInstance,mode));
+
+} // agc_setBlankingMode
+
+/**************************************************************************
+
+  Name: agc_setBlankingDuration
+
+  Purpose: The purpose of this function is to invoke agcInstance_setBlankingDuration()
+  on the default AGC instance.
+
+**************************************************************************/
+void agc_setBlankingDuration(uint64_t blankingDuration)
+{
+
+  agcInstance_setBlankingDuration(&defaultInstance,blankingDuration);
+
+  return;
+
+} // agc_setBlankingDuration
+
+/**************************************************************************
+
+  Name: agc_getAdjustmentLatency
+
+  Purpose: The purpose of this function is to invoke agcInstance_getAdjustmentLatency()
+  on the default AGC instance.
+
+**************************************************************************/
+void agc_getAdjustmentLatency(uint64_t *lastLatencyPtr,
+    uint64_t *minLatencyPtr,
+    uint64_t *maxLatencyPtr)
+{
+
+  agcInstance_getAdjustmentLatency(&defaultInstance,
+                                   lastLatencyPtr,
+                                   minLatencyPtr,
+                                   maxLatencyPtr);
+
+  return;
+
+} // agc_getAdjustmentLatency
+
+/**************************************************************************
+
+  Name: agc_setOperatingPoint
+
+  Purpose: The purpose of this function is to invoke agcInstance_setOperatingPoint()
+  on the default AGC instance.
+
+**************************************************************************/
+void agc_setOperatingPoint(int32_t operatingPointInDbFs)
+{
+
+  agcInstance_setOperatingPoint(&defaultInstance,operatingPointInDbFs);
+
+  return;
+
+} // agc_setOperatingPoint
+
+/**************************************************************************
+
+  Name: agc_setAgcFilterCoefficient
+
+  Purpose: The purpose of this function is to invoke agcInstance_setAgcFilterCoefficient()
+  on the default AGC instance.
+
+**************************************************************************/
+int agc_setAgcFilterCoefficient(float coefficient)
+{
+
+  return (agcInstance_setAgcFilterCoefficient(&defaultInstance,coefficient));
+
+} // agc_setAgcFilterCoefficient
+
+/**************************************************************************
+
+  Name: agc_enable
+
+  Purpose: The purpose of this function is to invoke agcInstance_enable()
+  on the default AGC instance.
+
+**************************************************************************/
+int agc_enable(void)
+{
+
+  return (agcInstance_enable(&defaultInstance));
+
+} // agc_enable
+
+/**************************************************************************
+
+  Name: agc_disable
+
+  Purpose: The purpose of this function is to invoke agcInstance_disable()
+  on the default AGC instance.
+
+**************************************************************************/
+int agc_disable(void)
+{
+
+  return (agcInstance_disable(&defaultInstance));
+
+} // agc_disable
+
+/**************************************************************************
+
+  Name: agc_isEnabled
+
+  Purpose: The purpose of this function is to invoke agcInstance_isEnabled()
+  on the default AGC instance.
+
+**************************************************************************/
+int agc_isEnabled(void)
+{
+
+  return (agcInstance_isEnabled(&defaultInstance));
+
+} // agc_isEnabled
+
+/**************************************************************************
+
+  Name: agc_acceptData
+
+  Purpose: The purpose of this function is to invoke agcInstance_acceptData()
+  on the default AGC instance.
+
+**************************************************************************/
+void agc_acceptData(uint32_t signalMagnitude)
+{
+
+  agcInstance_acceptData(&defaultInstance,signalMagnitude);
+
+  return;
+
+} // agc_acceptData
+
+/**************************************************************************
+
+  Name: agc_acceptDataAt
+
+  Purpose: The purpose of this function is to invoke agcInstance_acceptDataAt()
+  on the default AGC instance.
+
+**************************************************************************/
+void agc_acceptDataAt(uint32_t signalMagnitude,uint64_t timestamp)
+{
+
+  agcInstance_acceptDataAt(&defaultInstance,signalMagnitude,timestamp);
+
+  return;
+
+} // agc_acceptDataAt
+
+/**************************************************************************
+
+  Name: agc_acceptIqBlockU8
+
+  Purpose: The purpose of this function is to invoke
+  agcInstance_acceptIqBlockU8() on the default AGC instance.
+
+**************************************************************************/
+void agc_acceptIqBlockU8(const uint8_t *iqPtr,uint32_t sampleCount)
+{
+
+  agcInstance_acceptIqBlockU8(&defaultInstance,iqPtr,sampleCount);
+
+  return;
+
+} // agc_acceptIqBlockU8
+
+/**************************************************************************
+
+  Name: agc_acceptIqBlockS8
+
+  Purpose: The purpose of this function is to invoke
+  agcInstance_acceptIqBlockS8() on the default AGC instance.
+
+**************************************************************************/
+void agc_acceptIqBlockS8(const int8_t *iqPtr,uint32_t sampleCount)
+{
+
+  agcInstance_acceptIqBlockS8(&defaultInstance,iqPtr,sampleCount);
+
+  return;
+
+} // agc_acceptIqBlockS8
+
+/**************************************************************************
+
+  Name: agc_acceptIqBlockS16
+
+  Purpose: The purpose of this function is to invoke
+  agcInstance_acceptIqBlockS16() on the default AGC instance.
+
+**************************************************************************/
+void agc_acceptIqBlockS16(const int16_t *iqPtr,uint32_t sampleCount)
+{
+
+  agcInstance_acceptIqBlockS16(&defaultInstance,iqPtr,sampleCount);
+
+  return;
+
+} // agc_acceptIqBlockS16
+
+/**************************************************************************
+
+  Name: agc_acceptMagnitudeBlock
+
+  Purpose: The purpose of this function is to invoke
+  agcInstance_acceptMagnitudeBlock() on the default AGC instance.
+
+**************************************************************************/
+void agc_acceptMagnitudeBlock(const uint32_t *signalMagnitudePtr,
+    uint32_t count)
+{
+
+  agcInstance_acceptMagnitudeBlock(&defaultInstance,
+                                   signalMagnitudePtr,
+                                   count);
+
+  return;
+
+} // agc_acceptMagnitudeBlock
+
+/**************************************************************************
+
+  Name: agc_applyResidualGainS8
+
+  Purpose: The purpose of this function is to invoke
+  agcInstance_applyResidualGainS8() on the default AGC instance.
+
+**************************************************************************/
+void agc_applyResidualGainS8(int8_t *iqPtr,uint32_t sampleCount)
+{
+
+  agcInstance_applyResidualGainS8(&defaultInstance,iqPtr,sampleCount);
+
+  return;
+
+} // agc_applyResidualGainS8
+
+/**************************************************************************
+
+  Name: agc_applyResidualGainS16
+
+  Purpose: The purpose of this function is to invoke
+  agcInstance_applyResidualGainS16() on the default AGC instance.
+
+**************************************************************************/
+void agc_applyResidualGainS16(int16_t *iqPtr,uint32_t sampleCount)
+{
+
+  agcInstance_applyResidualGainS16(&defaultInstance,iqPtr,sampleCount);
+
+  return;
+
+} // agc_applyResidualGainS16
+
+/**************************************************************************
+
+  Name: agc_applyResidualGainF32
+
+  Purpose: The purpose of this function is to invoke
+  agcInstance_applyResidualGainF32() on the default AGC instance.
+
+**************************************************************************/
+void agc_applyResidualGainF32(float *iqPtr,uint32_t sampleCount)
+{
+
+  agcInstance_applyResidualGainF32(&defaultInstance,iqPtr,sampleCount);
+
+  return;
+
+} // agc_applyResidualGainF32
+
+/**************************************************************************
+
+  Name: agc_setMagnitudeEstimator
+
+  Purpose: The purpose of this function is to invoke
+  agcInstance_setMagnitudeEstimator() on the default AGC instance.
+
+**************************************************************************/
+int agc_setMagnitudeEstimator(int estimator)
+{
+
+  return (agcInstance_setMagnitudeEstimator(&defaultInstance,estimator));
+
+} // agc_setMagnitudeEstimator
+
+/**************************************************************************
+
+  Name: agc_setDetector
+
+  Purpose: The purpose of this function is to invoke
+  agcInstance_setDetector() on the default AGC instance.
+
+**************************************************************************/
+int agc_setDetector(int mode,uint32_t windowLength)
+{
+
+  return (agcInstance_setDetector(&defaultInstance,mode,windowLength));
+
+} // agc_setDetector
+
+/**************************************************************************
+
+  Name: agc_setDetectorSmoothing
+
+  Purpose: The purpose of this function is to invoke
+  agcInstance_setDetectorSmoothing() on the default AGC instance.
+
+**************************************************************************/
+int agc_setDetectorSmoothing(float attack,float decay)
+{
+
+  return (agcInstance_setDetectorSmoothing(&defaultInstance,attack,decay));
+
+} // agc_setDetectorSmoothing
+
+/**************************************************************************
+
+  Name: agc_setOverloadDetection
+
+  Purpose: The purpose of this function is to invoke
+  agcInstance_setOverloadDetection() on the default AGC instance.
+
+**************************************************************************/
+int agc_setOverloadDetection(uint32_t clippedSampleLimit,
+    uint32_t gainCutInDb)
+{
+
+  return (agcInstance_setOverloadDetection(&defaultInstance,
+                                           clippedSampleLimit,
+                                           gainCutInDb));
+
+} // agc_setOverloadDetection
+
+/**************************************************************************
+
+  Name: agc_setResidualGain
+
+  Purpose: The purpose of this function is to invoke
+  agcInstance_setResidualGain() on the default AGC instance.
+
+**************************************************************************/
+void agc_setResidualGain(int enabled)
+{
+
+  agcInstance_setResidualGain(&defaultInstance,enabled);
+
+  return;
+
+} // agc_setResidualGain
+
+/**************************************************************************
+
+  Name: agc_setGainSyncMode
+
+  Purpose: The purpose of this function is to invoke agcInstance_setGainSyncMode()
+  on the default AGC instance.
+
+**************************************************************************/
+int agc_setGainSyncMode(int mode)
+{
+
+  return (agcInstance_setGainSyncMode(&defaultInstance,mode));
+
+} // agc_setGainSyncMode
+
+/**************************************************************************
+
+  Name: agc_notifyExternalGainChange
+
+  Purpose: The purpose of this function is to invoke agcInstance_notifyExternalGainChange()
+  on the default AGC instance.
+
+**************************************************************************/
+void agc_notifyExternalGainChange(uint32_t gainInDb)
+{
+
+  agcInstance_notifyExternalGainChange(&defaultInstance,gainInDb);
+
+  return;
+
+} // agc_notifyExternalGainChange
+
+/**************************************************************************
+
+  Name: agc_startGainActuator
+
+  Purpose: The purpose of this function is to invoke agcInstance_startGainActuator()
+  on the default AGC instance.
+
+**************************************************************************/
+int agc_startGainActuator(void)
+{
+
+  return (agcInstance_startGainActuator(&defaultInstance));
+
+} // agc_startGainActuator
+
+/**************************************************************************
+
+  Name: agc_stopGainActuator
+
+  Purpose: The purpose of this function is to invoke agcInstance_stopGainActuator()
+  on the default AGC instance.
+
+**************************************************************************/
+int agc_stopGainActuator(void)
+{
+
+  return (agcInstance_stopGainActuator(&defaultInstance));
+
+} // agc_stopGainActuator
+
+/**************************************************************************
+
+  Name: agc_getGainActuatorCounts
+
+  Purpose: The purpose of this function is to invoke agcInstance_getGainActuatorCounts()
+  on the default AGC instance.
+
+**************************************************************************/
+void agc_getGainActuatorCounts(uint32_t *appliedCountPtr,
+    uint32_t *coalescedCountPtr,
+    uint32_t *droppedCountPtr)
+{
+
+  agcInstance_getGainActuatorCounts(&defaultInstance,
+                                    appliedCountPtr,
+                                    coalescedCountPtr,
+                                    droppedCountPtr);
+
+  return;
+
+} // agc_getGainActuatorCounts
+
+/**************************************************************************
+
+  Name: agc_getStats
+
+  Purpose: The purpose of this function is to invoke agcInstance_getStats()
+  on the default AGC instance.
+
+**************************************************************************/
+void agc_getStats(struct agcStats *statsPtr)
+{
+
+  agcInstance_getStats(&defaultInstance,statsPtr);
+
+  return;
+
+} // agc_getStats
+
+/**************************************************************************
+
+  Name: agc_getLatencyReport
+
+  Purpose: The purpose of this function is to invoke agcInstance_getLatencyReport()
+  on the default AGC instance.
+
+**************************************************************************/
+int agc_getLatencyReport(int histogram,struct agcLatencyReport *reportPtr)
+{
+
+  return (agcInstance_getLatencyReport(&defaultInstance,
+                                       histogram,
+                                       reportPtr));
+
+} // agc_getLatencyReport
+
+/**************************************************************************
+
+  Name: agc_setLatencyBudget
+
+  Purpose: The purpose of this function is to invoke agcInstance_setLatencyBudget()
+  on the default AGC instance.
+
+**************************************************************************/
+int agc_setLatencyBudget(int histogram,uint64_t budgetInNs)
+{
+
+  return (agcInstance_setLatencyBudget(&defaultInstance,
+                                       histogram,
+                                       budgetInNs));
+
+} // agc_setLatencyBudget
+
+/**************************************************************************
+
+  Name: agc_setTraceRecorder
+
+  Purpose: The purpose of this function is to invoke agcInstance_setTraceRecorder()
+  on the default AGC instance.
+
+**************************************************************************/
+void agc_setTraceRecorder(struct agcTraceRecorder *recorderPtr)
+{
+
+  agcInstance_setTraceRecorder(&defaultInstance,recorderPtr);
+
+  return;
+
+} // agc_setTraceRecorder
+
+/**************************************************************************
+
+  Name: agc_displayInternalInformation
+
+  Purpose: The purpose of this function is to invoke agcInstance_displayInternalInformation()
+  on the default AGC instance.
+
+**************************************************************************/
+void agc_displayInternalInformation(char **displayBufferPtrPtr)
+{
+
+  agcInstance_displayInternalInformation(&defaultInstance,
+                                         displayBufferPtrPtr);
+
+  return;
+
+} // agc_displayInternalInformation
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// End of default instance functions.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// Static functions.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+/**************************************************************************
+
+  Name: initialize
+
+  Purpose: The purpose of this function is to initialize an AGC
+  instance.  The gain steps and the gain stages of the amplifier, if it
+  has any, must have been saved by setGainSteps() and setGainStages()
+  before this function is invoked.  See agcInstance_init() for a
+  description of the parameters.
+
+  Calling Sequence: initialized = initialize(me,
+                                             operatingPointInDbFs,
+                                             maxAmplifierGainInDb,
+                                             signalMagnitudeBitCount,
+                                             setGainCallbackPtr,
+                                             getGainCallbackPtr,
+                                             contextPtr)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    operatingPointInDbFs - The AGC operating point in decibels referenced
+    to full scale.
+
+    maxAmplifierGainInDb - The maximum gain of the amplifier in decibels.
+
+    signalMagnitudeBitCount - The number of magnitude bits in a signal.
+
+    setGainCallbackPtr - A pointer to the set gain callback, or NULL.
+
+    getGainCallbackPtr - A pointer to the get gain callback, or NULL.
+
+    contextPtr - The pointer that is passed to every callback.
+
+  Outputs:
+
+    initialized - A flag that indicate whether the system was properly
+    initialized, and a value of zero indicates that was not initialized.
+
+**************************************************************************/
+int initialize(struct agcInstance *me,
+    int32_t operatingPointInDbFs,
+    uint32_t maxAmplifierGainInDb,
+    uint32_t signalMagnitudeBitCount,
+    void (*setGainCallbackPtr)(void *contextPtr,uint32_t gainIndB),
+    uint32_t (*getGainCallbackPtr)(void *contextPtr),
+    void *contextPtr)
+{
+#ifdef AGC_INSTRUMENTATION
+  int i;
+  uint64_t budgetInNs;
+#endif
+
+  // Make sure this indicates we're not initialized.
+  me->initialized = 0;
+
+  // Indicate no signal received.
+  me->signalMagnitude = 0;
+
+  // Start from the default configuration.
+  me->config = defaultConfiguration;
+
+  // Save the set point to the antenna input.
+  me->config.operatingPointInDbFs = operatingPointInDbFs;
+
+  // Save the maximum amplifier gain.
+  me->maxAmplifierGainInDb = maxAmplifierGainInDb;
+
+  // Set this to the midrange.
+  me->signalInDbFs = -12;
+  me->gainError = 0;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Sometimes, adjustments need to be avoided when a transient in the
+  // hardware occurs as a result of a gain adjustment.  In the rtlsdr,
+  // it was initially thought that the transient was occurring in the
+  // tuner chip.  This was not the case.  Instead, a transient in the
+  // demodulated data was occurring as a result of the IIC repeater
+  // being enabled (and/or disabled) in the Realtek 2832U chip.  The
+  // simplest thing to do in software is to perform a transient
+  // avoidance strategy.  While it is 1 that the performance of the
+  // AGC becomes less than optimal, it is still better than experiencing
+  // limit cycles.  The blankingLimit is configurable so that the
+  // user can change the value to suit the needs of the application.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  me->blankingCounter = 0;
+
+  // Start the clock, and forget about earlier adjustments.
+  me->currentTime = 0;
+  me->gainApplied = 0;
+  me->gainAppliedTime = 0;
+  me->adjustmentLatencyCount = 0;
+  me->lastAdjustmentLatency = 0;
+  me->minAdjustmentLatency = 0;
+  me->maxAdjustmentLatency = 0;
+
+  // Allow the AGC to run the first time.
+  me->gainWasAdjusted = 0;
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+ // This is a good starting point for the receiver gain
+  // values.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  me->gainInDb = quantizeGain(me,24);
+
+  me->normalizedSignalLevelInDbFs = -me->gainInDb;
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // AGC filter initialization.  The filter is implemented
+  // as a first-order difference equation.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Initial condition of filter memory.
+  me->filteredGainInDb = agcControlLaw_gainFromDb(me->gainInDb);
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  // The detector matches the default configuration.
+  signalDetector_init(&me->detector,&me->dbfs);
+
+  // No overload has been seen.
+  me->overloadActive = 0;
+  me->overloadStartTime = 0;
+  me->overloadEndTime = 0;
+  me->overloadClippedCount = 0;
+  me->lastOverloadDuration = 0;
+  me->longestOverloadDuration = 0;
+  me->lastOverloadClippedCount = 0;
+
+  // The residual gain stage starts at unity gain.
+  me->residualGain = 1;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Publish the initial configuration.  The working copy is
+  // marked as current so that the sample thread does not
+  // have to copy it on the first invocation.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  me->config.blankingResetCount = me->blankingResetCount;
+
+  // Changes that were notified before now are of no interest.
+  me->externalGainGeneration =
+    (uint32_t)(__atomic_load_n(&me->externalGainChange,__ATOMIC_ACQUIRE) >> 32);
+
+  // Initialization does not start or stop the gain actuator.
+  me->config.gainActuatorEnabled = me->publishedConfig.gainActuatorEnabled;
+
+  // Nor does it detach the trace recorder.
+  me->config.traceRecorderPtr = me->publishedConfig.traceRecorderPtr;
+  me->requestedGainGeneration =
+    __atomic_load_n(&me->appliedGainGeneration,__ATOMIC_ACQUIRE);
+
+  beginConfigurationUpdate(me);
+  me->publishedConfig = me->config;
+  endConfigurationUpdate(me);
+
+  me->configSequence = me->publishedConfigSequence;
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  // Register the client request callbacks.
+  me->setGainCallbackPtr = setGainCallbackPtr;
+  me->getGainCallbackPtr = getGainCallbackPtr;
+  me->contextPtr = contextPtr;
+
+  // Start counting from zero.
+  memset(&me->counters,0,sizeof(me->counters));
+
+#ifdef AGC_INSTRUMENTATION
+  // Clear the latency histograms, but keep their budgets.
+  for (i = 0; i < AGC_LATENCY_HISTOGRAM_COUNT; i++)
+  {
+    budgetInNs = me->latency[i].budgetInNs;
+
+    agcLatencyHistogram_init(&me->latency[i]);
+    agcLatencyHistogram_setBudget(&me->latency[i],budgetInNs);
+  } // for
+#endif
+
+  // Initialize the DbFS calculator.
+  me->initialized = dbfsCalculator_init(&me->dbfs,signalMagnitudeBitCount);
+
+  // Make the initial state visible to agcInstance_getStats().
+  publishStatistics(me);
+
+  return (me->initialized);
+ 
+} // initialize
+
+/**************************************************************************
+
+  Name: setGainSteps
+
+  Purpose: The purpose of this function is to save the gain table of
+  the amplifier, and to compute the map from each gain in decibels to
+  the nearest step.  A gain that lies halfway between two steps maps to
+  the lower one.  With no gain table, the minimum gain is 0dB.
+
+  Calling Sequence: setGainSteps(me,gainStepInDbPtr,gainStepCount)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    gainStepInDbPtr - A pointer to the validated gain table, or NULL.
+
+    gainStepCount - The number of gain steps.  A value of 0 indicates
+    that there is no gain table.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void setGainSteps(struct agcInstance *me,
+    const uint32_t *gainStepInDbPtr,
+    uint32_t gainStepCount)
+{
+  uint32_t i;
+  uint32_t step;
+  int32_t gainInDb;
+
+  me->gainStepCount = gainStepCount;
+  me->minAmplifierGainInDb = 0;
+
+  if (gainStepCount != 0)
+  {
+    for (i = 0; i < gainStepCount; i++)
+    {
+      me->gainStepInDb[i] = gainStepInDbPtr[i];
+    } // for
+
+    me->minAmplifierGainInDb = gainStepInDbPtr[0];
+
+    step = 0;
+
+    for (gainInDb = 0; gainInDb <= AGC_MAX_GAIN_STEP_IN_DB; gainInDb++)
+    {
+      // Move up while the next step is strictly nearer.
+      while (((step + 1) < gainStepCount) &&
+             (((int32_t)me->gainStepInDb[step + 1] - gainInDb) <
+              (gainInDb - (int32_t)me->gainStepInDb[step])))
+      {
+        step++;
+      } // while
+
+      me->gainStepMap[gainInDb] = (uint8_t)step;
+    } // for
+  } // if
+
+  return;
+
+} // setGainSteps
+
+/**************************************************************************
+
+  Name: setGainStages
+
+  Purpose: The purpose of this function is to save the gain stages of
+  the amplifier, and to compute the gain of each stage for each total
+  gain.  Every stage starts at its minimum gain, and the gain above the
+  minimum total gain is handed out according to the distribution
+  policy.  Total gains outside of the range of the stages are given the
+  nearest gains that the stages can reach.  This must be invoked after
+  setGainSteps(), since it overrides the minimum amplifier gain.
+
+  Calling Sequence: setGainStages(me,
+                                  stagePtr,
+                                  stageCount,
+                                  policy,
+                                  setStageGainsCallbackPtr,
+                                  getStageGainsCallbackPtr)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    stagePtr - A pointer to the validated gain stages, or NULL.
+
+    stageCount - The number of gain stages.  A value of 0 indicates that
+    the amplifier is a single stage.
+
+    policy - The distribution policy.
+
+    setStageGainsCallbackPtr - A pointer to the set stage gains
+    callback, or NULL.
+
+    getStageGainsCallbackPtr - A pointer to the get stage gains
+    callback, or NULL.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void setGainStages(struct agcInstance *me,
+    const struct agcGainStage *stagePtr,
+    uint32_t stageCount,
+    int policy,
+    void (*setStageGainsCallbackPtr)(void *contextPtr,
+        const uint32_t *stageGainInDbPtr),
+    void (*getStageGainsCallbackPtr)(void *contextPtr,
+        uint32_t *stageGainInDbPtr))
+{
+  int progress;
+  uint32_t i;
+  uint32_t j;
+  uint32_t stage;
+  uint32_t headroom;
+  uint32_t remainingGain;
+  uint32_t minGainInDb;
+  uint32_t totalGainInDb;
+  uint32_t *gainPtr;
+
+  me->gainStageCount = stageCount;
+  me->setStageGainsCallbackPtr = setStageGainsCallbackPtr;
+  me->getStageGainsCallbackPtr = getStageGainsCallbackPtr;
+
+  if (stageCount != 0)
+  {
+    minGainInDb = 0;
+
+    for (i = 0; i < stageCount; i++)
+    {
+      me->gainStage[i] = stagePtr[i];
+      minGainInDb += stagePtr[i].minGainInDb;
+    } // for
+
+    me->minAmplifierGainInDb = minGainInDb;
+
+    for (totalGainInDb = 0;
+         totalGainInDb <= AGC_MAX_GAIN_STEP_IN_DB;
+         totalGainInDb++)
+    {
+      gainPtr = me->stageGainInDb[totalGainInDb];
+
+      // Every stage starts at its minimum gain.
+      for (i = 0; i < stageCount; i++)
+      {
+        gainPtr[i] = stagePtr[i].minGainInDb;
+      } // for
+
+      remainingGain = 0;
+
+      if (totalGainInDb > minGainInDb)
+      {
+        remainingGain = totalGainInDb - minGainInDb;
+      } // if
+
+      if (policy == AGC_DISTRIBUTE_EVENLY)
+      {
+        progress = 1;
+
+        // Hand out one decibel per stage per round.
+        while ((remainingGain != 0) && (progress))
+        {
+          progress = 0;
+
+          for (i = 0; (remainingGain != 0) && (i < stageCount); i++)
+          {
+            if (gainPtr[i] < stagePtr[i].maxGainInDb)
+            {
+              gainPtr[i]++;
+              remainingGain--;
+              progress = 1;
+            } // if
+          } // for
+        } // while
+      } // if
+      else
+      {
+        // Fill each stage before moving on to the next one.
+        for (j = 0; j < stageCount; j++)
+        {
+          stage = j;
+
+          if (policy == AGC_DISTRIBUTE_BACK_FIRST)
+          {
+            stage = stageCount - 1 - j;
+          } // if
+
+          headroom = stagePtr[stage].maxGainInDb - gainPtr[stage];
+
+          if (headroom > remainingGain)
+          {
+            headroom = remainingGain;
+          } // if
+
+          gainPtr[stage] += headroom;
+          remainingGain -= headroom;
+        } // for
+      } // else
+    } // for
+  } // if
+
+  return;
+
+} // setGainStages
+
+/**************************************************************************
+
+  Name: setDefaultGain
+
+  Purpose: The purpose of this function is to connect the set gain
+  callback of the default instance to the callback that was given to
+  agc_init() or agc_initWithGainSteps().
+
+  Calling Sequence: setDefaultGain(contextPtr,gainIndB)
+
+  Inputs:
+
+    contextPtr - A pointer to the default callbacks.
+
+    gainIndB - The gain in decibels, or the index of a gain step.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void setDefaultGain(void *contextPtr,uint32_t gainIndB)
+{
+  struct agcDefaultCallbacks *callbacksPtr;
+
+  callbacksPtr = (struct agcDefaultCallbacks *)contextPtr;
+
+  callbacksPtr->setGainCallbackPtr(gainIndB);
+
+  return;
+
+} // setDefaultGain
+
+/**************************************************************************
+
+  Name: getDefaultGain
+
+  Purpose: The purpose of this function is to connect the get gain
+  callback of the default instance to the callback that was given to
+  agc_init() or agc_initWithGainSteps().
+
+  Calling Sequence: setting = getDefaultGain(contextPtr)
+
+  Inputs:
+
+    contextPtr - A pointer to the default callbacks.
+
+  Outputs:
+
+    setting - The gain in decibels, or the index of a gain step.
+
+**************************************************************************/
+uint32_t getDefaultGain(void *contextPtr)
+{
+  struct agcDefaultCallbacks *callbacksPtr;
+
+  callbacksPtr = (struct agcDefaultCallbacks *)contextPtr;
+
+  return (callbacksPtr->getGainCallbackPtr());
+
+} // getDefaultGain
+
+/**************************************************************************
+
+  Name: setDefaultStageGains
+
+  Purpose: The purpose of this function is to connect the set stage
+  gains callback of the default instance to the callback that was given
+  to agc_initWithGainStages().
+
+  Calling Sequence: setDefaultStageGains(contextPtr,stageGainInDbPtr)
+
+  Inputs:
+
+    contextPtr - A pointer to the default callbacks.
+
+    stageGainInDbPtr - A pointer to the gains of the stages.
 
-// All private stuff is bundled in one structure.
-static struct privateData
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void setDefaultStageGains(void *contextPtr,const uint32_t *stageGainInDbPtr)
 {
-  // Don't run unless the system has been initialized.
-  int initialized;
+  struct agcDefaultCallbacks *callbacksPtr;
 
-  // These parameters are sometimes needed to avoid transients.
-  uint32_t blankingCounter;
-  uint32_t blankingLimit;
-  int gainWasAdjusted;
+  callbacksPtr = (struct agcDefaultCallbacks *)contextPtr;
 
-  // Yes, we need some deadband.
-  int32_t deadbandInDb;
+  callbacksPtr->setStageGainsCallbackPtr(stageGainInDbPtr);
 
-  // If 1, the AGC is running.
-  int enabled;
+  return;
 
-  int32_t signalInDbFs;
+} // setDefaultStageGains
 
-  // The setpoint.
-  int32_t operatingPointInDbFs;
+/**************************************************************************
 
-  // The maximum amplifier gain in decibels
-  int32_t maxAmplifierGainInDb;
+  Name: getDefaultStageGains
 
-  // AGC lowpass filter coefficient for baseband gain filtering.
-  float alpha;
+  Purpose: The purpose of this function is to connect the get stage
+  gains callback of the default instance to the callback that was given
+  to agc_initWithGainStages().
 
-  // System gains.
-  uint32_t gainInDb;
- 
-  // Filtered gain.
-  float filteredGainInDb;
+  Calling Sequence: getDefaultStageGains(contextPtr,stageGainInDbPtr)
 
-  // The incoming signal magnitude.
-  uint32_t signalMagnitude;
+  Inputs:
 
-  // Signal level before amplification.
-  int32_t normalizedSignalLevelInDbFs;
+    contextPtr - A pointer to the default callbacks.
 
-  // Gain set callback pointer to request client to set gain.
-  void (*setGainCallbackPtr)(uint32_t gainIndB);
+    stageGainInDbPtr - A pointer to storage for the gains of the stages.
 
-  // Gain rerieval callback pointer to request gain from e client.
-  uint32_t (*getGainCallbackPtr)(void);
-} me;
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void getDefaultStageGains(void *contextPtr,uint32_t *stageGainInDbPtr)
+{
+  struct agcDefaultCallbacks *callbacksPtr;
+
+  callbacksPtr = (struct agcDefaultCallbacks *)contextPtr;
 
-static void resetBlankingSystem(void);
-static void run(uint32_t signalMagnitude);
-static void runHarris(uint32_t signalMagnitude);
-static void setHardwareGainInDb(uint32_t gainInDb);
-static uint32_t getHardwareGainInDb(void);
+  callbacksPtr->getStageGainsCallbackPtr(stageGainInDbPtr);
+
+  return;
+
+} // getDefaultStageGains
 
 /**************************************************************************
 
-  Name: agc_acceptData
+  Name: quantizeGain
 
-  Purpose: The purpose of this function is the interface to run the AGC.
+  Purpose: The purpose of this function is to find the gain nearest to
+  a requested gain that the amplifier can be set to.
 
-  Calling Sequence: agc_acceptData(signalMagnitude)
+  Calling Sequence: gainInDb = quantizeGain(me,gainInDb)
 
   Inputs:
 
-    signalMagnitude - The magnitude of the signal.
+    me - A pointer to the AGC instance.
+
+    gainInDb - The requested gain in decibels.
 
   Outputs:
 
-    None.
+    gainInDb - The gain of the nearest step.  The requested gain is
+    returned when there is no gain table.
 
 **************************************************************************/
-void agc_acceptData(uint32_t signalMagnitude)
+uint32_t quantizeGain(struct agcInstance *me,uint32_t gainInDb)
 {
 
-  // Allow the AGC to poerate if it is configured.
-  if (me.initialized)
+  if (me->gainStepCount != 0)
   {
-    if (me.enabled)
+    if (gainInDb > AGC_MAX_GAIN_STEP_IN_DB)
     {
-      // Process the signal.
-      run(signalMagnitude);
+      gainInDb = AGC_MAX_GAIN_STEP_IN_DB;
     } // if
+
+    gainInDb = me->gainStepInDb[me->gainStepMap[gainInDb]];
   } // if
+  else
+  {
+    if (gainInDb < me->minAmplifierGainInDb)
+    {
+      // The stages can't go below the sum of their minimum gains.
+      gainInDb = me->minAmplifierGainInDb;
+    } // if
+  } // else
 
-  return;
+  return (gainInDb);
 
-} // agc_acceptData
+} // quantizeGain
 
-/************************************************************************
+/**************************************************************************
 
-  Name: agc_init
+  Name: decodeGainSetting
 
-  Purpose: The purpose of this function is to initialize the AGC
-  subsystem.
+  Purpose: The purpose of this function is to convert a gain setting
+  that was supplied by the application into a gain in decibels.  With a
+  gain table, the setting is the index of a step, and otherwise it is
+  the gain in decibels.
 
-  Calling Sequence: initialized = agc_init(operatingPointInDbFs,
-                                           maxAmplifierGainInDb,
-                                           signalMagnitudeBitCount,
-                                           signalMagnitudeBitCount,
-                                           getGainCallbackPtr)
+  Calling Sequence: valid = decodeGainSetting(me,setting,&gainInDb)
 
   Inputs:
 
-    operatingPointInDbFs - The AGC operating point in decibels referenced
-    to full scale.  Full scale represents 0dBFs, otherwise, all other
-    values will be negative.
+    me - A pointer to the AGC instance.
 
-    maxAmplifierGainInDb - The maximum gain of the amplifier in decibels.
-    It is the responsibility of the application to know the hardware
-    characteristics.
+    setting - The gain setting.
 
-    signalMagnitudeBitCount - The number of magnitude bits in a signal.
-    This is necssary to map a signal magnitude into the log domain so
-    the AGC algorithm can perform all computations in a decibel
-    scale (specifically dBFS).  It follows that linear system theory
-    can be applied.
+    gainInDbPtr - A pointer to storage for the gain in decibels.
 
-    setGainCallbackPtr - A pointer to a client callback function that
-    is invoked to request the client application to set the hardware gain.
-    A value of NULL is used if the client does not want to register a
-    callback.
-    If a callback is not registered,the AGC will never modify modify
-    the hardware gain.  In other words, rhe system will have no AGC.
+  Outputs:
 
-    getGainCallbackPtr - A pointer to a client callback function that
-    is invoked to request the client application to supply the hardware
-    gain.
-    A value of NULL is used if the client does not want to register a
-    callback.
-    In  other words, if a callback is not registered, the AGC will have
-    no knowledge if the gain was modifies by anyone  else. DO THIS AT
-    YOUR OWN RISK.
+    valid - A flag that indicates whether or not the setting was in
+    range.  The gain is not stored when the setting is out of range.
+
+**************************************************************************/
+int decodeGainSetting(struct agcInstance *me,
+    uint32_t setting,
+    uint32_t *gainInDbPtr)
+{
+  int valid;
+
+  if (me->gainStepCount != 0)
+  {
+    valid = (setting < me->gainStepCount);
+
+    if (valid)
+    {
+      *gainInDbPtr = me->gainStepInDb[setting];
+    } // if
+  } // if
+  else
+  {
+    valid = (setting >= me->minAmplifierGainInDb) &&
+            (setting <= (uint32_t)me->maxAmplifierGainInDb);
+
+    if (valid)
+    {
+      *gainInDbPtr = setting;
+    } // if
+  } // else
+
+  return (valid);
+
+} // decodeGainSetting
+
+/**************************************************************************
+
+  Name: beginConfigurationUpdate
+
+  Purpose: The purpose of this function is to start an update of the
+  published configuration.  The configuration lock is taken so that
+  writers are serialized, and the sequence number is made odd so that
+  the sample thread knows that the configuration is being modified.
+  Every call must be paired with a call to endConfigurationUpdate().
+
+  Calling Sequence: beginConfigurationUpdate(me)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
 
   Outputs:
 
-    initialized - A flag that indicate whether the system was properly
-    initialized, and a value of zero indicates that was not initialized..
+    None.
 
 **************************************************************************/
-int agc_init(int32_t operatingPointInDbFs,
-    uint32_t maxAmplifierGainInDb,
-    uint32_t signalMagnitudeBitCount,
-    void (*setGainCallbackPtr)(uint32_t gainIndB),
-    uint32_t (*getGainCallbackPtr)(void))
+void beginConfigurationUpdate(struct agcInstance *me)
 {
+  uint32_t sequence;
 
-  // Make sure this indicates we're not initialized.
-  me.initialized = 0;
+  pthread_mutex_lock(&me->configLock);
 
-  // Indicate no signal received.
-  me.signalMagnitude = 0;
+  sequence = __atomic_load_n(&me->publishedConfigSequence,__ATOMIC_RELAXED);
 
-  // Save the set point to the antenna input.
-  me.operatingPointInDbFs = operatingPointInDbFs;
+  __atomic_store_n(&me->publishedConfigSequence,
+                   sequence + 1,
+                   __ATOMIC_RELAXED);
 
-  // Save the maximum amplifier gain.
-  me.maxAmplifierGainInDb = maxAmplifierGainInDb;
+  // The configuration stores must not be seen before the odd sequence.
+  __atomic_thread_fence(__ATOMIC_RELEASE);
 
-  // Start with a reasonable deadband.
-  me.deadbandInDb = 1;
+  return;
 
-  // Set this to the midrange.
-  me.signalInDbFs = -12;
+} // beginConfigurationUpdate
 
-  // Default to disabled.
-  me.enabled = 0;
+/**************************************************************************
 
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-  // Sometimes, adjustments need to be avoided when a transient in the
-  // hardware occurs as a result of a gain adjustment.  In the rtlsdr,
-  // it was initially thought that the transient was occurring in the
-  // tuner chip.  This was not the case.  Instead, a transient in the
-  // demodulated data was occurring as a result of the IIC repeater
-  // being enabled (and/or disabled) in the Realtek 2832U chip.  The
-  // simplest thing to do in software is to perform a transient
-  // avoidance strategy.  While it is 1 that the performance of the
-  // AGC becomes less than optimal, it is still better than experiencing
-  // limit cycles.  The blankingLimit is configurable so that the
-  // user can change the value to suit the needs of the application.
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-  me.blankingCounter = 0;
-  me.blankingLimit = 1;
+  Name: endConfigurationUpdate
 
-  // Allow the AGC to run the first time.
-  me.gainWasAdjusted = 0;
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  Purpose: The purpose of this function is to complete an update of the
+  published configuration.  The sequence number is made even, which
+  publishes the configuration to the sample thread, and the
+  configuration lock is released.
 
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
- // This is a good starting point for the receiver gain
-  // values.
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-  me.gainInDb = 24;
+  Calling Sequence: endConfigurationUpdate(me)
 
-  me.normalizedSignalLevelInDbFs = -me.gainInDb;
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  Inputs:
 
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-  // AGC filter initialization.  The filter is implemented
-  // as a first-order difference equation.
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-  // Initial condition of filter memory.
-  me.filteredGainInDb = 24;
+    me - A pointer to the AGC instance.
 
-  //+++++++++++++++++++++++++++++++++++++++++++++++++
-  // Set the AGC time constant such that gain
-  // adjustment occurs rapidly while maintaining
-  // system stability.
-  //+++++++++++++++++++++++++++++++++++++++++++++++++
-  me.alpha = 0.8;
-  //+++++++++++++++++++++++++++++++++++++++++++++++++
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  Outputs:
 
-  // Register the client request callbacks.
-  me.setGainCallbackPtr = setGainCallbackPtr;
-  me.getGainCallbackPtr = getGainCallbackPtr;
+    None.
 
-  // Initialize the DbFS calculator.
-  me.initialized = dbfs_init(signalMagnitudeBitCount);
+**************************************************************************/
+void endConfigurationUpdate(struct agcInstance *me)
+{
+  uint32_t sequence;
 
-  return (me.initialized);
- 
-} // agc_init
+  sequence = __atomic_load_n(&me->publishedConfigSequence,__ATOMIC_RELAXED);
+
+  __atomic_store_n(&me->publishedConfigSequence,
+                   sequence + 1,
+                   __ATOMIC_RELEASE);
+
+  pthread_mutex_unlock(&me->configLock);
+
+  return;
+
+} // endConfigurationUpdate
 
 /**************************************************************************
 
-  Name: agc_setDeadband
+  Name: applyConfigurationUpdates
 
-  Purpose: The purpose of this function is to set the deadband of the
-  AGC.  This presents gain setting oscillations
+  Purpose: The purpose of this function is to bring the sample thread's
+  copy of the configuration up to date with the published
+  configuration.  When nothing has been published since the last
+  invocation, this costs one load of the sequence number.  Otherwise,
+  the configuration is copied.  If a writer is active, or gets in
+  during the copy, the sample thread keeps its current configuration
+  and tries again on the next invocation, so the AGC always runs with
+  a consistent set of parameters and never waits.  If the control
+  thread requested a reset of the blanking system, it is performed
+  here.
 
-  Calling Sequence: success = agc_setDeadband(deadbandInDb)
+  Calling Sequence: applyConfigurationUpdates(me)
 
   Inputs:
 
-    deadbandInDb - The deadband, in decibels, used to prevent unwanted
-    gain setting oscillations.  A window is created such that a gain
-    adjustment will not occur if the current gain is within the window
-    new gain <= current gain += deadband.
+    me - A pointer to the AGC instance.
 
   Outputs:
 
-    success - A flag that indicates whether or not the deadband parameter
-    was updated.  A value of 1 indicates that the deadband was
-    updated, and a value of 0 indicates that the parameter was not
-    updated due to an invalid specified deadband value.
+    None.
 
 **************************************************************************/
-int agc_setDeadband(uint32_t deadbandInDb)
+void applyConfigurationUpdates(struct agcInstance *me)
 {
-  int success;
+  uint32_t sequence;
+  uint32_t endSequence;
+  struct agcConfiguration config;
 
-  // Default to failure.
-  success = 0;
+  sequence = __atomic_load_n(&me->publishedConfigSequence,__ATOMIC_ACQUIRE);
 
-  if ((deadbandInDb >= 0) && (deadbandInDb <= 10))
+  // Leave an update that is in progress for the next invocation.
+  if ((sequence != me->configSequence) && ((sequence & 1) == 0))
   {
-    // Update the attribute.
-    me.deadbandInDb = deadbandInDb;
+    config = me->publishedConfig;
 
-    // Indicate success.
-    success = 1;
+    // The copy must complete before the sequence is checked again.
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    endSequence = __atomic_load_n(&me->publishedConfigSequence,
+                                  __ATOMIC_RELAXED);
+
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+    // If a writer got in during the copy, the copy is torn.  Keep the
+    // current configuration, which is consistent, and try again on the
+    // next invocation rather than waiting for the writer.
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+    if (endSequence == sequence)
+    {
+      if ((me->config.gainActuatorEnabled) && (!config.gainActuatorEnabled))
+      {
+        //+++++++++++++++++++++++++++++++++++++++++++++++++++
+        // The actuator thread has exited, but a request
+        // that was posted while it was stopping may remain.
+        // Write it to the hardware ourselves.
+        //+++++++++++++++++++++++++++++++++++++++++++++++++++
+        applyGainRequest(me,
+                         __atomic_exchange_n(&me->gainMailbox,
+                                             0,
+                                             __ATOMIC_ACQ_REL));
+      } // if
+
+      if ((config.detectorMode != me->config.detectorMode) ||
+          (config.detectorWindowLength != me->config.detectorWindowLength) ||
+          (config.detectorAttackQ15 != me->config.detectorAttackQ15) ||
+          (config.detectorDecayQ15 != me->config.detectorDecayQ15))
+      {
+        // Start the detector over with its new settings.
+        signalDetector_configure(&me->detector,
+                                 config.detectorMode,
+                                 config.detectorWindowLength,
+                                 config.detectorAttackQ15,
+                                 config.detectorDecayQ15);
+      } // if
+
+      // The copy is consistent.
+      me->config = config;
+      me->configSequence = sequence;
+
+      if (me->config.blankingResetCount != me->blankingResetCount)
+      {
+        // The control thread asked for a fresh blanking interval.
+        me->blankingResetCount = me->config.blankingResetCount;
+
+        resetBlankingSystem(me);
+      } // if
+    } // if
   } // if
 
-  return (success);
+  return;
 
-} // agc_setDeadband
+} // applyConfigurationUpdates
 
 /**************************************************************************
 
-  Name: agc_setBlankingLimit
+  Name: runGainActuator
 
-  Purpose: The purpose of this function is to set the blanking limit of
-  the AGC.  This presents gain setting oscillations.  What happens if
-  transients exist after an adjustment is made is that the AGC becomes
-  blind to the actual signal that is being received since the transient
-  can swamp the system.
+  Purpose: The purpose of this function is to be the entry point of the
+  gain actuator thread.  The thread sleeps until a gain is posted, and
+  then it writes the most recent gain to the hardware.  When it is told
+  to exit, it writes any remaining gain before it returns.
 
-  Calling Sequence: success = agc_setBlankingLimit(blankingLimit)
+  Calling Sequence: runGainActuator(argPtr)
 
   Inputs:
 
-    blankingLimit - The number of measurements to ignore before making
-    the next gain adjustment.
+    argPtr - A pointer to the AGC instance.
 
   Outputs:
 
-    success - A flag that indicates whether or not the blanking limit
-    parameter was updated.  A value of 1 indicates that the blanking
-    limit was updated, and a value of 0 indicates that the parameter
-    was not updated due to an invalid specified blanking limit value.
+    NULL.
 
 **************************************************************************/
-int agc_setBlankingLimit(uint32_t blankingLimit)
+void *runGainActuator(void *argPtr)
 {
-  int success;
+  struct agcInstance *me;
 
-  // Default to failure.
-  success = 0;
+  me = (struct agcInstance *)argPtr;
 
-  if ((blankingLimit >= 0) && (blankingLimit <= 10))
+  while (!__atomic_load_n(&me->actuatorStopRequested,__ATOMIC_ACQUIRE))
   {
-    // Update the attributes.
-    me.blankingLimit = blankingLimit;
+    // Wait for work.  Interrupted waits simply go around again.
+    sem_wait(&me->actuatorSemaphore);
 
-    // Set the blanking system to its initial state.
-    resetBlankingSystem();
+    // Take the most recent request, if any.
+    applyGainRequest(me,
+                     __atomic_exchange_n(&me->gainMailbox,
+                                         0,
+                                         __ATOMIC_ACQ_REL));
+  } // while
 
-    // Indicate success.
-    success = 1;
+  // Don't leave a request behind.
+  applyGainRequest(me,
+                   __atomic_exchange_n(&me->gainMailbox,0,__ATOMIC_ACQ_REL));
+
+  return (NULL);
+
+} // runGainActuator
+
+/**************************************************************************
+
+  Name: postGainRequest
+
+  Purpose: The purpose of this function is to post a gain to the gain
+  actuator.  A request that the actuator has not taken yet is replaced,
+  so that only the most recent gain is written to the hardware.  This
+  function never blocks.
+
+  Calling Sequence: postGainRequest(me,gainInDb)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    gainInDb - The gain in decibels.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void postGainRequest(struct agcInstance *me,uint32_t gainInDb)
+{
+  uint64_t request;
+  uint64_t previousRequest;
+
+  // Generation zero is reserved so that an empty mailbox is zero.
+  me->requestedGainGeneration++;
+
+  if (me->requestedGainGeneration == 0)
+  {
+    me->requestedGainGeneration = 1;
+  } // if
+
+  request = ((uint64_t)me->requestedGainGeneration << 32) | gainInDb;
+
+  previousRequest = __atomic_exchange_n(&me->gainMailbox,
+                                        request,
+                                        __ATOMIC_ACQ_REL);
+
+  if (previousRequest != 0)
+  {
+    // The actuator never saw the previous gain.
+    __atomic_add_fetch(&me->coalescedGainWriteCount,1,__ATOMIC_RELAXED);
   } // if
 
-  return (success);
+  // Wake up the actuator.
+  sem_post(&me->actuatorSemaphore);
 
-} // agc_setBlankingLimit
+  return;
+
+} // postGainRequest
 
 /**************************************************************************
 
-  Name: agc_setOperatingPoint
+  Name: applyGainRequest
 
-  Purpose: The purpose of this function is to set the operating point
-  of the AGC.
+  Purpose: The purpose of this function is to write a posted gain to the
+  hardware, and to record that its generation has been applied.  The
+  write is skipped if the hardware already has the gain, which happens
+  when a gain change is undone before the actuator gets to it.
 
-  Calling Sequence: agc_setOperatingPoint(operatingPointInDbFs)
+  Calling Sequence: applyGainRequest(me,request)
 
   Inputs:
 
-    operatingPointInDbFs - The operating point in decibels referenced to
-    the full scale value.
+    me - A pointer to the AGC instance.
+
+    request - The request that was taken from the mailbox.  A value of
+    zero indicates that there was no request, and it is ignored.
 
   Outputs:
 
     None.
 
 **************************************************************************/
-void agc_setOperatingPoint(int32_t operatingPointInDbFs)
+void applyGainRequest(struct agcInstance *me,uint64_t request)
 {
+  uint32_t gainInDb;
+
+  if (request != 0)
+  {
+    gainInDb = (uint32_t)request;
 
-  // Update operating point.
-  me.operatingPointInDbFs = operatingPointInDbFs;
+    if (gainInDb != me->actuatorGainInDb)
+    {
+      setHardwareGainInDb(me,gainInDb);
+
+      me->actuatorGainInDb = gainInDb;
+
+      __atomic_add_fetch(&me->appliedGainWriteCount,1,__ATOMIC_RELAXED);
+    } // if
+    else
+    {
+      __atomic_add_fetch(&me->droppedGainWriteCount,1,__ATOMIC_RELAXED);
+    } // else
+
+    // The sample thread can start blanking now.
+    __atomic_store_n(&me->appliedGainGeneration,
+                     (uint32_t)(request >> 32),
+                     __ATOMIC_RELEASE);
+  } // if
 
   return;
 
-} // agc_setOperatingPoint
+} // applyGainRequest
 
 /**************************************************************************
 
-  Name: agc_setAgcFilterCoefficient
+  Name: isGainWritePending
 
-  Purpose: The purpose of this function is to set the coefficient of
-  the first order lowpass filter that filters the baseband gain value.
-  In effect, the time constant of the filter is set.
+  Purpose: The purpose of this function is to determine whether or not
+  a gain that the AGC posted to the gain actuator has yet to be written
+  to the hardware.  This is always 0 when the actuator is not used.
 
-  Calling Sequence: success = agc_setAgcFilterCoefficient(coefficient)
+  Calling Sequence: pending = isGainWritePending(me)
 
   Inputs:
 
-    coefficient - The filter coefficient for the lowpass filter that
-    filters the baseband gain value.
+    me - A pointer to the AGC instance.
 
   Outputs:
 
-    success - A flag that indicates whether the filter coefficient was
-    updated.  A value of 1 indicates that the coefficient was
-    updated, and a value of 0 indicates that the coefficient was
-    not updated due to an invalid coefficient value.
+    pending - A flag that indicates whether or not a gain write is
+    pending.  A value of 1 indicates that a write is pending, and a
+    value of 0 indicates that the hardware is up to date.
 
 **************************************************************************/
-int agc_setAgcFilterCoefficient(float coefficient)
+int isGainWritePending(struct agcInstance *me)
 {
-  int success;
-
-  // Default to failure.
-  success = 0;
-
-  if ((coefficient >= 0.001) && (coefficient < 0.999))
-  {
-    // Update the attribute.
-    me.alpha = coefficient;
+  uint32_t appliedGeneration;
 
-    // Indicate success.
-    success = 1;
-  } // if
+  appliedGeneration = __atomic_load_n(&me->appliedGainGeneration,
+                                      __ATOMIC_ACQUIRE);
 
-  return (success);
+  return (appliedGeneration != me->requestedGainGeneration);
 
-} // agc_agc_setAgcFilterCoefficient
+} // isGainWritePending
 
 /**************************************************************************
 
-  Name: agc_enable
+  Name: resetBlankingSystem
 
-  Purpose: The purpose of this function is to enable the AGC.
+  Purpose: The purpose of this function is to reset the blanking system
+  to its starting state.
 
-  Calling Sequence: success = agc_enable();
+  Calling Sequence: resetBlankingSystem(me)
 
   Inputs:
 
-    None.
+    me - A pointer to the AGC instance.
 
   Outputs:
 
-    success - A flag that indicates whether or not the operation was
-    successful.  A value of 1 indicates that the operation was
-    successful, and a value of 0 indicates that, eitherthe AGC
-    was already enabled, or the radio was not in a receiving state.
+    None.
 
 **************************************************************************/
-int agc_enable(void)
+void resetBlankingSystem(struct agcInstance *me)
 {
-  int success;
-
- // Default to failure.
-  success = 0;
-
-  if (!me.enabled)
-  {
-    // Set the system to an initial state.
-    resetBlankingSystem();
 
-    // Enable the AGC.
-    me.enabled = 1;
+  // Reset the counter for the next blanking interval.
+  me->blankingCounter = 0;
 
-    // Indicate success.
-    success = 1;
-  } // if
+  // Ensure that the AGC can run the next time.
+  me->gainWasAdjusted = 0;
 
-  return (success);
+  return;
 
-} // agc_enable
+} // resetBlankingSystem
 
 /**************************************************************************
 
-  Name: agc_disable
+  Name: isBlankingComplete
 
-  Purpose: The purpose of this function is to disable the AGC.
+  Purpose: The purpose of this function is to advance the blanking
+  system, and to determine whether or not the blanking interval that
+  follows a gain adjustment is over.  The interval does not start until
+  the hardware has been given the new gain.  In the invocation mode,
+  the interval lasts for blankingLimit invocations, and in the duration
+  mode, it lasts until blankingDuration ticks have passed.
 
-  Calling Sequence: success = agc_disable();
+  Calling Sequence: complete = isBlankingComplete(me)
 
   Inputs:
 
-    None.
+    me - A pointer to the AGC instance.
 
   Outputs:
 
-    success - A flag that indicates whether or not the operation was
-    successful.  A value of 1 indicates that the operation was
-    successful, and a value of 0 indicates that the AGC was already
-    disabled.
+    complete - A flag that indicates whether or not blanking is
+    complete.  A value of 1 indicates that the AGC may run, and a value
+    of 0 indicates that the system is still blanked.
 
 **************************************************************************/
-int agc_disable(void)
+int isBlankingComplete(struct agcInstance *me)
 {
-  int success;
+  int complete;
 
- // Default to failure.
-  success = 0;
+  // Default to still blanked.
+  complete = 0;
 
-  if (me.enabled)
+  // The blanking interval has not started while the write is pending.
+  if (!isGainWritePending(me))
   {
-    // Disable the AGC.
-    me.enabled = 0;
+    if (!me->gainApplied)
+    {
+      // The actuator has written the gain since the last invocation.
+      me->gainApplied = 1;
+      me->gainAppliedTime = me->currentTime;
+    } // if
 
-    success = 1;
+    if (me->config.blankingMode == AGC_BLANKING_BY_DURATION)
+    {
+      complete = ((me->currentTime - me->gainAppliedTime) >=
+                  me->config.blankingDuration);
+    } // if
+    else
+    {
+      if (me->blankingCounter < me->config.blankingLimit)
+      {
+        // The systemn is still blanked.
+        me->blankingCounter++;
+      } // if
+      else
+      {
+        complete = 1;
+      } // else
+    } // else
   } // if
 
-  return (success);
+  return (complete);
 
-} // agc_disable
+} // isBlankingComplete
 
 /**************************************************************************
 
-  Name: agc_isEnabled
+  Name: recordGainAdjustment
 
-  Purpose: The purpose of this function is to determine whether or not
-  the AGC is enabled.
+  Purpose: The purpose of this function is to measure the latency from
+  the hardware being given the previous gain to the gain adjustment
+  that is being made, and to note that the new gain has yet to be
+  applied.
 
-  Calling Sequence: status = agc_isEnabled()
+  Calling Sequence: recordGainAdjustment(me)
 
   Inputs:
 
-    None.
+    me - A pointer to the AGC instance.
 
   Outputs:
 
-    success - A flag that indicates whether or not the AGC is enabled.
-    A value of 1 indicates that the AGC is enabled, and a value of
-    0 indicates that the AGC is disabled.
+    None.
 
 **************************************************************************/
-int agc_isEnabled(void)
+void recordGainAdjustment(struct agcInstance *me)
 {
+  uint64_t latency;
+
+  if (me->gainApplied)
+  {
+    latency = me->currentTime - me->gainAppliedTime;
 
-  return (me.enabled);
+    __atomic_store_n(&me->lastAdjustmentLatency,latency,__ATOMIC_RELAXED);
 
-} // agc_isEnabled
+    if ((me->adjustmentLatencyCount == 0) ||
+        (latency < me->minAdjustmentLatency))
+    {
+      __atomic_store_n(&me->minAdjustmentLatency,latency,__ATOMIC_RELAXED);
+    } // if
+
+    if (latency > me->maxAdjustmentLatency)
+    {
+      __atomic_store_n(&me->maxAdjustmentLatency,latency,__ATOMIC_RELAXED);
+    } // if
+
+    // This publishes the latencies.
+    __atomic_store_n(&me->adjustmentLatencyCount,
+                     me->adjustmentLatencyCount + 1,
+                     __ATOMIC_RELEASE);
+  } // if
+
+  // The new gain has not been applied yet.
+  me->gainApplied = 0;
+
+  return;
+
+} // recordGainAdjustment
 
 /**************************************************************************
 
-  Name: agc_displayInternalInformation
+  Name: recordTrace
 
-  Purpose: The purpose of this function is to display information in the
-  AGC.  rather than actually display this information, the formatted
-  indormation is printed to a string so that the client software can
-  display the information is it sees fit.  This way, the AGC focuses on
-  perofming its main function rather than printing information.  in
-  general, this information provides a glass box view of the AGC that is
-  useful for system level debugging.
+  Purpose: The purpose of this function is to add a record of the
+  current invocation to a trace recorder.  What happened during the
+  invocation is determined by comparing the event counters with their
+  values before the invocation.  This function never blocks.
 
-  Calling Sequence: agc_displayInternalInformation(&displayBuffwe)
+  Calling Sequence: recordTrace(me,
+                                recorderPtr,
+                                previousCountersPtr,
+                                allowedToRun,
+                                overloaded)
 
   Inputs:
 
-    displayBuffer - A pointer to a pointer to a display buffer provided
-    by the caller.
+    me - A pointer to the AGC instance.
+
+    recorderPtr - A pointer to the trace recorder.
+
+    previousCountersPtr - A pointer to the event counters as they were
+    at the start of the invocation.
+
+    allowedToRun - A flag that indicates whether or not the AGC
+    algorithm ran during the invocation.  A value of 0 indicates that
+    the invocation was blanked.
+
+    overloaded - A flag that indicates whether or not the invocation
+    took the overload path instead.
 
   Outputs:
 
     None.
 
 **************************************************************************/
-void agc_displayInternalInformation(char **displayBufferPtrPtr)
+void recordTrace(struct agcInstance *me,
+    struct agcTraceRecorder *recorderPtr,
+    const struct agcCounters *previousCountersPtr,
+    int allowedToRun,
+    int overloaded)
 {
-  char *p;;
-  int n;
-
-  // Reference caller's display buffer.
-  p = *displayBufferPtrPtr;
+  struct agcTraceRecord record;
 
-  n = sprintf(p,"\n--------------------------------------------\n");
-  p += n;
-
-  n = sprintf(p,"AGC Internal Information\n");
-  p += n;
+  record.time = me->currentTime;
+  record.filteredGainQ16 = agcControlLaw_gainToQ16(me->filteredGainInDb);
+  record.normalizedSignalLevelInDbFs = (int16_t)me->normalizedSignalLevelInDbFs;
+  record.signalInDbFs = (int16_t)me->signalInDbFs;
+  record.gainError = (int16_t)me->gainError;
+  record.blankingCounter = (uint16_t)me->blankingCounter;
+  record.gainInDb = (uint8_t)me->gainInDb;
+  record.reserved = 0;
 
-  n = sprintf(p,"--------------------------------------------\n");
-  p += n;
+  record.flags = 0;
 
-  if (me.enabled)
+  if (overloaded)
   {
-    n = sprintf(p,"AGC Emabled                : Yes\n");
-    p += n;
+    record.flags |= AGC_TRACE_OVERLOAD;
   } // if
   else
   {
-    n = sprintf(p,"AGC Emabled                : No\n");
-    p += n;
+    if (!allowedToRun)
+    {
+      record.flags |= AGC_TRACE_BLANKED;
+    } // if
   } // else
 
-  n = sprintf(p,"Blanking Counter           : %u ticks\n",
-          me.blankingCounter);
-  p += n;
-
-  n = sprintf(p,"Blanking Limit             : %u ticks\n",
-          me.blankingLimit);
-  p += n;
+  if (me->counters.gainWriteCount != previousCountersPtr->gainWriteCount)
+  {
+    record.flags |= AGC_TRACE_HARDWARE_WRITE;
+  } // if
 
-  n = sprintf(p,"Lowpass Filter Coefficient : %0.3f\n",
-          me.alpha);
-  p += n;
+  if (me->counters.deadbandSuppressionCount !=
+      previousCountersPtr->deadbandSuppressionCount)
+  {
+    record.flags |= AGC_TRACE_DEADBAND;
+  } // if
 
-  n = sprintf(p,"Deadband                   : %u dB\n",
-          me.deadbandInDb);
-  p += n;
+  if (me->counters.minGainClampCount != previousCountersPtr->minGainClampCount)
+  {
+    record.flags |= AGC_TRACE_MIN_GAIN_CLAMP;
+  } // if
 
-  n = sprintf(p,"Operating Point            : %d dBFs\n",
-          me.operatingPointInDbFs);
-  p += n;
+  if (me->counters.maxGainClampCount != previousCountersPtr->maxGainClampCount)
+  {
+    record.flags |= AGC_TRACE_MAX_GAIN_CLAMP;
+  } // if
 
-  n = sprintf(p,"Maximum Amplifier Gain     : %u dB\n",
-          me.maxAmplifierGainInDb);
-  p += n;
+  agcTraceRecorder_record(recorderPtr,&record);
 
-  n = sprintf(p,"Gain                       : %u dB\n",
-          me.gainInDb);
-  p += n;
+  return;
 
-  n = sprintf(p,"/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/\n");
-  p += n;
+} // recordTrace
 
-  n = sprintf(p,"Signal Magnitude           : %u\n",
-          me.signalMagnitude);
-  p += n;
+/**************************************************************************
 
-  n = sprintf(p,"RSSI (Before Amp)          : %d dBFs\n",
-          me.normalizedSignalLevelInDbFs);
-  p += n;
+  Name: detectOverload
 
-  n = sprintf(p,"/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/\n");
-  p += n;
+  Purpose: The purpose of this function is to decide whether or not an
+  IQ block overloaded the ADC, and to keep track of overload events.
+  An event starts with the first overloaded block and ends with the
+  next block that is not overloaded.  Its duration runs from the start
+  of its first block to the end of its last block.
 
-  // Terminate string.
-  *p = 0;
+  Calling Sequence: overloaded = detectOverload(me,
+                                                clippedCount,
+                                                sampleCount)
 
-  return;
+  Inputs:
 
-} // agc_displayInternalInformation
+    me - A pointer to the AGC instance.
 
+    clippedCount - The number of clipped samples in the block.
 
-//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-// Static functions.
-//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+    sampleCount - The number of samples in the block.
 
-/**************************************************************************
+  Outputs:
 
-  Name: resetBlankingSystem
+    overloaded - A flag that indicates whether or not the block
+    overloaded the ADC.
 
-  Purpose: The purpose of this function is to reset the blanking system
-  to its starting state.
+**************************************************************************/
+int detectOverload(struct agcInstance *me,
+    uint32_t clippedCount,
+    uint32_t sampleCount)
+{
+  int overloaded;
+  uint64_t duration;
 
-  Calling Sequence: resetBlankingSystem()
+  overloaded = (me->config.overloadLimit != 0) &&
+               (clippedCount >= me->config.overloadLimit);
 
-  Inputs:
+  if (overloaded)
+  {
+    me->counters.overloadBlockCount++;
 
-    None.
+    if (!me->overloadActive)
+    {
+      // A new event, which started with this block.
+      me->overloadActive = 1;
+      me->overloadStartTime = me->currentTime - sampleCount;
+      me->overloadClippedCount = 0;
 
-  Outputs:
+      me->counters.overloadEventCount++;
+    } // if
 
-    None.
+    me->overloadEndTime = me->currentTime;
+    me->overloadClippedCount += clippedCount;
+  } // if
+  else
+  {
+    if (me->overloadActive)
+    {
+      // The event is over.
+      me->overloadActive = 0;
 
-**************************************************************************/
-void resetBlankingSystem(void)
-{
+      duration = me->overloadEndTime - me->overloadStartTime;
 
-  // Reset the counter for the next blanking interval.
-  me.blankingCounter = 0;
+      me->lastOverloadDuration = duration;
+      me->lastOverloadClippedCount = me->overloadClippedCount;
 
-  // Ensure that the AGC can run the next time.
-  me.gainWasAdjusted = 0;
+      if (duration > me->longestOverloadDuration)
+      {
+        me->longestOverloadDuration = duration;
+      } // if
+    } // if
+  } // else
 
-  return;
+  return (overloaded);
 
-} // resetBlankingSystem
+} // detectOverload
 
 /**************************************************************************
 
   Name: run
 
   Purpose: The purpose of this function is to run the selected automatic
-  gain control algorithm.
+  gain control algorithm.  The magnitudes are given to the signal
+  detector, and the algorithm acts on the detected level once the
+  detector's window is full.  While the window fills, the invocation
+  is treated as blanked.  Magnitudes are not given to the detector
+  while the AGC is blanked.  When the ADC is overloaded, the gain is
+  cut at once instead, whether or not the AGC is blanked.
  
-  Calling Sequence: run(signalMagnitude)
+  Calling Sequence: run(me,signalMagnitudePtr,count,overloaded)
 
   Inputs:
 
-    signalMagnitude - The magnitude of the signal.
+    me - A pointer to the AGC instance.
+
+    signalMagnitudePtr - A pointer to the magnitudes of the signal.
+
+    count - The number of magnitudes.
+
+    overloaded - A flag that indicates whether or not the ADC is
+    overloaded.
 
   Outputs:
 
     None.
 
 **************************************************************************/
-void run(uint32_t signalMagnitude)
+void run(struct agcInstance *me,
+    const uint32_t *signalMagnitudePtr,
+    uint32_t count,
+    int overloaded)
 {
   int allowedToRun;
-  uint32_t adjustableGain;
+  uint32_t signalMagnitude;
+  int32_t signalInDbFs;
+  int32_t signalInDbFsQ8;
+  struct agcTraceRecorder *traceRecorderPtr;
+  struct agcCounters previousCounters;
 
  // Default to not being able to run.
   allowedToRun = 0;
 
+  me->counters.invocationCount++;
+
+  traceRecorderPtr = me->config.traceRecorderPtr;
+
+  if (traceRecorderPtr != NULL)
+  {
+    // The trace tells what happened from the change in the counters.
+    previousCounters = me->counters;
+  } // if
+
   //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
   // This block of code deals with the case where some external
   // entity adjusted the receiver IF gain without knowledge of
@@ -674,51 +4926,113 @@ void run(uint32_t signalMagnitude)
   // inconsistancy can occur between the hardware setting of
   // the IF gain, and the AGC's idea of what the gain should be.
   //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-  adjustableGain = getHardwareGainInDb();
+  // The hardware is behind while a gain write is outstanding.
+  if (!isGainWritePending(me))
+  {
+    synchronizeGain(me);
+  } // if
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // This block of code ensures that if a gain adjustment was
+  // made by the AGC, the system will blank itself for an
+  // interval specified by the blankingLimit parameter, or by
+  // the blankingDuration parameter in the duration blanking
+  // mode.  If the parameter is set to zero, blanking will be
+  // disabled.  Note that if a gain adjustment was not made,
+  // the AGC will be allowed to run.  This allows the AGC to
+  // react quickly to signal changes.  When the gain actuator
+  // is running, the blanking interval starts when the hardware
+  // has actually been given the new gain.  An overloaded ADC
+  // can't wait for blanking or for the lowpass filter, so the
+  // gain is cut right away.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  if (overloaded)
+  {
+    runFastAttack(me,*signalMagnitudePtr);
+  } // if
+  else
+  {
+    if (me->gainWasAdjusted)
+    {
+      if (isBlankingComplete(me))
+      {
+        // We're done blanking.
+        resetBlankingSystem(me);
+
+        // Let the AGC run.
+        allowedToRun = 1;
+      } // if
+    } // if
+    else
+    {
+      // Let the AGC run if no gain adjustment was made.
 
-  if (me.gainInDb != adjustableGain)
-  {
-    me.gainInDb = adjustableGain;
-  } // if
+      allowedToRun = 1;
+    } // else
+  } // else
   //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
 
   //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-  // This block of code ensures that if a gain adjustment was
-  // made by the AGC, the system will blank itself for an
-  // interval specified by the blankingLimit parameter.  If the
-  // blankingLimit parameter is set to zero, blanking will be
-  // disabled.  Note that if a gain adjustment was not made,
-  // the AGC will be allowed to run.  This allows the AGC to
-  // react quickly to signal changes.
+  // Detect the signal.  A single magnitude without a detector
+  // needs no work.
   //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-  if (me.gainWasAdjusted)
+  signalMagnitude = 0;
+  signalInDbFs = 0;
+
+  if (allowedToRun)
   {
-    if (me.blankingCounter < me.blankingLimit)
+    if ((me->detector.mode == DETECTOR_NONE) && (count == 1))
     {
-      // The systemn is still blanked.
-      me.blankingCounter++;
+      signalMagnitude = *signalMagnitudePtr;
+
+      // Convert to decibels referenced to full scale.
+      signalInDbFs = dbfsCalculator_convertMagnitudeToDbFs(&me->dbfs,
+                                                           signalMagnitude);
     } // if
     else
     {
-      // We're done blanking.
-      resetBlankingSystem();
+      signalDetector_accept(&me->detector,signalMagnitudePtr,count);
 
-      // Let the AGC run.
-      allowedToRun = 1;
+      allowedToRun = signalDetector_isReady(&me->detector);
+
+      if (allowedToRun)
+      {
+        // The detector measures in decibels referenced to full scale.
+        signalInDbFsQ8 = signalDetector_measure(&me->detector,
+                                                &signalMagnitude);
+
+        // Round to the nearest decibel, as the calculator does.
+        signalInDbFs = (signalInDbFsQ8 + (1 << (DBFS_FRACTIONAL_BITS - 1))) >>
+          DBFS_FRACTIONAL_BITS;
+      } // if
     } // else
   } // if
-  else
-  {
-    // Let the AGC run if no gain adjustment was made.
-
-    allowedToRun = 1;
-  } // else
   //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
 
   if (allowedToRun)
   {
-    runHarris(signalMagnitude);
+    runHarris(me,signalMagnitude,signalInDbFs);
   } // of
+  else
+  {
+    if (!overloaded)
+    {
+      me->counters.blankedCount++;
+    } // if
+  } // else
+
+  if (traceRecorderPtr != NULL)
+  {
+    recordTrace(me,
+                traceRecorderPtr,
+                &previousCounters,
+                allowedToRun,
+                overloaded);
+  } // if
+
+  // Let monitoring threads see what happened.
+  publishStatistics(me);
 
   return;
 
@@ -766,34 +5080,39 @@ void run(uint32_t signalMagnitude)
     g(n+1) = g(n) + [alpha * e(n)]
 
 
-  Calling Sequence: runHarris(signalIndBFs)
+  Calling Sequence: runHarris(me,signalMagnitude,signalInDbFs)
 
   Inputs:
 
-    signalMagnitude - The magnitude og the signal.
+    me - A pointer to the AGC instance.
+
+    signalMagnitude - The magnitude og the signal, for display.
+
+    signalInDbFs - The signal level in decibels referenced to full
+    scale, x(n) + g(n).
 
   Outputs:
 
     None.
 
 **************************************************************************/
-void runHarris(uint32_t signalMagnitude)
+void runHarris(struct agcInstance *me,
+    uint32_t signalMagnitude,
+    int32_t signalInDbFs)
 {
-  int success;
-  int32_t signalIndBFs;
   int32_t gainError;
+  uint32_t previousGainInDb;
 
   // Update for display purposes.
-  me.signalMagnitude = signalMagnitude;
-
-  // Convert to decibels referenced to full scale.
-  signalIndBFs = dbfs_convertMagnitudeToDbFs(signalMagnitude);
-
-  // Update for display purposes.
-  me.normalizedSignalLevelInDbFs = signalIndBFs - me.gainInDb;
+  me->signalMagnitude = signalMagnitude;
+  me->signalInDbFs = signalInDbFs;
+  me->normalizedSignalLevelInDbFs = signalInDbFs - me->gainInDb;
 
   // Compute the gain adjustment.
-  gainError = me.operatingPointInDbFs - signalIndBFs;
+  gainError = me->config.operatingPointInDbFs - signalInDbFs;
+
+  // Update for trace purposes.
+  me->gainError = gainError;
 
   //**************************************************
   // Make sure that we aren't at the gain rails.  If
@@ -804,55 +5123,49 @@ void runHarris(uint32_t signalMagnitude)
   // we don't want to make an adjustment.  This is
   // easily solved by setting the gain error to zero.
   //************************************************** 
-  if (me.gainInDb == me.maxAmplifierGainInDb)
+  if (me->gainInDb == me->maxAmplifierGainInDb)
   {
     if (gainError > 0)
     {
       gainError = 0;
+      me->counters.maxGainClampCount++;
     } // if
   } // if
   else
   {
-    if (me.gainInDb == 0)
+    if (me->gainInDb == me->minAmplifierGainInDb)
     {
       if (gainError < 0)
       {
         gainError = 0;
+        me->counters.minGainClampCount++;
       } // if
     } // if
   } // else
   //**************************************************
 
   // Apply deadband to eliminate gain oscillations.
-  if (abs(gainError) <= me.deadbandInDb)
+  if (abs(gainError) <= me->config.deadbandInDb)
   {
+    if (gainError != 0)
+    {
+      me->counters.deadbandSuppressionCount++;
+    } // if
+
     gainError = 0;
   } // if
 
-  //*******************************************************************
-  // Run the AGC algorithm.
-  //*******************************************************************
-  me.filteredGainInDb = me.filteredGainInDb +
-    (me.alpha * (float)gainError);
-
-  //+++++++++++++++++++++++++++++++++++++++++++
-  // Limit the gain to valid values.
-  //+++++++++++++++++++++++++++++++++++++++++++
-  if (me.filteredGainInDb > me.maxAmplifierGainInDb)
-  {
-    me.filteredGainInDb = me.maxAmplifierGainInDb;
-  } // if
-  else
-  {
-    if (me.filteredGainInDb < 0)
-    {
-      me.filteredGainInDb = 0;
-    } // if
-  } // else
-  //*******************************************************************
+  // Run the AGC algorithm, and limit the gain to valid values.
+  me->filteredGainInDb =
+    agcControlLaw_update(me->filteredGainInDb,
+                         me->config.alpha,
+                         gainError,
+                         (int32_t)me->minAmplifierGainInDb,
+                         (int32_t)me->maxAmplifierGainInDb);
 
-  // Update the attribute.
-  me.gainInDb = (uint32_t)me.filteredGainInDb;
+  // Update the attribute with the nearest gain that can be set.
+  previousGainInDb = me->gainInDb;
+  me->gainInDb = quantizeGain(me,agcControlLaw_gainToDb(me->filteredGainInDb));
 
   //+++++++++++++++++++++++++++++++++++++++++++++++++++
   // Update the receiver gain parameters.
@@ -861,11 +5174,24 @@ void runHarris(uint32_t signalMagnitude)
   // This way, we're nicer to the hardware.
   if (gainError != 0)
   {
-    // Update the receiver gain parameters.
-    setHardwareGainInDb(me.gainInDb);
-
-    // Indicate that the gain was modified.
-    me.gainWasAdjusted = 1;
+    if ((me->gainStepCount == 0) && (me->gainStageCount == 0))
+    {
+      applyGainAdjustment(me);
+    } // if
+    else
+    {
+      //+++++++++++++++++++++++++++++++++++++++++++++++++++
+      // With a gain table or gain stages, the filtered
+      // gain can move for many invocations without
+      // reaching another step, so a write that would not
+      // change the hardware, and the blanking and the
+      // detector restart that go with it, are skipped.
+      //+++++++++++++++++++++++++++++++++++++++++++++++++++
+      if (me->gainInDb != previousGainInDb)
+      {
+        applyGainAdjustment(me);
+      } // if
+    } // else
   } // if
   //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
 
@@ -873,6 +5199,324 @@ void runHarris(uint32_t signalMagnitude)
 
 } // runHarris
 
+/**************************************************************************
+
+  Name: runFastAttack
+
+  Purpose: The purpose of this function is to respond to an overloaded
+  ADC.  The gain is cut by the overload gain cut, limited by the
+  minimum gain, without waiting for blanking to end and without the
+  lowpass filter, which would otherwise keep the ADC clipped for
+  several blocks.  With a gain table, the nearest step is taken, and at
+  least the step below.  The filter continues from the new gain, and the
+  blanking interval starts over once the hardware has it.  While a
+  cut is on its way to the hardware, the blocks that follow were still
+  digitized with the old gain, so they don't cut the gain again.
+
+  Calling Sequence: runFastAttack(me,signalMagnitude)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    signalMagnitude - The magnitude of the signal.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void runFastAttack(struct agcInstance *me,uint32_t signalMagnitude)
+{
+  uint32_t gainCutInDb;
+  uint32_t gainInDb;
+
+  // Update for display purposes.
+  me->signalMagnitude = signalMagnitude;
+  me->signalInDbFs = dbfsCalculator_convertMagnitudeToDbFs(&me->dbfs,
+                                                           signalMagnitude);
+  me->normalizedSignalLevelInDbFs = me->signalInDbFs - me->gainInDb;
+
+  // Update for trace purposes.
+  me->gainError = me->config.operatingPointInDbFs - me->signalInDbFs;
+
+  if (!isGainWritePending(me))
+  {
+    if (me->gainInDb == me->minAmplifierGainInDb)
+    {
+      // There is no gain left to cut.
+      me->counters.minGainClampCount++;
+    } // if
+    else
+    {
+      gainCutInDb = me->config.overloadGainCutInDb;
+
+      if (gainCutInDb > (me->gainInDb - me->minAmplifierGainInDb))
+      {
+        gainCutInDb = me->gainInDb - me->minAmplifierGainInDb;
+      } // if
+
+      gainInDb = quantizeGain(me,me->gainInDb - gainCutInDb);
+
+      if (gainInDb == me->gainInDb)
+      {
+        // The cut is smaller than the step below, so take that step.
+        gainInDb = me->gainStepInDb[me->gainStepMap[me->gainInDb] - 1];
+      } // if
+
+      me->gainInDb = gainInDb;
+
+      // The filter continues from the new gain.
+      me->filteredGainInDb = agcControlLaw_gainFromDb(me->gainInDb);
+
+      // Blanking starts over with the new gain.
+      me->blankingCounter = 0;
+
+      applyGainAdjustment(me);
+    } // else
+  } // if
+
+  return;
+
+} // runFastAttack
+
+/**************************************************************************
+
+  Name: applyGainAdjustment
+
+  Purpose: The purpose of this function is to give the hardware the new
+  gain, either directly or through the gain actuator, and to start the
+  blanking interval that follows a gain adjustment.
+
+  Calling Sequence: applyGainAdjustment(me)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void applyGainAdjustment(struct agcInstance *me)
+{
+
+  // Measure the time since the previous gain was applied.
+  recordGainAdjustment(me);
+
+  me->counters.gainWriteCount++;
+
+  // Update the receiver gain parameters.
+  if (me->config.gainActuatorEnabled)
+  {
+    // Let the actuator thread deal with the hardware.
+    postGainRequest(me,me->gainInDb);
+  } // if
+  else
+  {
+    setHardwareGainInDb(me,me->gainInDb);
+
+    // The hardware has the gain now.
+    me->gainApplied = 1;
+    me->gainAppliedTime = me->currentTime;
+  } // else
+
+  // Indicate that the gain was modified.
+  me->gainWasAdjusted = 1;
+
+  // The detector's window was measured with the old gain.
+  signalDetector_reset(&me->detector);
+
+  return;
+
+} // applyGainAdjustment
+
+/**************************************************************************
+
+  Name: updateResidualGain
+
+  Purpose: The purpose of this function is to compute the ramp of the
+  residual gain for the next IQ block.  The residual gain is the part of
+  the filtered gain that the truncation to whole decibels drops, so it
+  lies in [0,1) decibels.  The filtered gain can be below the hardware
+  gain only transiently, for example after an external gain change, and
+  unity gain is used then.  When the stage is disabled, or the AGC is
+  not running, the target is unity gain.
+
+  Calling Sequence: needed = updateResidualGain(me,
+                                                &startGain,
+                                                &endGain)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+    startGainPtr - A pointer to storage for the linear gain before the
+    block.
+
+    endGainPtr - A pointer to storage for the linear gain of the last
+    sample of the block.
+
+  Outputs:
+
+    needed - A flag that indicates whether or not the gain has to be
+    applied.  A value of 0 indicates unity gain throughout the block.
+
+**************************************************************************/
+int updateResidualGain(struct agcInstance *me,
+    float *startGainPtr,
+    float *endGainPtr)
+{
+  int needed;
+  int32_t residualQ16;
+  float targetGain;
+
+  // Default to unity gain.
+  targetGain = 1;
+
+  if (me->initialized)
+  {
+    // Pick up any parameter changes.
+    applyConfigurationUpdates(me);
+
+    if ((me->config.enabled) && (me->config.residualGainEnabled))
+    {
+      residualQ16 = agcControlLaw_gainToQ16(me->filteredGainInDb) -
+        ((int32_t)me->gainInDb << AGC_GAIN_FRACTIONAL_BITS);
+
+      if ((residualQ16 > 0) &&
+          (residualQ16 < (1 << AGC_GAIN_FRACTIONAL_BITS)))
+      {
+        targetGain = powf(10.0f,
+          (float)residualQ16 / (20.0f * (1 << AGC_GAIN_FRACTIONAL_BITS)));
+      } // if
+    } // if
+  } // if
+
+  *startGainPtr = me->residualGain;
+  *endGainPtr = targetGain;
+
+  needed = (me->residualGain != 1) || (targetGain != 1);
+
+  // The next block starts where this one ends.
+  me->residualGain = targetGain;
+
+  return (needed);
+
+} // updateResidualGain
+
+/**************************************************************************
+
+  Name: synchronizeGain
+
+  Purpose: The purpose of this function is to bring the AGC's idea of
+  the gain in line with the hardware, in case some other entity changed
+  the gain.  In the poll mode, the application is asked for the gain.
+  In the notify mode, the gain is only updated when the application has
+  reported a change through agcInstance_notifyExternalGainChange(), so
+  no callback is invoked when nobody else touches the gain.
+
+  Calling Sequence: synchronizeGain(me)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void synchronizeGain(struct agcInstance *me)
+{
+  uint32_t adjustableGain;
+  uint64_t change;
+
+  if (me->config.gainSyncMode == AGC_GAIN_SYNC_NOTIFY)
+  {
+    change = __atomic_load_n(&me->externalGainChange,__ATOMIC_ACQUIRE);
+
+    if ((uint32_t)(change >> 32) != me->externalGainGeneration)
+    {
+      // Somebody changed the gain.
+      me->externalGainGeneration = (uint32_t)(change >> 32);
+
+      if (decodeGainSetting(me,(uint32_t)change,&adjustableGain))
+      {
+        me->gainInDb = adjustableGain;
+
+        // Continue filtering from the new gain.
+        me->filteredGainInDb = agcControlLaw_gainFromDb(adjustableGain);
+
+        // Start detecting at the new gain.
+        signalDetector_reset(&me->detector);
+      } // if
+    } // if
+  } // if
+  else
+  {
+    adjustableGain = getHardwareGainInDb(me);
+
+    if (me->gainInDb != adjustableGain)
+    {
+      me->gainInDb = adjustableGain;
+
+      // Start detecting at the new gain.
+      signalDetector_reset(&me->detector);
+    } // if
+  } // else
+
+  return;
+
+} // synchronizeGain
+
+/**************************************************************************
+
+  Name: publishStatistics
+
+  Purpose: The purpose of this function is to publish the loop state and
+  the counters for agcInstance_getStats().  The sample thread is the
+  only writer.  The sequence number is odd while the statistics are
+  being updated, so that a reader can detect a torn copy and retry.
+
+  Calling Sequence: publishStatistics(me)
+
+  Inputs:
+
+    me - A pointer to the AGC instance.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void publishStatistics(struct agcInstance *me)
+{
+  uint32_t sequence;
+
+  sequence = me->statsSequence;
+
+  __atomic_store_n(&me->statsSequence,sequence + 1,__ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  me->publishedStats.blankingCounter = me->blankingCounter;
+  me->publishedStats.gainInDb = me->gainInDb;
+  me->publishedStats.signalMagnitude = me->signalMagnitude;
+  me->publishedStats.signalInDbFs = me->signalInDbFs;
+  me->publishedStats.normalizedSignalLevelInDbFs =
+    me->normalizedSignalLevelInDbFs;
+  me->publishedStats.lastOverloadDuration = me->lastOverloadDuration;
+  me->publishedStats.longestOverloadDuration = me->longestOverloadDuration;
+  me->publishedStats.lastOverloadClippedCount = me->lastOverloadClippedCount;
+  me->publishedStats.counters = me->counters;
+
+  __atomic_store_n(&me->statsSequence,sequence + 2,__ATOMIC_RELEASE);
+
+  return;
+
+} // publishStatistics
+
 /**************************************************************************
 
   Name: setHardwareGainInDb
@@ -881,12 +5525,16 @@ void runHarris(uint32_t signalMagnitude)
   variable gain amplifier in the hardware.
   It is the responsibility of the callback function to set the hardware
   gain since the user application is the entity that actually sets the
-  gain.
+  gain.  With a gain table, the callback is given the index of the step,
+  and with gain stages, one lookup gives the gains of all of the stages,
+  which are handed to the callback together.
 
-  Calling Sequence: setHardwareGainInDb(gainInDb)
+  Calling Sequence: setHardwareGainInDb(me,gainInDb)
 
   Inputs:
 
+    me - A pointer to the AGC instance.
+
     gain - The gain in decibels.
 
   Outputs:
@@ -894,17 +5542,41 @@ void runHarris(uint32_t signalMagnitude)
     None.
 
 **************************************************************************/
-void setHardwareGainInDb(uint32_t gainInDb)
+void setHardwareGainInDb(struct agcInstance *me,uint32_t gainInDb)
 {
 
   // The client callback will perform hardware-centric processing.
-  if (me.setGainCallbackPtr != 0)
+  if (me->setGainCallbackPtr != 0)
   {
-    if (gainInDb <= me.maxAmplifierGainInDb)
+    if (gainInDb <= me->maxAmplifierGainInDb)
     {
+      AGC_LATENCY_START(startTime);
+
+      if (me->gainStepCount != 0)
+      {
+        // The gain is a step, so the application wants its index.
+        gainInDb = me->gainStepMap[gainInDb];
+      } // if
+
       // The gain is in range.
-    me.setGainCallbackPtr(gainInDb);
-   } // if
+      me->setGainCallbackPtr(me->contextPtr,gainInDb);
+
+      AGC_LATENCY_STOP(&me->latency[AGC_LATENCY_SET_GAIN_CALLBACK],startTime);
+    } // if
+  } // if
+
+  // A multi-stage amplifier is given the gains of all of its stages.
+  if (me->setStageGainsCallbackPtr != 0)
+  {
+    if (gainInDb <= me->maxAmplifierGainInDb)
+    {
+      AGC_LATENCY_START(startTime);
+
+      me->setStageGainsCallbackPtr(me->contextPtr,
+                                   me->stageGainInDb[gainInDb]);
+
+      AGC_LATENCY_STOP(&me->latency[AGC_LATENCY_SET_GAIN_CALLBACK],startTime);
+    } // if
   } // if
 
   return;
@@ -921,12 +5593,16 @@ void setHardwareGainInDb(uint32_t gainInDb)
   had made any gain changes. In my opioion, the AGC should be disabled if
   the user wants to manually change the gain.  The only reason this
   function is needed is to avoid inconnsistancy between the gain that the
-  user manually set and what the AGC automatically set.
+  user manually set and what the AGC automatically set.  With a gain
+  table, the callback returns the index of the step, and with gain
+  stages, it returns the gain of each stage.
 
-  Calling Sequence: gainInDb = getHardwareGainInDb()
+  Calling Sequence: gainInDb = getHardwareGainInDb(me)
 
   Inputs:
 
+    me - A pointer to the AGC instance.
+
     signalIndB- The gain in decibels.
 
   Outputs:
@@ -934,22 +5610,60 @@ void setHardwareGainInDb(uint32_t gainInDb)
     None.
 
 **************************************************************************/
-uint32_t getHardwareGainInDb(void)
+uint32_t getHardwareGainInDb(struct agcInstance *me)
 {
+  int valid;
+  uint32_t i;
   uint32_t gainInDb;
+  uint32_t setting;
+  uint32_t stageGainInDb[AGC_MAX_GAIN_STAGES];
 
   // Default if we don't have a cient callback function.
-  gainInDb = me.gainInDb;
+  gainInDb = me->gainInDb;
 
  // The client callback will perform hardware-centric processing.
-  if (me.getGainCallbackPtr != 0)
+  if (me->getGainCallbackPtr != 0)
   {
-    gainInDb = me.getGainCallbackPtr();
+    AGC_LATENCY_START(startTime);
 
-    if (gainInDb > me.maxAmplifierGainInDb)
+    setting = me->getGainCallbackPtr(me->contextPtr);
+
+    AGC_LATENCY_STOP(&me->latency[AGC_LATENCY_GET_GAIN_CALLBACK],startTime);
+
+    if (!decodeGainSetting(me,setting,&gainInDb))
     {
       // The gain is out of range.
-      gainInDb = me.gainInDb;
+      gainInDb = me->gainInDb;
+    } // if
+  } // if
+
+  // The gain of a multi-stage amplifier is the sum of its stage gains.
+  if (me->getStageGainsCallbackPtr != 0)
+  {
+    AGC_LATENCY_START(startTime);
+
+    me->getStageGainsCallbackPtr(me->contextPtr,stageGainInDb);
+
+    AGC_LATENCY_STOP(&me->latency[AGC_LATENCY_GET_GAIN_CALLBACK],startTime);
+
+    valid = 1;
+    setting = 0;
+
+    for (i = 0; i < me->gainStageCount; i++)
+    {
+      if ((stageGainInDb[i] < me->gainStage[i].minGainInDb) ||
+          (stageGainInDb[i] > me->gainStage[i].maxGainInDb))
+      {
+        // The gain is out of range, so the sum can't be trusted.
+        valid = 0;
+      } // if
+
+      setting += stageGainInDb[i];
+    } // for
+
+    if (valid)
+    {
+      gainInDb = setting;
     } // if
   } // if
  
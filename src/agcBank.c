@@ -0,0 +1,884 @@
+//**************************************************************************
+// file name: agcBank.c
+//**************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "agcBank.h"
+#include "dbfsCalculator.h"
+
+// Define AGC_BANK_SCALAR_ONLY to leave out the vector kernel, so that
+// every channel is processed by runScalar().
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    !defined(AGC_BANK_SCALAR_ONLY)
+#define X86_KERNELS
+#include <immintrin.h>
+#endif
+
+// Each array starts on its own cache line.
+#define BANK_CACHE_LINE_SIZE (64)
+
+// The number of channels that the vector kernel processes at a time.
+#define CHANNELS_PER_VECTOR (8)
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// All private stuff is bundled in one structure.  The per-channel
+// attributes are stored as parallel arrays that are indexed by channel
+// number, so the same attribute of consecutive channels is contiguous
+// in memory.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+struct agcBank
+{
+  // Don't run unless the bank has been initialized.
+  int initialized;
+
+  uint32_t channelCount;
+
+  // The maximum amplifier gain in decibels, common to all channels.
+  int32_t maxAmplifierGainInDb;
+
+  // Converts signal magnitudes to dBFs.
+  struct dbfsCalculator dbfs;
+
+  // The setpoints.
+  int32_t *operatingPointInDbFs;
+
+  // AGC lowpass filter coefficients.
+  float *alpha;
+
+  // Deadbands in decibels.
+  int32_t *deadbandInDb;
+
+  // Blanking parameters.
+  int32_t *blankingLimit;
+  int32_t *blankingCounter;
+  int32_t *gainWasAdjusted;
+
+  // Filtered gains.
+  float *filteredGainInDb;
+
+  // System gains.
+  uint32_t *gainInDb;
+
+  // Scratch storage for the Q8 signal levels of one pass.
+  int32_t *signalInDbFsQ8;
+
+  // All arrays are carved out of this block.
+  void *storagePtr;
+};
+
+static void *carveArray(uint8_t **nextPtrPtr,uint32_t channelCount);
+static void runScalar(struct agcBank *me,
+    uint32_t firstChannel,
+    uint32_t lastChannel);
+
+#ifdef X86_KERNELS
+static void runAvx2(struct agcBank *me,uint32_t channelCount);
+#endif
+
+/**************************************************************************
+
+  Name: agcBank_create
+
+  Purpose: The purpose of this function is to allocate a bank of AGC's.
+  The bank must be initialized by agcBank_init() before it is used.
+
+  Calling Sequence: bankPtr = agcBank_create(channelCount)
+
+  Inputs:
+
+    channelCount - The number of channels in the bank.
+
+  Outputs:
+
+    bankPtr - A pointer to the bank.  A value of NULL indicates that
+    memory could not be allocated.
+
+**************************************************************************/
+struct agcBank *agcBank_create(uint32_t channelCount)
+{
+  struct agcBank *me;
+  uint8_t *nextPtr;
+  size_t arraySize;
+
+  if (channelCount == 0)
+  {
+    // There is nothing to control.
+    return (NULL);
+  } // if
+
+  me = (struct agcBank *)calloc(1,sizeof(struct agcBank));
+
+  if (me != NULL)
+  {
+    me->channelCount = channelCount;
+
+    // Round each array up to a whole number of cache lines.
+    arraySize = ((channelCount * sizeof(int32_t)) + BANK_CACHE_LINE_SIZE - 1) &
+      ~(size_t)(BANK_CACHE_LINE_SIZE - 1);
+
+    if (posix_memalign(&me->storagePtr,
+                       BANK_CACHE_LINE_SIZE,
+                       arraySize * 9) != 0)
+    {
+      free(me);
+      return (NULL);
+    } // if
+
+    memset(me->storagePtr,0,arraySize * 9);
+
+    nextPtr = (uint8_t *)me->storagePtr;
+
+    me->operatingPointInDbFs = (int32_t *)carveArray(&nextPtr,channelCount);
+    me->alpha = (float *)carveArray(&nextPtr,channelCount);
+    me->deadbandInDb = (int32_t *)carveArray(&nextPtr,channelCount);
+    me->blankingLimit = (int32_t *)carveArray(&nextPtr,channelCount);
+    me->blankingCounter = (int32_t *)carveArray(&nextPtr,channelCount);
+    me->gainWasAdjusted = (int32_t *)carveArray(&nextPtr,channelCount);
+    me->filteredGainInDb = (float *)carveArray(&nextPtr,channelCount);
+    me->gainInDb = (uint32_t *)carveArray(&nextPtr,channelCount);
+    me->signalInDbFsQ8 = (int32_t *)carveArray(&nextPtr,channelCount);
+  } // if
+
+  return (me);
+
+} // agcBank_create
+
+/**************************************************************************
+
+  Name: agcBank_destroy
+
+  Purpose: The purpose of this function is to release the resources of
+  a bank that was allocated by agcBank_create().
+
+  Calling Sequence: agcBank_destroy(me)
+
+  Inputs:
+
+    me - A pointer to the bank.  A value of NULL is ignored.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void agcBank_destroy(struct agcBank *me)
+{
+
+  if (me != NULL)
+  {
+    free(me->storagePtr);
+    free(me);
+  } // if
+
+  return;
+
+} // agcBank_destroy
+
+/**************************************************************************
+
+  Name: agcBank_init
+
+  Purpose: The purpose of this function is to initialize all channels
+  of a bank.  Each channel starts with the same defaults as an AGC that
+  was initialized by agc_init().
+
+  Calling Sequence: initialized = agcBank_init(me,
+                                               operatingPointInDbFs,
+                                               maxAmplifierGainInDb,
+                                               signalMagnitudeBitCount)
+
+  Inputs:
+
+    me - A pointer to the bank.
+
+    operatingPointInDbFs - The AGC operating point in decibels referenced
+    to full scale.
+
+    maxAmplifierGainInDb - The maximum gain of the amplifiers in
+    decibels.
+
+    signalMagnitudeBitCount - The number of magnitude bits in a signal.
+
+  Outputs:
+
+    initialized - A flag that indicate whether the bank was properly
+    initialized, and a value of zero indicates that was not initialized.
+
+**************************************************************************/
+int agcBank_init(struct agcBank *me,
+    int32_t operatingPointInDbFs,
+    uint32_t maxAmplifierGainInDb,
+    uint32_t signalMagnitudeBitCount)
+{
+  uint32_t channel;
+
+  // Make sure this indicates we're not initialized.
+  me->initialized = 0;
+
+  me->maxAmplifierGainInDb = maxAmplifierGainInDb;
+
+  for (channel = 0; channel < me->channelCount; channel++)
+  {
+    me->operatingPointInDbFs[channel] = operatingPointInDbFs;
+    me->alpha[channel] = 0.8;
+    me->deadbandInDb[channel] = 1;
+    me->blankingLimit[channel] = 1;
+    me->blankingCounter[channel] = 0;
+    me->gainWasAdjusted[channel] = 0;
+    me->filteredGainInDb[channel] = 24;
+    me->gainInDb[channel] = 24;
+  } // for
+
+  // Initialize the DbFS calculator.
+  me->initialized = dbfsCalculator_init(&me->dbfs,signalMagnitudeBitCount);
+
+  return (me->initialized);
+
+} // agcBank_init
+
+/**************************************************************************
+
+  Name: agcBank_setOperatingPoint
+
+  Purpose: The purpose of this function is to set the operating point
+  of a channel.
+
+  Calling Sequence: success = agcBank_setOperatingPoint(me,
+                                                        channel,
+                                                        operatingPointInDbFs)
+
+  Inputs:
+
+    me - A pointer to the bank.
+
+    channel - The channel number.
+
+    operatingPointInDbFs - The operating point in decibels referenced to
+    the full scale value.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the operating point
+    was updated.  A value of 0 indicates an invalid channel.
+
+**************************************************************************/
+int agcBank_setOperatingPoint(struct agcBank *me,
+    uint32_t channel,
+    int32_t operatingPointInDbFs)
+{
+  int success;
+
+  // Default to failure.
+  success = 0;
+
+  if (channel < me->channelCount)
+  {
+    me->operatingPointInDbFs[channel] = operatingPointInDbFs;
+
+    success = 1;
+  } // if
+
+  return (success);
+
+} // agcBank_setOperatingPoint
+
+/**************************************************************************
+
+  Name: agcBank_setAgcFilterCoefficient
+
+  Purpose: The purpose of this function is to set the coefficient of
+  the gain lowpass filter of a channel.
+
+  Calling Sequence: success = agcBank_setAgcFilterCoefficient(me,
+                                                              channel,
+                                                              coefficient)
+
+  Inputs:
+
+    me - A pointer to the bank.
+
+    channel - The channel number.
+
+    coefficient - The filter coefficient.  Valid values are
+    0.001 <= coefficient < 0.999.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the coefficient was
+    updated.  A value of 0 indicates an invalid channel or coefficient.
+
+**************************************************************************/
+int agcBank_setAgcFilterCoefficient(struct agcBank *me,
+    uint32_t channel,
+    float coefficient)
+{
+  int success;
+
+  // Default to failure.
+  success = 0;
+
+  if (channel < me->channelCount)
+  {
+    if ((coefficient >= 0.001) && (coefficient < 0.999))
+    {
+      me->alpha[channel] = coefficient;
+
+      success = 1;
+    } // if
+  } // if
+
+  return (success);
+
+} // agcBank_setAgcFilterCoefficient
+
+/**************************************************************************
+
+  Name: agcBank_setDeadband
+
+  Purpose: The purpose of this function is to set the deadband of a
+  channel.
+
+  Calling Sequence: success = agcBank_setDeadband(me,channel,deadbandInDb)
+
+  Inputs:
+
+    me - A pointer to the bank.
+
+    channel - The channel number.
+
+    deadbandInDb - The deadband in decibels.  Valid values are [0,10].
+
+  Outputs:
+
+    success - A flag that indicates whether or not the deadband was
+    updated.  A value of 0 indicates an invalid channel or deadband.
+
+**************************************************************************/
+int agcBank_setDeadband(struct agcBank *me,
+    uint32_t channel,
+    uint32_t deadbandInDb)
+{
+  int success;
+
+  // Default to failure.
+  success = 0;
+
+  if (channel < me->channelCount)
+  {
+    if (deadbandInDb <= 10)
+    {
+      me->deadbandInDb[channel] = deadbandInDb;
+
+      success = 1;
+    } // if
+  } // if
+
+  return (success);
+
+} // agcBank_setDeadband
+
+/**************************************************************************
+
+  Name: agcBank_setBlankingLimit
+
+  Purpose: The purpose of this function is to set the blanking limit of
+  a channel.  The blanking system of the channel is reset.
+
+  Calling Sequence: success = agcBank_setBlankingLimit(me,
+                                                       channel,
+                                                       blankingLimit)
+
+  Inputs:
+
+    me - A pointer to the bank.
+
+    channel - The channel number.
+
+    blankingLimit - The number of invocations to ignore after a gain
+    adjustment.  Valid values are [0,10].
+
+  Outputs:
+
+    success - A flag that indicates whether or not the blanking limit was
+    updated.  A value of 0 indicates an invalid channel or limit.
+
+**************************************************************************/
+int agcBank_setBlankingLimit(struct agcBank *me,
+    uint32_t channel,
+    uint32_t blankingLimit)
+{
+  int success;
+
+  // Default to failure.
+  success = 0;
+
+  if (channel < me->channelCount)
+  {
+    if (blankingLimit <= 10)
+    {
+      me->blankingLimit[channel] = blankingLimit;
+
+      // Set the blanking system to its initial state.
+      me->blankingCounter[channel] = 0;
+      me->gainWasAdjusted[channel] = 0;
+
+      success = 1;
+    } // if
+  } // if
+
+  return (success);
+
+} // agcBank_setBlankingLimit
+
+/**************************************************************************
+
+  Name: agcBank_setGainInDb
+
+  Purpose: The purpose of this function is to inform the bank of the
+  gain of a channel.  The bank does not read the gains back from the
+  hardware, so the application calls this function if some other
+  entity changes the gain of a channel.
+
+  Calling Sequence: success = agcBank_setGainInDb(me,channel,gainInDb)
+
+  Inputs:
+
+    me - A pointer to the bank.
+
+    channel - The channel number.
+
+    gainInDb - The gain of the channel in decibels.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the gain was updated.
+    A value of 0 indicates an invalid channel or gain.
+
+**************************************************************************/
+int agcBank_setGainInDb(struct agcBank *me,
+    uint32_t channel,
+    uint32_t gainInDb)
+{
+  int success;
+
+  // Default to failure.
+  success = 0;
+
+  if (channel < me->channelCount)
+  {
+    if (gainInDb <= (uint32_t)me->maxAmplifierGainInDb)
+    {
+      me->gainInDb[channel] = gainInDb;
+
+      success = 1;
+    } // if
+  } // if
+
+  return (success);
+
+} // agcBank_setGainInDb
+
+/**************************************************************************
+
+  Name: agcBank_run
+
+  Purpose: The purpose of this function is to run the AGC algorithm of
+  every channel once.  Each channel behaves like an AGC that is invoked
+  via agc_acceptData(), including blanking, the gain rails and the
+  deadband, except that the gain is not read back from the hardware.
+  The signal magnitudes of all channels are converted to dBFs in one
+  call, and the gain update is performed 8 channels at a time when the
+  processor supports AVX2.
+
+  Calling Sequence: changedCount = agcBank_run(me,
+                                               signalMagnitudePtr,
+                                               changedChannelPtr)
+
+  Inputs:
+
+    me - A pointer to the bank.
+
+    signalMagnitudePtr - A pointer to the signal magnitudes, one per
+    channel.
+
+    changedChannelPtr - A pointer to storage for the numbers of the
+    channels whose gain changed.  It must have room for one entry per
+    channel.  The new gains are available via agcBank_getGains().
+
+  Outputs:
+
+    changedCount - The number of channels whose gain changed.
+
+**************************************************************************/
+uint32_t agcBank_run(struct agcBank *me,
+    const uint32_t *signalMagnitudePtr,
+    uint32_t *changedChannelPtr)
+{
+  uint32_t channel;
+  uint32_t vectorChannelCount;
+  uint32_t changedCount;
+  uint32_t *previousGainPtr;
+
+  changedCount = 0;
+
+  if (!me->initialized)
+  {
+    return (0);
+  } // if
+
+  // Convert all magnitudes at once.
+  dbfsCalculator_convertBlock(&me->dbfs,
+                              signalMagnitudePtr,
+                              me->signalInDbFsQ8,
+                              me->channelCount);
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // The caller's list storage is used to remember the gains
+  // prior to the update so that the changed channels can be
+  // found after the pass.  The list never overtakes the
+  // channel being examined, so each previous gain is read
+  // before its slot is overwritten.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  previousGainPtr = changedChannelPtr;
+  memcpy(previousGainPtr,me->gainInDb,me->channelCount * sizeof(uint32_t));
+
+  vectorChannelCount = 0;
+
+#ifdef X86_KERNELS
+  if (__builtin_cpu_supports("avx2"))
+  {
+    vectorChannelCount =
+      me->channelCount - (me->channelCount % CHANNELS_PER_VECTOR);
+
+    runAvx2(me,vectorChannelCount);
+  } // if
+#endif
+
+  // Take care of the leftovers.
+  runScalar(me,vectorChannelCount,me->channelCount);
+
+  // Compact the list of channels whose gain changed.
+  for (channel = 0; channel < me->channelCount; channel++)
+  {
+    if (previousGainPtr[channel] != me->gainInDb[channel])
+    {
+      changedChannelPtr[changedCount] = channel;
+      changedCount++;
+    } // if
+  } // for
+
+  return (changedCount);
+
+} // agcBank_run
+
+/**************************************************************************
+
+  Name: agcBank_getGains
+
+  Purpose: The purpose of this function is to retrieve the gains of all
+  channels.
+
+  Calling Sequence: gainPtr = agcBank_getGains(me)
+
+  Inputs:
+
+    me - A pointer to the bank.
+
+  Outputs:
+
+    gainPtr - A pointer to the gains in decibels, indexed by channel.
+
+**************************************************************************/
+const uint32_t *agcBank_getGains(struct agcBank *me)
+{
+
+  return (me->gainInDb);
+
+} // agcBank_getGains
+
+/**************************************************************************
+
+  Name: agcBank_getChannelCount
+
+  Purpose: The purpose of this function is to retrieve the number of
+  channels in a bank.
+
+  Calling Sequence: channelCount = agcBank_getChannelCount(me)
+
+  Inputs:
+
+    me - A pointer to the bank.
+
+  Outputs:
+
+    channelCount - The number of channels.
+
+**************************************************************************/
+uint32_t agcBank_getChannelCount(struct agcBank *me)
+{
+
+  return (me->channelCount);
+
+} // agcBank_getChannelCount
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// Static functions.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+/**************************************************************************
+
+  Name: carveArray
+
+  Purpose: The purpose of this function is to carve a cache-line aligned
+  array out of the storage block.
+
+  Calling Sequence: arrayPtr = carveArray(&nextPtr,channelCount)
+
+  Inputs:
+
+    nextPtrPtr - A pointer to the next free location of the storage
+    block.  It is advanced past the array.
+
+    channelCount - The number of 32-bit entries in the array.
+
+  Outputs:
+
+    arrayPtr - A pointer to the array.
+
+**************************************************************************/
+static void *carveArray(uint8_t **nextPtrPtr,uint32_t channelCount)
+{
+  void *arrayPtr;
+  size_t arraySize;
+
+  arrayPtr = *nextPtrPtr;
+
+  arraySize = ((channelCount * sizeof(int32_t)) + BANK_CACHE_LINE_SIZE - 1) &
+    ~(size_t)(BANK_CACHE_LINE_SIZE - 1);
+
+  *nextPtrPtr += arraySize;
+
+  return (arrayPtr);
+
+} // carveArray
+
+/**************************************************************************
+
+  Name: runScalar
+
+  Purpose: The purpose of this function is to run the AGC algorithm of
+  a range of channels, one channel at a time.  This is the same
+  algorithm as run() and runHarris() in AutomaticGainControl.c.
+
+  Calling Sequence: runScalar(me,firstChannel,lastChannel)
+
+  Inputs:
+
+    me - A pointer to the bank.
+
+    firstChannel - The first channel to process.
+
+    lastChannel - One more than the last channel to process.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void runScalar(struct agcBank *me,
+    uint32_t firstChannel,
+    uint32_t lastChannel)
+{
+  uint32_t channel;
+  int32_t signalInDbFs;
+  int32_t gainError;
+  float filteredGainInDb;
+
+  for (channel = firstChannel; channel < lastChannel; channel++)
+  {
+    // Blanking.
+    if (me->gainWasAdjusted[channel])
+    {
+      if (me->blankingCounter[channel] < me->blankingLimit[channel])
+      {
+        // The channel is still blanked.
+        me->blankingCounter[channel]++;
+        continue;
+      } // if
+
+      // We're done blanking.
+      me->blankingCounter[channel] = 0;
+      me->gainWasAdjusted[channel] = 0;
+    } // if
+
+    // Round to the nearest decibel.
+    signalInDbFs = (me->signalInDbFsQ8[channel] +
+      (1 << (DBFS_FRACTIONAL_BITS - 1))) >> DBFS_FRACTIONAL_BITS;
+
+    gainError = me->operatingPointInDbFs[channel] - signalInDbFs;
+
+    // Make sure that we aren't at the gain rails.
+    if ((me->gainInDb[channel] == (uint32_t)me->maxAmplifierGainInDb) &&
+        (gainError > 0))
+    {
+      gainError = 0;
+    } // if
+
+    if ((me->gainInDb[channel] == 0) && (gainError < 0))
+    {
+      gainError = 0;
+    } // if
+
+    // Apply deadband to eliminate gain oscillations.
+    if (abs(gainError) <= me->deadbandInDb[channel])
+    {
+      gainError = 0;
+    } // if
+
+    filteredGainInDb = me->filteredGainInDb[channel] +
+      (me->alpha[channel] * (float)gainError);
+
+    // Limit the gain to valid values.
+    if (filteredGainInDb > me->maxAmplifierGainInDb)
+    {
+      filteredGainInDb = me->maxAmplifierGainInDb;
+    } // if
+    else
+    {
+      if (filteredGainInDb < 0)
+      {
+        filteredGainInDb = 0;
+      } // if
+    } // else
+
+    me->filteredGainInDb[channel] = filteredGainInDb;
+    me->gainInDb[channel] = (uint32_t)filteredGainInDb;
+
+    if (gainError != 0)
+    {
+      // Indicate that the gain was modified.
+      me->gainWasAdjusted[channel] = 1;
+    } // if
+  } // for
+
+  return;
+
+} // runScalar
+
+#ifdef X86_KERNELS
+/**************************************************************************
+
+  Name: runAvx2
+
+  Purpose: The purpose of this function is to run the AGC algorithm of
+  8 channels at a time.  Every decision of runScalar() is turned into a
+  lane mask, so all channels follow the same instruction stream.  A
+  blanked channel has its gain error forced to zero and keeps its gain.
+
+  Calling Sequence: runAvx2(me,channelCount)
+
+  Inputs:
+
+    me - A pointer to the bank.
+
+    channelCount - The number of channels to process, starting with
+    channel 0.  It must be a multiple of 8.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+__attribute__((target("avx2")))
+static void runAvx2(struct agcBank *me,uint32_t channelCount)
+{
+  uint32_t channel;
+  __m256i blanked;
+  __m256i counter;
+  __m256i signal;
+  __m256i gainError;
+  __m256i gain;
+  __m256i newGain;
+  __m256i suppressed;
+  __m256 filteredGain;
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i rounding = _mm256_set1_epi32(1 << (DBFS_FRACTIONAL_BITS - 1));
+  const __m256i maxGain = _mm256_set1_epi32(me->maxAmplifierGainInDb);
+  const __m256 maxGainFloat = _mm256_set1_ps((float)me->maxAmplifierGainInDb);
+
+  for (channel = 0; channel < channelCount; channel += CHANNELS_PER_VECTOR)
+  {
+    // Blanking.
+    counter = _mm256_load_si256((const __m256i *)&me->blankingCounter[channel]);
+    blanked = _mm256_and_si256(
+      _mm256_cmpgt_epi32(
+        _mm256_load_si256((const __m256i *)&me->gainWasAdjusted[channel]),
+        zero),
+      _mm256_cmpgt_epi32(
+        _mm256_load_si256((const __m256i *)&me->blankingLimit[channel]),
+        counter));
+
+    counter = _mm256_and_si256(blanked,_mm256_add_epi32(counter,one));
+    _mm256_store_si256((__m256i *)&me->blankingCounter[channel],counter);
+
+    // Round to the nearest decibel.
+    signal = _mm256_srai_epi32(_mm256_add_epi32(
+      _mm256_load_si256((const __m256i *)&me->signalInDbFsQ8[channel]),
+      rounding),DBFS_FRACTIONAL_BITS);
+
+    gainError = _mm256_sub_epi32(
+      _mm256_load_si256((const __m256i *)&me->operatingPointInDbFs[channel]),
+      signal);
+
+    gain = _mm256_load_si256((const __m256i *)&me->gainInDb[channel]);
+
+    // Gain rails, deadband and blanking all force the error to zero.
+    suppressed = _mm256_or_si256(blanked,
+      _mm256_and_si256(_mm256_cmpeq_epi32(gain,maxGain),
+                       _mm256_cmpgt_epi32(gainError,zero)));
+    suppressed = _mm256_or_si256(suppressed,
+      _mm256_and_si256(_mm256_cmpeq_epi32(gain,zero),
+                       _mm256_cmpgt_epi32(zero,gainError)));
+    suppressed = _mm256_or_si256(suppressed,
+      _mm256_andnot_si256(
+        _mm256_cmpgt_epi32(_mm256_abs_epi32(gainError),
+          _mm256_load_si256((const __m256i *)&me->deadbandInDb[channel])),
+        _mm256_set1_epi32(-1)));
+
+    gainError = _mm256_andnot_si256(suppressed,gainError);
+
+    // Run the AGC algorithm, and limit the gain to valid values.
+    filteredGain = _mm256_add_ps(
+      _mm256_load_ps(&me->filteredGainInDb[channel]),
+      _mm256_mul_ps(_mm256_load_ps(&me->alpha[channel]),
+                    _mm256_cvtepi32_ps(gainError)));
+    filteredGain = _mm256_min_ps(
+      _mm256_max_ps(filteredGain,_mm256_setzero_ps()),maxGainFloat);
+    _mm256_store_ps(&me->filteredGainInDb[channel],filteredGain);
+
+    // Blanked channels keep their gain.
+    newGain = _mm256_blendv_epi8(_mm256_cvttps_epi32(filteredGain),
+                                 gain,
+                                 blanked);
+    _mm256_store_si256((__m256i *)&me->gainInDb[channel],newGain);
+
+    // Blanked channels stay adjusted, others are adjusted if e(n) != 0.
+    _mm256_store_si256((__m256i *)&me->gainWasAdjusted[channel],
+      _mm256_and_si256(_mm256_or_si256(blanked,
+        _mm256_andnot_si256(_mm256_cmpeq_epi32(gainError,zero),
+                            _mm256_set1_epi32(-1))),one));
+  } // for
+
+  return;
+
+} // runAvx2
+#endif // X86_KERNELS
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// End of static functions
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
@@ -0,0 +1,308 @@
+//**************************************************************************
+// file name: agcInstrumentation.c
+//**************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "agcInstrumentation.h"
+
+// The percentile that is reported along with the maximum.
+#define REPORTED_PERCENTILE (99)
+
+static uint32_t computeBucketIndex(uint64_t latencyInNs);
+static void increment(uint64_t *counterPtr);
+
+/*****************************************************************************
+
+  Name: agcLatencyHistogram_init
+
+  Purpose: The purpose of this function is to clear a latency histogram.
+  The budget is cleared as well.
+
+  Calling Sequence: agcLatencyHistogram_init(histogramPtr)
+
+  Inputs:
+
+    histogramPtr - A pointer to the histogram.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void agcLatencyHistogram_init(struct agcLatencyHistogram *histogramPtr)
+{
+
+  memset(histogramPtr,0,sizeof(struct agcLatencyHistogram));
+
+  return;
+
+} // agcLatencyHistogram_init
+
+/*****************************************************************************
+
+  Name: agcLatencyHistogram_record
+
+  Purpose: The purpose of this function is to record a latency in a
+  histogram.  Only one thread may record into a given histogram, so the
+  counters are updated with plain atomic stores rather than with locked
+  read-modify-write instructions.  Readers see each counter change
+  atomically.
+
+  Calling Sequence: agcLatencyHistogram_record(histogramPtr,latencyInNs)
+
+  Inputs:
+
+    histogramPtr - A pointer to the histogram.
+
+    latencyInNs - The latency in nanoseconds.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void agcLatencyHistogram_record(struct agcLatencyHistogram *histogramPtr,
+    uint64_t latencyInNs)
+{
+  uint64_t budgetInNs;
+
+  increment(&histogramPtr->bucketCount[computeBucketIndex(latencyInNs)]);
+  increment(&histogramPtr->sampleCount);
+
+  if (latencyInNs > histogramPtr->maxLatencyInNs)
+  {
+    __atomic_store_n(&histogramPtr->maxLatencyInNs,
+                     latencyInNs,
+                     __ATOMIC_RELAXED);
+  } // if
+
+  // The budget may be changed by another thread.
+  budgetInNs = __atomic_load_n(&histogramPtr->budgetInNs,__ATOMIC_RELAXED);
+
+  if ((budgetInNs != 0) && (latencyInNs > budgetInNs))
+  {
+    increment(&histogramPtr->overrunCount);
+  } // if
+
+  return;
+
+} // agcLatencyHistogram_record
+
+/*****************************************************************************
+
+  Name: agcLatencyHistogram_setBudget
+
+  Purpose: The purpose of this function is to set the latency budget of
+  a histogram.  Latencies that exceed the budget are counted as
+  overruns.
+
+  Calling Sequence: agcLatencyHistogram_setBudget(histogramPtr,budgetInNs)
+
+  Inputs:
+
+    histogramPtr - A pointer to the histogram.
+
+    budgetInNs - The budget in nanoseconds.  A value of zero disables
+    overrun counting.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void agcLatencyHistogram_setBudget(struct agcLatencyHistogram *histogramPtr,
+    uint64_t budgetInNs)
+{
+
+  __atomic_store_n(&histogramPtr->budgetInNs,budgetInNs,__ATOMIC_RELAXED);
+
+  return;
+
+} // agcLatencyHistogram_setBudget
+
+/*****************************************************************************
+
+  Name: agcLatencyHistogram_getReport
+
+  Purpose: The purpose of this function is to copy a histogram into a
+  report, and to compute the 99th percentile of the latency.  The
+  percentile is the upper edge of the bucket that contains it, limited
+  to the maximum latency, so it is never underestimated.  Since the
+  writer may be active, the counters are only approximately consistent
+  with each other.
+
+  Calling Sequence: agcLatencyHistogram_getReport(histogramPtr,reportPtr)
+
+  Inputs:
+
+    histogramPtr - A pointer to the histogram.
+
+    reportPtr - A pointer to storage for the report.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void agcLatencyHistogram_getReport(struct agcLatencyHistogram *histogramPtr,
+    struct agcLatencyReport *reportPtr)
+{
+  uint32_t i;
+  uint64_t total;
+  uint64_t threshold;
+  uint64_t cumulative;
+
+  total = 0;
+
+  for (i = 0; i < AGC_LATENCY_BUCKET_COUNT; i++)
+  {
+    reportPtr->bucketCount[i] =
+      __atomic_load_n(&histogramPtr->bucketCount[i],__ATOMIC_RELAXED);
+
+    total += reportPtr->bucketCount[i];
+  } // for
+
+  // Use the bucket total so that the percentile matches the buckets.
+  reportPtr->sampleCount = total;
+
+  reportPtr->maxLatencyInNs =
+    __atomic_load_n(&histogramPtr->maxLatencyInNs,__ATOMIC_RELAXED);
+
+  reportPtr->budgetInNs =
+    __atomic_load_n(&histogramPtr->budgetInNs,__ATOMIC_RELAXED);
+
+  reportPtr->overrunCount =
+    __atomic_load_n(&histogramPtr->overrunCount,__ATOMIC_RELAXED);
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Find the bucket that holds the percentile.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  reportPtr->p99LatencyInNs = 0;
+
+  if (total != 0)
+  {
+    threshold = ((total * REPORTED_PERCENTILE) + 99) / 100;
+    cumulative = 0;
+
+    for (i = 0; i < AGC_LATENCY_BUCKET_COUNT; i++)
+    {
+      cumulative += reportPtr->bucketCount[i];
+
+      if (cumulative >= threshold)
+      {
+        reportPtr->p99LatencyInNs = (2ULL << i) - 1;
+        break;
+      } // if
+    } // for
+
+    if (reportPtr->p99LatencyInNs > reportPtr->maxLatencyInNs)
+    {
+      reportPtr->p99LatencyInNs = reportPtr->maxLatencyInNs;
+    } // if
+  } // if
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  return;
+
+} // agcLatencyHistogram_getReport
+
+/*****************************************************************************
+
+  Name: agcInstrumentation_getTimeInNs
+
+  Purpose: The purpose of this function is to read the monotonic clock.
+
+  Calling Sequence: timeInNs = agcInstrumentation_getTimeInNs()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    timeInNs - The time in nanoseconds.
+
+*****************************************************************************/
+uint64_t agcInstrumentation_getTimeInNs(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC,&now);
+
+  return (((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec);
+
+} // agcInstrumentation_getTimeInNs
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// Static functions.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+/*****************************************************************************
+
+  Name: computeBucketIndex
+
+  Purpose: The purpose of this function is to compute the histogram
+  bucket of a latency, which is the position of its most significant
+  bit.  Latencies of 0 and 1 nanoseconds go into bucket 0, and latencies
+  that are too large for the histogram go into the last bucket.
+
+  Calling Sequence: index = computeBucketIndex(latencyInNs)
+
+  Inputs:
+
+    latencyInNs - The latency in nanoseconds.
+
+  Outputs:
+
+    index - The bucket index.
+
+*****************************************************************************/
+uint32_t computeBucketIndex(uint64_t latencyInNs)
+{
+  uint32_t index;
+
+  index = 63 - __builtin_clzll(latencyInNs | 1);
+
+  if (index >= AGC_LATENCY_BUCKET_COUNT)
+  {
+    index = AGC_LATENCY_BUCKET_COUNT - 1;
+  } // if
+
+  return (index);
+
+} // computeBucketIndex
+
+/*****************************************************************************
+
+  Name: increment
+
+  Purpose: The purpose of this function is to increment a counter that
+  has a single writer, in a way that readers never see a torn value.
+
+  Calling Sequence: increment(counterPtr)
+
+  Inputs:
+
+    counterPtr - A pointer to the counter.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void increment(uint64_t *counterPtr)
+{
+
+  __atomic_store_n(counterPtr,*counterPtr + 1,__ATOMIC_RELAXED);
+
+  return;
+
+} // increment
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// End of static functions
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
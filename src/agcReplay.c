@@ -0,0 +1,500 @@
+//**************************************************************************
+// file name: agcReplay.c
+//**************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "AutomaticGainControl.h"
+#include "magnitudeEstimator.h"
+#include "agcReplay.h"
+
+// The 8-bit samples of the rtl-sdr have 7 magnitude bits.
+#define SIGNAL_MAGNITUDE_BIT_COUNT (7)
+
+// The level that is reported for a block of zeros.
+#define SILENCE_IN_DBFS (-200.0)
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// The gain register holds the most recent gain that the AGC set, and
+// it applies to every block that follows.  Time is counted in samples
+// of the recording, which is also the time base of the AGC.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+struct agcReplay
+{
+  struct agcReplayConfig config;
+  struct agcInstance *agcPtr;
+
+  // The full scale value of the ADC.
+  double fullScaleValue;
+
+  // The voltage gain, relative to the recording, of each gain setting.
+  double *relativeGainPtr;
+
+  uint32_t gainRegisterInDb;
+
+  // The position in the recording.
+  uint64_t currentSample;
+
+  //*******************************************************************
+  // Measurement state.
+  //*******************************************************************
+  struct agcReplayResults results;
+  uint64_t holdSampleCount;
+
+  // The start of the current run of in-band blocks, if inBand.
+  int inBand;
+  uint64_t inBandSinceSample;
+};
+
+static void setGainCallback(void *contextPtr,uint32_t gainInDb);
+static uint32_t getGainCallback(void *contextPtr);
+static void measure(struct agcReplay *me,
+    double signalInDbFs,
+    uint32_t sampleCount);
+
+/*****************************************************************************
+
+  Name: agcReplay_getDefaultConfig
+
+  Purpose: The purpose of this function is to fill in a configuration
+  that suits an rtl_sdr recording made at 2.048MS/s with 24dB of gain.
+
+  Calling Sequence: agcReplay_getDefaultConfig(configPtr)
+
+  Inputs:
+
+    configPtr - A pointer to storage for the configuration.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void agcReplay_getDefaultConfig(struct agcReplayConfig *configPtr)
+{
+
+  memset(configPtr,0,sizeof(struct agcReplayConfig));
+
+  configPtr->sampleRate = 2048000;
+  configPtr->maxGainInDb = 46;
+  configPtr->recordedGainInDb = 24;
+  configPtr->initialGainInDb = 24;
+  configPtr->operatingPointInDbFs = -12;
+  configPtr->filterCoefficient = 0.7f;
+  configPtr->deadbandInDb = 1;
+  configPtr->blankingLimit = 1;
+  configPtr->magnitudeEstimator = MAGNITUDE_ALPHA_MAX_BETA_MIN;
+  configPtr->toleranceInDb = 3;
+  configPtr->holdTimeInUs = 20000;
+
+  return;
+
+} // agcReplay_getDefaultConfig
+
+/*****************************************************************************
+
+  Name: agcReplay_create
+
+  Purpose: The purpose of this function is to create a replay, along
+  with the AGC that it runs.  The AGC is initialized, configured and
+  enabled.
+
+  Calling Sequence: replayPtr = agcReplay_create(configPtr)
+
+  Inputs:
+
+    configPtr - A pointer to the configuration.
+
+  Outputs:
+
+    replayPtr - A pointer to the replay.  A value of NULL indicates
+    that memory could not be allocated, that the sample rate is zero,
+    or that the AGC rejected the configuration.
+
+*****************************************************************************/
+struct agcReplay *agcReplay_create(const struct agcReplayConfig *configPtr)
+{
+  int success;
+  uint32_t gainInDb;
+  struct agcReplay *me;
+
+  me = NULL;
+
+  if (configPtr->sampleRate != 0)
+  {
+    me = (struct agcReplay *)calloc(1,sizeof(struct agcReplay));
+  } // if
+
+  if (me != NULL)
+  {
+    me->config = *configPtr;
+
+    if (me->config.initialGainInDb > me->config.maxGainInDb)
+    {
+      me->config.initialGainInDb = me->config.maxGainInDb;
+    } // if
+
+    me->fullScaleValue =
+      (double)((1U << SIGNAL_MAGNITUDE_BIT_COUNT) - 1);
+
+    me->gainRegisterInDb = me->config.initialGainInDb;
+    me->results.convergenceTimeInSeconds = -1;
+
+    me->holdSampleCount =
+      ((uint64_t)configPtr->holdTimeInUs * configPtr->sampleRate) /
+      1000000;
+
+    me->relativeGainPtr =
+      (double *)malloc((configPtr->maxGainInDb + 1) * sizeof(double));
+
+    me->agcPtr = agcInstance_create();
+
+    success = (me->relativeGainPtr != NULL) && (me->agcPtr != NULL);
+
+    if (success)
+    {
+      for (gainInDb = 0; gainInDb <= configPtr->maxGainInDb; gainInDb++)
+      {
+        me->relativeGainPtr[gainInDb] =
+          pow(10.0,
+              ((double)gainInDb - configPtr->recordedGainInDb) / 20);
+      } // for
+
+      // The callbacks are given the replay, so they find its register.
+      success = agcInstance_init(me->agcPtr,
+                                 configPtr->operatingPointInDbFs,
+                                 configPtr->maxGainInDb,
+                                 SIGNAL_MAGNITUDE_BIT_COUNT,
+                                 setGainCallback,
+                                 getGainCallback,
+                                 me);
+    } // if
+
+    if (success)
+    {
+      success = agcInstance_setAgcFilterCoefficient(me->agcPtr,
+                  configPtr->filterCoefficient);
+    } // if
+
+    if (success)
+    {
+      success = agcInstance_setDeadband(me->agcPtr,
+                                        configPtr->deadbandInDb);
+    } // if
+
+    if (success)
+    {
+      success = agcInstance_setBlankingLimit(me->agcPtr,
+                                             configPtr->blankingLimit);
+    } // if
+
+    if (success)
+    {
+      success = agcInstance_enable(me->agcPtr);
+    } // if
+
+    if (!success)
+    {
+      agcReplay_destroy(me);
+      me = NULL;
+    } // if
+  } // if
+
+  return (me);
+
+} // agcReplay_create
+
+/*****************************************************************************
+
+  Name: agcReplay_destroy
+
+  Purpose: The purpose of this function is to release a replay and its
+  AGC.
+
+  Calling Sequence: agcReplay_destroy(replayPtr)
+
+  Inputs:
+
+    replayPtr - A pointer to the replay.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void agcReplay_destroy(struct agcReplay *me)
+{
+
+  if (me->agcPtr != NULL)
+  {
+    agcInstance_destroy(me->agcPtr);
+  } // if
+
+  free(me->relativeGainPtr);
+  free(me);
+
+  return;
+
+} // agcReplay_destroy
+
+/*****************************************************************************
+
+  Name: agcReplay_acceptIqBlockU8
+
+  Purpose: The purpose of this function is to replay the next block of
+  a recording of unsigned offset binary IQ samples, as produced by the
+  rtl-sdr.  The samples are read where they are.  The block is given
+  the gain that the AGC set before it, and the AGC is run with the
+  resulting magnitude.  Blocks of different replays may be processed
+  on different threads, but the blocks of one replay must be presented
+  in order.
+
+  Calling Sequence: agcReplay_acceptIqBlockU8(replayPtr,iqPtr,
+                                              sampleCount,pointPtr)
+
+  Inputs:
+
+    replayPtr - A pointer to the replay.
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    pointPtr - A pointer to storage for the timeline point of the
+    block, or NULL if the timeline is not wanted.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void agcReplay_acceptIqBlockU8(struct agcReplay *me,
+    const uint8_t *iqPtr,
+    uint32_t sampleCount,
+    struct agcReplayPoint *pointPtr)
+{
+  uint32_t gainInDb;
+  uint32_t recordedMagnitude;
+  double magnitude;
+  double signalInDbFs;
+
+  // The gain that was set before this block applies to all of it.
+  gainInDb = me->gainRegisterInDb;
+
+  recordedMagnitude = magnitude_averageU8(iqPtr,
+                                          sampleCount,
+                                          me->config.magnitudeEstimator);
+
+  magnitude =
+    floor((recordedMagnitude * me->relativeGainPtr[gainInDb]) + 0.5);
+
+  if (magnitude >= me->fullScaleValue)
+  {
+    // The ADC saturates.
+    magnitude = me->fullScaleValue;
+    me->results.clippedBlockCount++;
+  } // if
+
+  agcInstance_acceptDataAt(me->agcPtr,
+                           (uint32_t)magnitude,
+                           me->currentSample);
+
+  if (magnitude > 0)
+  {
+    signalInDbFs = 20 * log10(magnitude / me->fullScaleValue);
+  } // if
+  else
+  {
+    signalInDbFs = SILENCE_IN_DBFS;
+  } // else
+
+  measure(me,signalInDbFs,sampleCount);
+
+  if (pointPtr != NULL)
+  {
+    pointPtr->timeInSeconds =
+      (double)me->currentSample / me->config.sampleRate;
+    pointPtr->gainInDb = gainInDb;
+    pointPtr->signalInDbFs = (float)signalInDbFs;
+
+    if (recordedMagnitude > 0)
+    {
+      pointPtr->rssiInDbFs =
+        (float)(20 * log10(recordedMagnitude / me->fullScaleValue) -
+                me->config.recordedGainInDb);
+    } // if
+    else
+    {
+      pointPtr->rssiInDbFs = (float)SILENCE_IN_DBFS;
+    } // else
+  } // if
+
+  me->results.blockCount++;
+  me->results.sampleCount += sampleCount;
+  me->currentSample += sampleCount;
+
+  return;
+
+} // agcReplay_acceptIqBlockU8
+
+/*****************************************************************************
+
+  Name: agcReplay_getResults
+
+  Purpose: The purpose of this function is to retrieve the measurements
+  of the blocks that have been replayed so far.
+
+  Calling Sequence: agcReplay_getResults(replayPtr,resultsPtr)
+
+  Inputs:
+
+    replayPtr - A pointer to the replay.
+
+    resultsPtr - A pointer to storage for the results.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void agcReplay_getResults(struct agcReplay *me,
+    struct agcReplayResults *resultsPtr)
+{
+
+  *resultsPtr = me->results;
+  resultsPtr->finalGainInDb = me->gainRegisterInDb;
+
+  return;
+
+} // agcReplay_getResults
+
+/*****************************************************************************
+
+  Name: setGainCallback
+
+  Purpose: The purpose of this function is to connect the AGC's set
+  gain callback to the gain register of a replay.
+
+  Calling Sequence: setGainCallback(contextPtr,gainInDb)
+
+  Inputs:
+
+    contextPtr - A pointer to the replay.
+
+    gainInDb - The gain in decibels.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void setGainCallback(void *contextPtr,uint32_t gainInDb)
+{
+  struct agcReplay *me;
+
+  me = (struct agcReplay *)contextPtr;
+
+  if (gainInDb > me->config.maxGainInDb)
+  {
+    gainInDb = me->config.maxGainInDb;
+  } // if
+
+  me->gainRegisterInDb = gainInDb;
+  me->results.hardwareWriteCount++;
+
+  return;
+
+} // setGainCallback
+
+/*****************************************************************************
+
+  Name: getGainCallback
+
+  Purpose: The purpose of this function is to connect the AGC's get
+  gain callback to the gain register of a replay.
+
+  Calling Sequence: gainInDb = getGainCallback(contextPtr)
+
+  Inputs:
+
+    contextPtr - A pointer to the replay.
+
+  Outputs:
+
+    gainInDb - The gain in decibels.
+
+*****************************************************************************/
+uint32_t getGainCallback(void *contextPtr)
+{
+  struct agcReplay *me;
+
+  me = (struct agcReplay *)contextPtr;
+
+  return (me->gainRegisterInDb);
+
+} // getGainCallback
+
+/*****************************************************************************
+
+  Name: measure
+
+  Purpose: The purpose of this function is to update the measurements
+  with the amplified signal level of the current block.  The loop has
+  converged once the level has stayed within the tolerance of the
+  operating point for the hold time, and the convergence time runs up
+  to the start of that stretch.  Only the first convergence is
+  recorded.
+
+  Calling Sequence: measure(replayPtr,signalInDbFs,sampleCount)
+
+  Inputs:
+
+    replayPtr - A pointer to the replay.
+
+    signalInDbFs - The signal level at the ADC.
+
+    sampleCount - The number of samples in the block.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void measure(struct agcReplay *me,
+    double signalInDbFs,
+    uint32_t sampleCount)
+{
+  int inBand;
+
+  inBand = (fabs(signalInDbFs - me->config.operatingPointInDbFs) <=
+            me->config.toleranceInDb);
+
+  if (inBand)
+  {
+    me->results.inBandBlockCount++;
+
+    if (!me->inBand)
+    {
+      me->inBandSinceSample = me->currentSample;
+    } // if
+  } // if
+
+  me->inBand = inBand;
+
+  if (inBand && (me->results.convergenceTimeInSeconds < 0))
+  {
+    if ((me->currentSample + sampleCount - me->inBandSinceSample) >=
+        me->holdSampleCount)
+    {
+      me->results.convergenceTimeInSeconds =
+        (double)me->inBandSinceSample / me->config.sampleRate;
+    } // if
+  } // if
+
+  return;
+
+} // measure
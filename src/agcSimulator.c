@@ -0,0 +1,1003 @@
+//**************************************************************************
+// file name: agcSimulator.c
+//**************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "agcSimulator.h"
+
+// Levels below this are treated as no signal at all.
+#define SILENCE_IN_DBFS (-200.0)
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// The VGA gain register holds the most recent gain that was requested.
+// The analog gain starts to move toward it actuationDelayInUs later,
+// and it approaches it exponentially with a time constant of
+// settlingTimeInUs.  A request that arrives before the previous one
+// took effect replaces it.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+struct agcSimulator
+{
+  struct agcSimulatorConfig config;
+  struct agcScenario scenario;
+
+  // The full scale value of the ADC.
+  double fullScaleValue;
+
+  // Simulation time.
+  uint64_t currentTimeInUs;
+  uint32_t randomState;
+
+  //*******************************************************************
+  // VGA state.
+  //*******************************************************************
+  // The gain that agcSimulator_getGain() reports.
+  uint32_t gainRegisterInDb;
+
+  // A gain change that has not reached the amplifier yet.
+  int changePending;
+  uint32_t pendingGainInDb;
+  uint64_t pendingTimeInUs;
+
+  // The analog gain settles from startGainInDb to targetGainInDb.
+  double startGainInDb;
+  uint32_t targetGainInDb;
+  uint64_t changeTimeInUs;
+
+  //*******************************************************************
+  // Measurement state.
+  //*******************************************************************
+  struct agcSimulatorResults results;
+  double totalConvergenceTimeInUs;
+  double totalUnconvergedTimeInUs;
+  double totalSquaredSteadyStateError;
+
+  // The antenna level of the previous block.
+  double previousLevelInDbFs;
+
+  // The event that is being tracked.  Tracking ends when the loop
+  // converges, or when the signal goes away.
+  uint64_t eventTimeInUs;
+  int tracking;
+  int settled;
+  int eventStarted;
+  int approachingFromBelow;
+  int reachedOperatingPoint;
+
+  // The start of the current run of in-band blocks, if inBand.
+  int inBand;
+  uint64_t inBandSinceInUs;
+};
+
+static uint32_t generateRandom(struct agcSimulator *me);
+static double generateGaussian(struct agcSimulator *me);
+static double computeAnalogGainInDb(struct agcSimulator *me);
+static double computeSignalLevelInDbFs(struct agcSimulator *me);
+static int isEventInBlock(struct agcSimulator *me,double levelInDbFs);
+static void stopTracking(struct agcSimulator *me);
+static void startEvent(struct agcSimulator *me);
+static void measure(struct agcSimulator *me,
+    double signalInDbFs,
+    int signalPresent);
+
+/*****************************************************************************
+
+  Name: agcSimulator_getDefaultConfig
+
+  Purpose: The purpose of this function is to fill in a configuration
+  that resembles an rtl-sdr: 7 magnitude bits, a 46dB gain range, and a
+  gain change that takes a millisecond to reach the tuner.
+
+  Calling Sequence: agcSimulator_getDefaultConfig(configPtr)
+
+  Inputs:
+
+    configPtr - A pointer to storage for the configuration.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void agcSimulator_getDefaultConfig(struct agcSimulatorConfig *configPtr)
+{
+
+  memset(configPtr,0,sizeof(struct agcSimulatorConfig));
+
+  configPtr->signalMagnitudeBitCount = 7;
+  configPtr->maxGainInDb = 46;
+  configPtr->initialGainInDb = 24;
+  configPtr->blockDurationInUs = 1000;
+  configPtr->actuationDelayInUs = 1000;
+  configPtr->settlingTimeInUs = 500;
+  configPtr->transientInDb = 6;
+  configPtr->noiseFloorInDbFs = -80;
+  configPtr->fluctuation = 0.05f;
+  configPtr->operatingPointInDbFs = -12;
+  configPtr->toleranceInDb = 3;
+  configPtr->holdTimeInUs = 20000;
+  configPtr->seed = 1;
+
+  return;
+
+} // agcSimulator_getDefaultConfig
+
+/*****************************************************************************
+
+  Name: agcSimulator_getScenario
+
+  Purpose: The purpose of this function is to fill in one of the
+  standard scenarios.  Each lasts 10 seconds.
+
+    step - A -50dBFs signal that steps up by 30dB after 5 seconds.
+
+    fading - A -40dBFs signal that swings by +-10dB once a second.
+
+    bursty - A -30dBFs signal that is on for 50ms every 250ms.
+
+    noise-only - No signal, only the noise floor.
+
+  Calling Sequence: success = agcSimulator_getScenario(namePtr,
+                                                       scenarioPtr)
+
+  Inputs:
+
+    namePtr - The name of the scenario.
+
+    scenarioPtr - A pointer to storage for the scenario.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the scenario exists.
+    A value of 1 indicates that it exists, and a value of 0 indicates
+    that it does not.
+
+*****************************************************************************/
+int agcSimulator_getScenario(const char *namePtr,
+    struct agcScenario *scenarioPtr)
+{
+  int success;
+
+  success = 1;
+
+  memset(scenarioPtr,0,sizeof(struct agcScenario));
+  scenarioPtr->durationInUs = 10000000;
+
+  if (strcmp(namePtr,"step") == 0)
+  {
+    scenarioPtr->type = AGC_SCENARIO_STEP;
+    scenarioPtr->levelInDbFs = -50;
+    scenarioPtr->stepInDb = 30;
+    scenarioPtr->stepTimeInUs = 5000000;
+  } // if
+  else
+  {
+    if (strcmp(namePtr,"fading") == 0)
+    {
+      scenarioPtr->type = AGC_SCENARIO_FADING;
+      scenarioPtr->levelInDbFs = -40;
+      scenarioPtr->depthInDb = 20;
+      scenarioPtr->periodInUs = 1000000;
+    } // if
+    else
+    {
+      if (strcmp(namePtr,"bursty") == 0)
+      {
+        scenarioPtr->type = AGC_SCENARIO_BURSTY;
+        scenarioPtr->levelInDbFs = -30;
+        scenarioPtr->periodInUs = 250000;
+        scenarioPtr->burstOnInUs = 50000;
+      } // if
+      else
+      {
+        if (strcmp(namePtr,"noise-only") == 0)
+        {
+          scenarioPtr->type = AGC_SCENARIO_NOISE_ONLY;
+        } // if
+        else
+        {
+          success = 0;
+        } // else
+      } // else
+    } // else
+  } // else
+
+  return (success);
+
+} // agcSimulator_getScenario
+
+/*****************************************************************************
+
+  Name: agcSimulator_create
+
+  Purpose: The purpose of this function is to create a simulator that
+  runs a scenario.
+
+  Calling Sequence: simulatorPtr = agcSimulator_create(configPtr,
+                                                       scenarioPtr)
+
+  Inputs:
+
+    configPtr - A pointer to the configuration of the receiver.
+
+    scenarioPtr - A pointer to the scenario.
+
+  Outputs:
+
+    simulatorPtr - A pointer to the simulator.  A value of NULL
+    indicates that memory could not be allocated, or that the block
+    duration is zero.
+
+*****************************************************************************/
+struct agcSimulator *agcSimulator_create(
+    const struct agcSimulatorConfig *configPtr,
+    const struct agcScenario *scenarioPtr)
+{
+  struct agcSimulator *me;
+
+  me = NULL;
+
+  if (configPtr->blockDurationInUs != 0)
+  {
+    me = (struct agcSimulator *)calloc(1,sizeof(struct agcSimulator));
+  } // if
+
+  if (me != NULL)
+  {
+    me->config = *configPtr;
+    me->scenario = *scenarioPtr;
+
+    me->fullScaleValue =
+      (double)((1ULL << configPtr->signalMagnitudeBitCount) - 1);
+
+    // Zero would stick in the random number generator.
+    me->randomState = (configPtr->seed != 0) ? configPtr->seed : 1;
+
+    me->gainRegisterInDb = configPtr->initialGainInDb;
+    me->startGainInDb = configPtr->initialGainInDb;
+    me->targetGainInDb = configPtr->initialGainInDb;
+  } // if
+
+  return (me);
+
+} // agcSimulator_create
+
+/*****************************************************************************
+
+  Name: agcSimulator_destroy
+
+  Purpose: The purpose of this function is to release a simulator.
+
+  Calling Sequence: agcSimulator_destroy(simulatorPtr)
+
+  Inputs:
+
+    simulatorPtr - A pointer to the simulator.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void agcSimulator_destroy(struct agcSimulator *me)
+{
+
+  free(me);
+
+  return;
+
+} // agcSimulator_destroy
+
+/*****************************************************************************
+
+  Name: agcSimulator_step
+
+  Purpose: The purpose of this function is to simulate the next block.
+  Gain changes that are due take effect, the signal at the antenna is
+  amplified and digitized, and the result is measured.
+
+  Calling Sequence: running = agcSimulator_step(simulatorPtr,
+                                                signalMagnitudePtr,
+                                                timeInUsPtr)
+
+  Inputs:
+
+    simulatorPtr - A pointer to the simulator.
+
+    signalMagnitudePtr - A pointer to storage for the signal magnitude
+    at the ADC output.
+
+    timeInUsPtr - A pointer to storage for the time of the block.
+
+  Outputs:
+
+    running - A flag that indicates whether or not a block was
+    simulated.  A value of 0 indicates that the scenario is over.
+
+*****************************************************************************/
+int agcSimulator_step(struct agcSimulator *me,
+    uint32_t *signalMagnitudePtr,
+    uint64_t *timeInUsPtr)
+{
+  int running;
+  double levelInDbFs;
+  double signalPower;
+  double amplitude;
+  double magnitude;
+  double signalInDbFs;
+
+  running = (me->currentTimeInUs < me->scenario.durationInUs);
+
+  if (running)
+  {
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+    // Let a pending gain change reach the amplifier.
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+    if (me->changePending)
+    {
+      if (me->currentTimeInUs >= me->pendingTimeInUs)
+      {
+        // Start from wherever the amplifier is now.
+        me->startGainInDb = computeAnalogGainInDb(me);
+        me->targetGainInDb = me->pendingGainInDb;
+        me->changeTimeInUs = me->currentTimeInUs;
+        me->changePending = 0;
+      } // if
+    } // if
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+    // Amplify the signal plus noise, and digitize it.
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+    levelInDbFs = computeSignalLevelInDbFs(me);
+
+    signalPower = pow(10.0,levelInDbFs / 10) +
+                  pow(10.0,me->config.noiseFloorInDbFs / 10);
+
+    amplitude = sqrt(signalPower) *
+                pow(10.0,computeAnalogGainInDb(me) / 20) *
+                (1 + (me->config.fluctuation * generateGaussian(me)));
+
+    magnitude = floor((amplitude * me->fullScaleValue) + 0.5);
+
+    if (magnitude < 0)
+    {
+      magnitude = 0;
+    } // if
+
+    if (magnitude >= me->fullScaleValue)
+    {
+      // The ADC saturates.
+      magnitude = me->fullScaleValue;
+      me->results.clippedBlockCount++;
+    } // if
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+    if (magnitude > 0)
+    {
+      signalInDbFs = 20 * log10(magnitude / me->fullScaleValue);
+    } // if
+    else
+    {
+      signalInDbFs = SILENCE_IN_DBFS;
+    } // else
+
+    if (isEventInBlock(me,levelInDbFs))
+    {
+      startEvent(me);
+    } // if
+
+    me->previousLevelInDbFs = levelInDbFs;
+
+    measure(me,signalInDbFs,levelInDbFs > SILENCE_IN_DBFS);
+
+    *signalMagnitudePtr = (uint32_t)magnitude;
+    *timeInUsPtr = me->currentTimeInUs;
+
+    me->results.blockCount++;
+    me->currentTimeInUs += me->config.blockDurationInUs;
+  } // if
+
+  return (running);
+
+} // agcSimulator_step
+
+/*****************************************************************************
+
+  Name: agcSimulator_setGain
+
+  Purpose: The purpose of this function is to request a new VGA gain.
+  It is meant to be called by the AGC's set gain callback.  The gain
+  is limited to the range of the VGA, and it reaches the amplifier
+  after the actuation delay.
+
+  Calling Sequence: agcSimulator_setGain(simulatorPtr,gainInDb)
+
+  Inputs:
+
+    simulatorPtr - A pointer to the simulator.
+
+    gainInDb - The gain in decibels.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void agcSimulator_setGain(struct agcSimulator *me,uint32_t gainInDb)
+{
+
+  if (gainInDb > me->config.maxGainInDb)
+  {
+    gainInDb = me->config.maxGainInDb;
+  } // if
+
+  me->results.hardwareWriteCount++;
+
+  me->gainRegisterInDb = gainInDb;
+
+  me->changePending = 1;
+  me->pendingGainInDb = gainInDb;
+  me->pendingTimeInUs = me->currentTimeInUs + me->config.actuationDelayInUs;
+
+  return;
+
+} // agcSimulator_setGain
+
+/*****************************************************************************
+
+  Name: agcSimulator_getGain
+
+  Purpose: The purpose of this function is to read the VGA gain
+  register.  It is meant to be called by the AGC's get gain callback.
+
+  Calling Sequence: gainInDb = agcSimulator_getGain(simulatorPtr)
+
+  Inputs:
+
+    simulatorPtr - A pointer to the simulator.
+
+  Outputs:
+
+    gainInDb - The most recently requested gain in decibels.
+
+*****************************************************************************/
+uint32_t agcSimulator_getGain(struct agcSimulator *me)
+{
+
+  return (me->gainRegisterInDb);
+
+} // agcSimulator_getGain
+
+/*****************************************************************************
+
+  Name: agcSimulator_getResults
+
+  Purpose: The purpose of this function is to retrieve the measurements
+  of the blocks that have been simulated so far.
+
+  Calling Sequence: agcSimulator_getResults(simulatorPtr,resultsPtr)
+
+  Inputs:
+
+    simulatorPtr - A pointer to the simulator.
+
+    resultsPtr - A pointer to storage for the results.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void agcSimulator_getResults(struct agcSimulator *me,
+    struct agcSimulatorResults *resultsPtr)
+{
+
+  double unconvergedTimeInUs;
+
+  *resultsPtr = me->results;
+
+  resultsPtr->simulatedTimeInUs = me->currentTimeInUs;
+
+  unconvergedTimeInUs = me->totalUnconvergedTimeInUs;
+
+  if (me->tracking)
+  {
+    // The current event has not converged yet.
+    unconvergedTimeInUs += (double)(me->currentTimeInUs - me->eventTimeInUs);
+  } // if
+
+  if (me->results.convergedEventCount != 0)
+  {
+    resultsPtr->meanConvergenceTimeInUs = me->totalConvergenceTimeInUs /
+      me->results.convergedEventCount;
+  } // if
+
+  if (me->results.eventCount != 0)
+  {
+    resultsPtr->meanResponseTimeInUs =
+      (me->totalConvergenceTimeInUs + unconvergedTimeInUs) /
+      me->results.eventCount;
+  } // if
+
+  if (me->results.steadyStateBlockCount != 0)
+  {
+    resultsPtr->steadyStateErrorInDb =
+      sqrt(me->totalSquaredSteadyStateError /
+           me->results.steadyStateBlockCount);
+  } // if
+
+  return;
+
+} // agcSimulator_getResults
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// Static functions.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+/*****************************************************************************
+
+  Name: generateRandom
+
+  Purpose: The purpose of this function is to generate a pseudorandom
+  number with a xorshift generator.  Each simulator has its own
+  generator, so runs are repeatable for a given seed.
+
+  Calling Sequence: value = generateRandom(simulatorPtr)
+
+  Inputs:
+
+    simulatorPtr - A pointer to the simulator.
+
+  Outputs:
+
+    value - The pseudorandom number.
+
+*****************************************************************************/
+uint32_t generateRandom(struct agcSimulator *me)
+{
+  uint32_t x;
+
+  x = me->randomState;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+
+  me->randomState = x;
+
+  return (x);
+
+} // generateRandom
+
+/*****************************************************************************
+
+  Name: generateGaussian
+
+  Purpose: The purpose of this function is to generate an approximately
+  Gaussian random number with zero mean and unit variance, as the sum
+  of four uniform random numbers.
+
+  Calling Sequence: value = generateGaussian(simulatorPtr)
+
+  Inputs:
+
+    simulatorPtr - A pointer to the simulator.
+
+  Outputs:
+
+    value - The random number.
+
+*****************************************************************************/
+double generateGaussian(struct agcSimulator *me)
+{
+  int i;
+  double sum;
+
+  sum = 0;
+
+  for (i = 0; i < 4; i++)
+  {
+    sum += (double)generateRandom(me) / 4294967296.0;
+  } // for
+
+  // The sum has a mean of 2 and a variance of 1/3.
+  return ((sum - 2) * sqrt(3.0));
+
+} // generateGaussian
+
+/*****************************************************************************
+
+  Name: computeAnalogGainInDb
+
+  Purpose: The purpose of this function is to compute the gain of the
+  amplifier in the current block, including the settling transient.
+
+  Calling Sequence: gainInDb = computeAnalogGainInDb(simulatorPtr)
+
+  Inputs:
+
+    simulatorPtr - A pointer to the simulator.
+
+  Outputs:
+
+    gainInDb - The gain in decibels.
+
+*****************************************************************************/
+double computeAnalogGainInDb(struct agcSimulator *me)
+{
+  double gainInDb;
+  double elapsedInUs;
+
+  gainInDb = me->targetGainInDb;
+
+  if (me->startGainInDb != me->targetGainInDb)
+  {
+    elapsedInUs = (double)(me->currentTimeInUs - me->changeTimeInUs);
+
+    if (me->config.settlingTimeInUs != 0)
+    {
+      gainInDb += (me->startGainInDb - me->targetGainInDb) *
+                  exp(-elapsedInUs / me->config.settlingTimeInUs);
+    } // if
+
+    if (elapsedInUs < me->config.blockDurationInUs)
+    {
+      // The switch itself disturbs the signal.
+      gainInDb += me->config.transientInDb;
+    } // if
+  } // if
+
+  return (gainInDb);
+
+} // computeAnalogGainInDb
+
+/*****************************************************************************
+
+  Name: computeSignalLevelInDbFs
+
+  Purpose: The purpose of this function is to compute the level of the
+  signal at the antenna in the current block.
+
+  Calling Sequence: levelInDbFs = computeSignalLevelInDbFs(simulatorPtr)
+
+  Inputs:
+
+    simulatorPtr - A pointer to the simulator.
+
+  Outputs:
+
+    levelInDbFs - The level, referenced to 0dB of gain.
+
+*****************************************************************************/
+double computeSignalLevelInDbFs(struct agcSimulator *me)
+{
+  double levelInDbFs;
+  uint64_t t;
+  uint64_t blockIndex;
+
+  t = me->currentTimeInUs;
+  levelInDbFs = me->scenario.levelInDbFs;
+
+  switch (me->scenario.type)
+  {
+    case AGC_SCENARIO_STEP:
+    {
+      if (t >= me->scenario.stepTimeInUs)
+      {
+        levelInDbFs += me->scenario.stepInDb;
+      } // if
+      break;
+    } // case
+
+    case AGC_SCENARIO_FADING:
+    {
+      levelInDbFs += (me->scenario.depthInDb / 2) *
+        sin((2 * M_PI * (double)t) / (double)me->scenario.periodInUs);
+      break;
+    } // case
+
+    case AGC_SCENARIO_BURSTY:
+    {
+      if ((t % me->scenario.periodInUs) >= me->scenario.burstOnInUs)
+      {
+        levelInDbFs = SILENCE_IN_DBFS;
+      } // if
+      break;
+    } // case
+
+    case AGC_SCENARIO_RECORDED:
+    {
+      blockIndex = t / me->config.blockDurationInUs;
+
+      if (blockIndex < me->scenario.recordedLevelCount)
+      {
+        levelInDbFs = me->scenario.recordedLevelsPtr[blockIndex];
+      } // if
+      else
+      {
+        levelInDbFs = SILENCE_IN_DBFS;
+      } // else
+      break;
+    } // case
+
+    default:
+    {
+      levelInDbFs = SILENCE_IN_DBFS;
+      break;
+    } // case
+  } // switch
+
+  return (levelInDbFs);
+
+} // computeSignalLevelInDbFs
+
+/*****************************************************************************
+
+  Name: isEventInBlock
+
+  Purpose: The purpose of this function is to determine whether or not
+  the scenario disturbs the loop in the current block.
+
+  Calling Sequence: event = isEventInBlock(simulatorPtr,levelInDbFs)
+
+  Inputs:
+
+    simulatorPtr - A pointer to the simulator.
+
+    levelInDbFs - The antenna level of the current block.
+
+  Outputs:
+
+    event - A flag that indicates whether or not an event occurs.
+
+*****************************************************************************/
+int isEventInBlock(struct agcSimulator *me,double levelInDbFs)
+{
+  int event;
+  uint64_t t;
+
+  t = me->currentTimeInUs;
+
+  // The start of the scenario is always an event.
+  event = (t == 0);
+
+  if (me->scenario.type == AGC_SCENARIO_STEP)
+  {
+    if ((me->scenario.stepTimeInUs >= t) &&
+        (me->scenario.stepTimeInUs < (t + me->config.blockDurationInUs)))
+    {
+      event = 1;
+    } // if
+  } // if
+
+  if (me->scenario.type == AGC_SCENARIO_BURSTY)
+  {
+    if ((t % me->scenario.periodInUs) < me->config.blockDurationInUs)
+    {
+      event = 1;
+    } // if
+  } // if
+
+  if (me->scenario.type == AGC_SCENARIO_RECORDED)
+  {
+    if ((t != 0) &&
+        (fabs(levelInDbFs - me->previousLevelInDbFs) >=
+         me->scenario.eventThresholdInDb))
+    {
+      event = 1;
+    } // if
+  } // if
+
+  return (event);
+
+} // isEventInBlock
+
+/*****************************************************************************
+
+  Name: startEvent
+
+  Purpose: The purpose of this function is to start tracking the
+  response of the loop to an event.
+
+  Calling Sequence: startEvent(simulatorPtr)
+
+  Inputs:
+
+    simulatorPtr - A pointer to the simulator.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void startEvent(struct agcSimulator *me)
+{
+
+  // The previous event may not have converged.
+  stopTracking(me);
+
+  me->results.eventCount++;
+
+  me->eventTimeInUs = me->currentTimeInUs;
+  me->tracking = 1;
+  me->settled = 0;
+  me->eventStarted = 1;
+  me->reachedOperatingPoint = 0;
+  me->inBand = 0;
+
+  return;
+
+} // startEvent
+
+/*****************************************************************************
+
+  Name: stopTracking
+
+  Purpose: The purpose of this function is to stop tracking an event
+  that has not converged.  The time that it was tracked is added to
+  the response time.
+
+  Calling Sequence: stopTracking(simulatorPtr)
+
+  Inputs:
+
+    simulatorPtr - A pointer to the simulator.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void stopTracking(struct agcSimulator *me)
+{
+
+  if (me->tracking)
+  {
+    me->totalUnconvergedTimeInUs +=
+      (double)(me->currentTimeInUs - me->eventTimeInUs);
+
+    me->tracking = 0;
+  } // if
+
+  return;
+
+} // stopTracking
+
+/*****************************************************************************
+
+  Name: measure
+
+  Purpose: The purpose of this function is to update the measurements
+  with the amplified signal level of the current block.
+
+  Calling Sequence: measure(simulatorPtr,signalInDbFs,signalPresent)
+
+  Inputs:
+
+    simulatorPtr - A pointer to the simulator.
+
+    signalInDbFs - The signal level at the ADC output.
+
+    signalPresent - A flag that indicates whether or not the scenario
+    has a signal in the current block.  There is nothing to converge
+    to without one.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void measure(struct agcSimulator *me,
+    double signalInDbFs,
+    int signalPresent)
+{
+  double error;
+  double overshoot;
+  double convergenceTimeInUs;
+
+  error = signalInDbFs - me->config.operatingPointInDbFs;
+
+  if (fabs(error) <= me->config.toleranceInDb)
+  {
+    me->results.inBandBlockCount++;
+  } // if
+
+  if (!signalPresent)
+  {
+    // There is nothing to converge to.
+    stopTracking(me);
+    me->settled = 0;
+  } // if
+
+  if (me->settled)
+  {
+    me->totalSquaredSteadyStateError += error * error;
+    me->results.steadyStateBlockCount++;
+  } // if
+
+  if (me->tracking)
+  {
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+    // Overshoot is measured once the level has reached the
+    // operating point from the side that it started on.
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+    if (me->eventStarted)
+    {
+      me->approachingFromBelow = (error < 0);
+      me->eventStarted = 0;
+    } // if
+
+    if (!me->reachedOperatingPoint)
+    {
+      if (me->approachingFromBelow)
+      {
+        me->reachedOperatingPoint = (error >= 0);
+      } // if
+      else
+      {
+        me->reachedOperatingPoint = (error <= 0);
+      } // else
+    } // if
+
+    if (me->reachedOperatingPoint)
+    {
+      overshoot = me->approachingFromBelow ? error : -error;
+
+      if (overshoot > me->results.maxOvershootInDb)
+      {
+        me->results.maxOvershootInDb = overshoot;
+      } // if
+    } // if
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+    // The loop has converged when the level has stayed in the
+    // band for the hold time.  The convergence time runs up to
+    // the start of that stretch.
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+    if (fabs(error) <= me->config.toleranceInDb)
+    {
+      if (!me->inBand)
+      {
+        me->inBand = 1;
+        me->inBandSinceInUs = me->currentTimeInUs;
+      } // if
+
+      if ((me->currentTimeInUs + me->config.blockDurationInUs -
+           me->inBandSinceInUs) >= me->config.holdTimeInUs)
+      {
+        convergenceTimeInUs =
+          (double)(me->inBandSinceInUs - me->eventTimeInUs);
+
+        me->results.convergedEventCount++;
+        me->totalConvergenceTimeInUs += convergenceTimeInUs;
+
+        if (convergenceTimeInUs > me->results.maxConvergenceTimeInUs)
+        {
+          me->results.maxConvergenceTimeInUs = convergenceTimeInUs;
+        } // if
+
+        // This event is done.
+        me->tracking = 0;
+        me->settled = 1;
+      } // if
+    } // if
+    else
+    {
+      me->inBand = 0;
+    } // else
+    //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  } // if
+
+  return;
+
+} // measure
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// End of static functions
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
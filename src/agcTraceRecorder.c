@@ -0,0 +1,480 @@
+//**************************************************************************
+// file name: agcTraceRecorder.c
+//**************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "agcTraceRecorder.h"
+
+// Keep the producer and consumer fields on separate cache lines.
+#define TRACE_CACHE_LINE_SIZE (64)
+
+// How long the writer sleeps when the ring buffer is empty.
+#define WRITER_IDLE_TIME_IN_NS (1000000)
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// The ring buffer holds a power of two number of records.  The head
+// and tail are free-running record counts, so the ring buffer is empty
+// when they are equal, and full when they differ by the capacity.  The
+// producer only writes the head, and the consumer only writes the tail.
+// The producer keeps a copy of the tail so that it only has to read
+// the consumer's cache line when the ring buffer appears to be full.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+struct agcTraceRecorder
+{
+  //*******************************************************************
+  // Producer section.
+  //*******************************************************************
+  uint64_t head __attribute__((aligned(TRACE_CACHE_LINE_SIZE)));
+  uint64_t cachedTail;
+  uint64_t droppedCount;
+
+  //*******************************************************************
+  // Consumer section.
+  //*******************************************************************
+  uint64_t tail __attribute__((aligned(TRACE_CACHE_LINE_SIZE)));
+
+  //*******************************************************************
+  // Cold section.
+  //*******************************************************************
+  struct agcTraceRecord *ringPtr
+    __attribute__((aligned(TRACE_CACHE_LINE_SIZE)));
+
+  uint32_t capacity;
+  uint32_t mask;
+
+  FILE *filePtr;
+  int running;
+  int stopRequested;
+  pthread_t writerThread;
+};
+
+static void *runWriter(void *argPtr);
+static uint64_t drain(struct agcTraceRecorder *me);
+
+/*****************************************************************************
+
+  Name: agcTraceRecorder_create
+
+  Purpose: The purpose of this function is to allocate a trace recorder.
+
+  Calling Sequence: recorderPtr = agcTraceRecorder_create(capacity)
+
+  Inputs:
+
+    capacity - The number of records that the ring buffer can hold.  It
+    is rounded up to a power of two.  The writer wakes up every
+    millisecond, so the ring buffer should hold at least a few
+    milliseconds worth of invocations.
+
+  Outputs:
+
+    recorderPtr - A pointer to the recorder.  A value of NULL indicates
+    that memory could not be allocated.
+
+*****************************************************************************/
+struct agcTraceRecorder *agcTraceRecorder_create(uint32_t capacity)
+{
+  void *memoryPtr;
+  struct agcTraceRecorder *me;
+  uint32_t roundedCapacity;
+
+  // Default to failure.
+  me = NULL;
+
+  roundedCapacity = 2;
+
+  while ((roundedCapacity < capacity) && (roundedCapacity < 0x80000000))
+  {
+    roundedCapacity <<= 1;
+  } // while
+
+  if (posix_memalign(&memoryPtr,
+                     TRACE_CACHE_LINE_SIZE,
+                     sizeof(struct agcTraceRecorder)) == 0)
+  {
+    me = (struct agcTraceRecorder *)memoryPtr;
+    memset(me,0,sizeof(struct agcTraceRecorder));
+
+    if (posix_memalign(&memoryPtr,
+                       TRACE_CACHE_LINE_SIZE,
+                       roundedCapacity * sizeof(struct agcTraceRecord)) == 0)
+    {
+      me->ringPtr = (struct agcTraceRecord *)memoryPtr;
+      me->capacity = roundedCapacity;
+      me->mask = roundedCapacity - 1;
+    } // if
+    else
+    {
+      free(me);
+      me = NULL;
+    } // else
+  } // if
+
+  return (me);
+
+} // agcTraceRecorder_create
+
+/*****************************************************************************
+
+  Name: agcTraceRecorder_destroy
+
+  Purpose: The purpose of this function is to release the resources of
+  a trace recorder.  The recorder is stopped if it is running.  The
+  recorder must not be attached to an AGC when it is destroyed.
+
+  Calling Sequence: agcTraceRecorder_destroy(recorderPtr)
+
+  Inputs:
+
+    recorderPtr - A pointer to the recorder.  A value of NULL is ignored.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void agcTraceRecorder_destroy(struct agcTraceRecorder *me)
+{
+
+  if (me != NULL)
+  {
+    agcTraceRecorder_stop(me);
+
+    free(me->ringPtr);
+    free(me);
+  } // if
+
+  return;
+
+} // agcTraceRecorder_destroy
+
+/*****************************************************************************
+
+  Name: agcTraceRecorder_start
+
+  Purpose: The purpose of this function is to create a trace file, and
+  to start the writer thread that drains the ring buffer into it.
+
+  Calling Sequence: success = agcTraceRecorder_start(recorderPtr,
+                                                     fileNamePtr)
+
+  Inputs:
+
+    recorderPtr - A pointer to the recorder.
+
+    fileNamePtr - The name of the trace file.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the recorder was
+    started.  A value of 1 indicates that the recorder was started, and
+    a value of 0 indicates that it was already running, or that the file
+    or the thread could not be created.
+
+*****************************************************************************/
+int agcTraceRecorder_start(struct agcTraceRecorder *me,
+    const char *fileNamePtr)
+{
+  int success;
+  struct agcTraceFileHeader header;
+
+  // Default to failure.
+  success = 0;
+
+  if (!me->running)
+  {
+    me->filePtr = fopen(fileNamePtr,"wb");
+
+    if (me->filePtr != NULL)
+    {
+      memset(&header,0,sizeof(header));
+      memcpy(header.magic,AGC_TRACE_MAGIC,sizeof(header.magic));
+      header.version = AGC_TRACE_VERSION;
+      header.recordSize = sizeof(struct agcTraceRecord);
+
+      fwrite(&header,sizeof(header),1,me->filePtr);
+
+      me->stopRequested = 0;
+
+      if (pthread_create(&me->writerThread,NULL,runWriter,me) == 0)
+      {
+        me->running = 1;
+
+        // Indicate success.
+        success = 1;
+      } // if
+      else
+      {
+        fclose(me->filePtr);
+        me->filePtr = NULL;
+      } // else
+    } // if
+  } // if
+
+  return (success);
+
+} // agcTraceRecorder_start
+
+/*****************************************************************************
+
+  Name: agcTraceRecorder_stop
+
+  Purpose: The purpose of this function is to stop the writer thread.
+  The records that are in the ring buffer are written before the trace
+  file is closed.
+
+  Calling Sequence: success = agcTraceRecorder_stop(recorderPtr)
+
+  Inputs:
+
+    recorderPtr - A pointer to the recorder.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the recorder was
+    stopped.  A value of 1 indicates that the recorder was stopped, and
+    a value of 0 indicates that it was not running.
+
+*****************************************************************************/
+int agcTraceRecorder_stop(struct agcTraceRecorder *me)
+{
+  int success;
+
+  // Default to failure.
+  success = 0;
+
+  if (me->running)
+  {
+    __atomic_store_n(&me->stopRequested,1,__ATOMIC_RELEASE);
+
+    pthread_join(me->writerThread,NULL);
+
+    fclose(me->filePtr);
+    me->filePtr = NULL;
+
+    me->running = 0;
+
+    // Indicate success.
+    success = 1;
+  } // if
+
+  return (success);
+
+} // agcTraceRecorder_stop
+
+/*****************************************************************************
+
+  Name: agcTraceRecorder_record
+
+  Purpose: The purpose of this function is to add a record to the ring
+  buffer.  Only one thread may add records to a given recorder.  The
+  function never blocks: if the ring buffer is full, the record is
+  dropped and counted.
+
+  Calling Sequence: agcTraceRecorder_record(recorderPtr,recordPtr)
+
+  Inputs:
+
+    recorderPtr - A pointer to the recorder.
+
+    recordPtr - A pointer to the record.
+
+  Outputs:
+
+    None.
+
+*****************************************************************************/
+void agcTraceRecorder_record(struct agcTraceRecorder *me,
+    const struct agcTraceRecord *recordPtr)
+{
+  uint64_t head;
+
+  head = me->head;
+
+  if ((head - me->cachedTail) >= me->capacity)
+  {
+    // It looks full, so find out how far the writer has gotten.
+    me->cachedTail = __atomic_load_n(&me->tail,__ATOMIC_ACQUIRE);
+  } // if
+
+  if ((head - me->cachedTail) < me->capacity)
+  {
+    me->ringPtr[head & me->mask] = *recordPtr;
+
+    // Hand the record to the writer.
+    __atomic_store_n(&me->head,head + 1,__ATOMIC_RELEASE);
+  } // if
+  else
+  {
+    __atomic_store_n(&me->droppedCount,
+                     me->droppedCount + 1,
+                     __ATOMIC_RELAXED);
+  } // else
+
+  return;
+
+} // agcTraceRecorder_record
+
+/*****************************************************************************
+
+  Name: agcTraceRecorder_getRecordedCount
+
+  Purpose: The purpose of this function is to retrieve the number of
+  records that were added to the ring buffer.
+
+  Calling Sequence: count = agcTraceRecorder_getRecordedCount(recorderPtr)
+
+  Inputs:
+
+    recorderPtr - A pointer to the recorder.
+
+  Outputs:
+
+    count - The number of records.
+
+*****************************************************************************/
+uint64_t agcTraceRecorder_getRecordedCount(struct agcTraceRecorder *me)
+{
+
+  return (__atomic_load_n(&me->head,__ATOMIC_RELAXED));
+
+} // agcTraceRecorder_getRecordedCount
+
+/*****************************************************************************
+
+  Name: agcTraceRecorder_getDroppedCount
+
+  Purpose: The purpose of this function is to retrieve the number of
+  records that were dropped because the ring buffer was full.
+
+  Calling Sequence: count = agcTraceRecorder_getDroppedCount(recorderPtr)
+
+  Inputs:
+
+    recorderPtr - A pointer to the recorder.
+
+  Outputs:
+
+    count - The number of records.
+
+*****************************************************************************/
+uint64_t agcTraceRecorder_getDroppedCount(struct agcTraceRecorder *me)
+{
+
+  return (__atomic_load_n(&me->droppedCount,__ATOMIC_RELAXED));
+
+} // agcTraceRecorder_getDroppedCount
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// Static functions.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+/*****************************************************************************
+
+  Name: runWriter
+
+  Purpose: The purpose of this function is to be the entry point of the
+  writer thread.  The thread drains the ring buffer into the trace
+  file, and it sleeps whenever the ring buffer is empty.  When it is
+  told to stop, it drains the ring buffer one last time.
+
+  Calling Sequence: runWriter(argPtr)
+
+  Inputs:
+
+    argPtr - A pointer to the recorder.
+
+  Outputs:
+
+    NULL.
+
+*****************************************************************************/
+void *runWriter(void *argPtr)
+{
+  struct agcTraceRecorder *me;
+  struct timespec idleTime;
+
+  me = (struct agcTraceRecorder *)argPtr;
+
+  idleTime.tv_sec = 0;
+  idleTime.tv_nsec = WRITER_IDLE_TIME_IN_NS;
+
+  while (!__atomic_load_n(&me->stopRequested,__ATOMIC_ACQUIRE))
+  {
+    if (drain(me) == 0)
+    {
+      nanosleep(&idleTime,NULL);
+    } // if
+  } // while
+
+  // Don't leave anything behind.
+  drain(me);
+
+  return (NULL);
+
+} // runWriter
+
+/*****************************************************************************
+
+  Name: drain
+
+  Purpose: The purpose of this function is to write the records that
+  are in the ring buffer to the trace file.  A wrapped region is
+  written as two pieces.
+
+  Calling Sequence: count = drain(recorderPtr)
+
+  Inputs:
+
+    recorderPtr - A pointer to the recorder.
+
+  Outputs:
+
+    count - The number of records that were written.
+
+*****************************************************************************/
+uint64_t drain(struct agcTraceRecorder *me)
+{
+  uint64_t head;
+  uint64_t tail;
+  uint64_t count;
+  uint64_t chunk;
+
+  head = __atomic_load_n(&me->head,__ATOMIC_ACQUIRE);
+  tail = me->tail;
+  count = head - tail;
+
+  while (tail != head)
+  {
+    // Stop at the end of the ring buffer.
+    chunk = head - tail;
+
+    if (chunk > (me->capacity - (tail & me->mask)))
+    {
+      chunk = me->capacity - (tail & me->mask);
+    } // if
+
+    fwrite(&me->ringPtr[tail & me->mask],
+           sizeof(struct agcTraceRecord),
+           chunk,
+           me->filePtr);
+
+    tail += chunk;
+
+    // Give the space back to the producer.
+    __atomic_store_n(&me->tail,tail,__ATOMIC_RELEASE);
+  } // while
+
+  return (count);
+
+} // drain
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// End of static functions
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
@@ -0,0 +1,1024 @@
+//*******************************************************************
+// File: batchReplayAgc.cc
+// This program replays many rtl_sdr recordings through the AGC, for
+// example an archive of captures after the AGC parameters have been
+// changed.  Each recording gets its own replay (see agcReplay.h), and
+// so its own AGC instance, and the recordings are spread over a pool
+// of worker threads.
+//
+// The recordings are dealt out to the workers, largest first, and each
+// worker takes recordings from the front of its own queue.  A worker
+// whose queue is empty steals from the back of another worker's queue,
+// so that a few long recordings do not leave the other processors
+// idle.  A recording is read in pieces of a fixed size into a buffer
+// that belongs to the worker, so the memory that is used does not
+// depend on the size of the recordings.
+//
+// The results of each recording are printed in the order that the
+// recordings were given, as one JSON object per line:
+//
+//   {"file":"a.bin","recordedSeconds":30.000,"hardwareWrites":104,
+//    "writesPerMinute":208.0,"convergenceSeconds":0.024,
+//    "inBandFraction":0.960,"clippedFraction":0.012,"finalGainDb":19}
+//
+// A recording that could not be read is printed with an "error"
+// member instead.  The summary of the batch is printed to stderr as a
+// JSON object.
+//
+// Usage: batchReplayAgc [options] [file.bin ...]
+//
+//   -l listFile      Also replay the files named in listFile, one per
+//                    line.
+//   -j threads       Worker threads (default: all processors).
+//   -q               Only print the summary.
+//   -b samples       Samples per block (default 16384).
+//   -r sampleRate    Sample rate of the recordings (default 2048000).
+//   -g gainDb        Gain that the recordings were made with
+//                    (default 24).
+//   -i gainDb        Gain that the AGC starts from (default 24).
+//   -o dBFs          AGC operating point (default -12).
+//   -a alpha         AGC filter coefficient (default 0.7).
+//   -D deadbandDb    AGC deadband (default 1).
+//   -B blankingLimit AGC blanking limit (default 1).
+//*******************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include "agcReplay.h"
+
+// Each read fills this many blocks of the worker's buffer.
+#define BLOCKS_PER_READ (64)
+
+// The longest path in a list file.
+#define MAX_PATH_LENGTH (4096)
+
+// One recording, and the results of replaying it.
+struct recording
+{
+  char *fileNamePtr;
+  uint64_t fileSize;
+
+  int replayed;
+  struct agcReplayResults results;
+};
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// The recordings of a worker that have not been replayed yet, as
+// indices into the list of recordings.  The owner takes them from
+// the head, and thieves take them from the tail.  A queue is only
+// touched once per recording, so a lock costs nothing here.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+struct workQueue
+{
+  pthread_mutex_t lock;
+  uint32_t *indexPtr;
+  uint32_t head;
+  uint32_t tail;
+};
+
+// The work that is shared by the worker threads.
+struct batchJob
+{
+  struct recording *recordingPtr;
+  uint32_t recordingCount;
+
+  struct workQueue *queuePtr;
+  uint32_t workerCount;
+
+  // Recordings that were taken from another worker's queue.
+  uint32_t stolenCount;
+
+  struct agcReplayConfig config;
+  uint32_t samplesPerBlock;
+};
+
+// A recording in the order that the recordings are dealt out.
+struct orderEntry
+{
+  uint64_t fileSize;
+  uint32_t index;
+};
+
+// The argument of a worker thread.
+struct worker
+{
+  struct batchJob *jobPtr;
+  uint32_t id;
+};
+
+/**************************************************************************
+
+  Name: getTimeInSeconds
+
+  Purpose: The purpose of this function is to read the monotonic clock.
+
+  Calling Sequence: t = getTimeInSeconds()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    t - The time in seconds.
+
+**************************************************************************/
+static double getTimeInSeconds(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC,&now);
+
+  return ((double)now.tv_sec + ((double)now.tv_nsec * 1e-9));
+
+} // getTimeInSeconds
+
+/**************************************************************************
+
+  Name: takeRecording
+
+  Purpose: The purpose of this function is to take the next recording
+  from the head of a worker's own queue.
+
+  Calling Sequence: found = takeRecording(queuePtr,indexPtr)
+
+  Inputs:
+
+    queuePtr - A pointer to the worker's queue.
+
+    indexPtr - A pointer to storage for the index of the recording.
+
+  Outputs:
+
+    found - A flag that indicates whether or not a recording was taken.
+    A value of 0 indicates that the queue is empty.
+
+**************************************************************************/
+static int takeRecording(struct workQueue *queuePtr,uint32_t *indexPtr)
+{
+  int found;
+
+  pthread_mutex_lock(&queuePtr->lock);
+
+  found = (queuePtr->head < queuePtr->tail);
+
+  if (found)
+  {
+    *indexPtr = queuePtr->indexPtr[queuePtr->head++];
+  } // if
+
+  pthread_mutex_unlock(&queuePtr->lock);
+
+  return (found);
+
+} // takeRecording
+
+/**************************************************************************
+
+  Name: stealRecording
+
+  Purpose: The purpose of this function is to take a recording from the
+  tail of another worker's queue.  The other workers are tried in turn,
+  starting with the next one.
+
+  Calling Sequence: found = stealRecording(jobPtr,thiefId,indexPtr)
+
+  Inputs:
+
+    jobPtr - A pointer to the job.
+
+    thiefId - The number of the worker that is stealing.
+
+    indexPtr - A pointer to storage for the index of the recording.
+
+  Outputs:
+
+    found - A flag that indicates whether or not a recording was taken.
+    A value of 0 indicates that every queue is empty.
+
+**************************************************************************/
+static int stealRecording(struct batchJob *jobPtr,
+    uint32_t thiefId,
+    uint32_t *indexPtr)
+{
+  int found;
+  uint32_t i;
+  struct workQueue *queuePtr;
+
+  found = 0;
+
+  for (i = 1; (i < jobPtr->workerCount) && !found; i++)
+  {
+    queuePtr = &jobPtr->queuePtr[(thiefId + i) % jobPtr->workerCount];
+
+    pthread_mutex_lock(&queuePtr->lock);
+
+    found = (queuePtr->head < queuePtr->tail);
+
+    if (found)
+    {
+      *indexPtr = queuePtr->indexPtr[--queuePtr->tail];
+    } // if
+
+    pthread_mutex_unlock(&queuePtr->lock);
+  } // for
+
+  if (found)
+  {
+    __atomic_fetch_add(&jobPtr->stolenCount,1,__ATOMIC_RELAXED);
+  } // if
+
+  return (found);
+
+} // stealRecording
+
+/**************************************************************************
+
+  Name: readFully
+
+  Purpose: The purpose of this function is to read until a buffer is
+  full, or until the end of the file.
+
+  Calling Sequence: byteCount = readFully(fd,bufferPtr,bufferSize)
+
+  Inputs:
+
+    fd - The file descriptor.
+
+    bufferPtr - A pointer to the buffer.
+
+    bufferSize - The size of the buffer.
+
+  Outputs:
+
+    byteCount - The number of bytes that were read.  A value less than
+    bufferSize indicates the end of the file, or an error.
+
+**************************************************************************/
+static size_t readFully(int fd,uint8_t *bufferPtr,size_t bufferSize)
+{
+  size_t byteCount;
+  ssize_t result;
+
+  byteCount = 0;
+  result = 1;
+
+  while ((byteCount < bufferSize) && (result > 0))
+  {
+    result = read(fd,&bufferPtr[byteCount],bufferSize - byteCount);
+
+    if (result > 0)
+    {
+      byteCount += (size_t)result;
+    } // if
+  } // while
+
+  return (byteCount);
+
+} // readFully
+
+/**************************************************************************
+
+  Name: replayRecording
+
+  Purpose: The purpose of this function is to replay one recording
+  through a new AGC, a buffer at a time.
+
+  Calling Sequence: replayRecording(jobPtr,recordingPtr,bufferPtr,
+                                    bufferSize)
+
+  Inputs:
+
+    jobPtr - A pointer to the job.
+
+    recordingPtr - A pointer to the recording.
+
+    bufferPtr - A pointer to the worker's buffer.
+
+    bufferSize - The size of the buffer, which is a whole number of
+    blocks.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void replayRecording(struct batchJob *jobPtr,
+    struct recording *recordingPtr,
+    uint8_t *bufferPtr,
+    size_t bufferSize)
+{
+  int fd;
+  int moreData;
+  size_t byteCount;
+  size_t offset;
+  uint32_t sampleCount;
+  struct agcReplay *replayPtr;
+
+  fd = open(recordingPtr->fileNamePtr,O_RDONLY);
+
+  if (fd >= 0)
+  {
+    posix_fadvise(fd,0,0,POSIX_FADV_SEQUENTIAL);
+
+    replayPtr = agcReplay_create(&jobPtr->config);
+
+    if (replayPtr != NULL)
+    {
+      moreData = 1;
+
+      while (moreData)
+      {
+        byteCount = readFully(fd,bufferPtr,bufferSize);
+        moreData = (byteCount == bufferSize);
+
+        // A trailing odd byte is not a sample.
+        for (offset = 0; (offset + 2) <= byteCount;
+             offset += 2 * (size_t)sampleCount)
+        {
+          sampleCount = jobPtr->samplesPerBlock;
+
+          if ((offset + (2 * (size_t)sampleCount)) > byteCount)
+          {
+            sampleCount = (uint32_t)((byteCount - offset) / 2);
+          } // if
+
+          agcReplay_acceptIqBlockU8(replayPtr,
+                                    &bufferPtr[offset],
+                                    sampleCount,
+                                    NULL);
+        } // for
+      } // while
+
+      agcReplay_getResults(replayPtr,&recordingPtr->results);
+      agcReplay_destroy(replayPtr);
+
+      recordingPtr->replayed = (recordingPtr->results.sampleCount != 0);
+    } // if
+
+    close(fd);
+  } // if
+
+  return;
+
+} // replayRecording
+
+/**************************************************************************
+
+  Name: runWorker
+
+  Purpose: The purpose of this function is to be the entry point of a
+  worker thread.  The thread replays the recordings of its own queue,
+  and then those that it can steal, until there are none left.
+
+  Calling Sequence: runWorker(argPtr)
+
+  Inputs:
+
+    argPtr - A pointer to the worker.
+
+  Outputs:
+
+    NULL.
+
+**************************************************************************/
+static void *runWorker(void *argPtr)
+{
+  uint32_t i;
+  size_t bufferSize;
+  uint8_t *bufferPtr;
+  struct worker *workerPtr;
+  struct batchJob *jobPtr;
+
+  workerPtr = (struct worker *)argPtr;
+  jobPtr = workerPtr->jobPtr;
+
+  bufferSize = (size_t)BLOCKS_PER_READ * jobPtr->samplesPerBlock * 2;
+  bufferPtr = (uint8_t *)malloc(bufferSize);
+
+  if (bufferPtr != NULL)
+  {
+    while (takeRecording(&jobPtr->queuePtr[workerPtr->id],&i) ||
+           stealRecording(jobPtr,workerPtr->id,&i))
+    {
+      replayRecording(jobPtr,&jobPtr->recordingPtr[i],
+                      bufferPtr,bufferSize);
+    } // while
+
+    free(bufferPtr);
+  } // if
+
+  return (NULL);
+
+} // runWorker
+
+/**************************************************************************
+
+  Name: addRecording
+
+  Purpose: The purpose of this function is to append a recording to the
+  list of recordings.
+
+  Calling Sequence: addRecording(jobPtr,fileNamePtr,capacityPtr)
+
+  Inputs:
+
+    jobPtr - A pointer to the job.
+
+    fileNamePtr - The name of the recording.
+
+    capacityPtr - A pointer to the capacity of the list.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void addRecording(struct batchJob *jobPtr,
+    const char *fileNamePtr,
+    uint32_t *capacityPtr)
+{
+  struct stat fileStatus;
+  struct recording *recordingPtr;
+
+  if (jobPtr->recordingCount == *capacityPtr)
+  {
+    *capacityPtr = (*capacityPtr == 0) ? 1024 : *capacityPtr * 2;
+
+    jobPtr->recordingPtr =
+      (struct recording *)realloc(jobPtr->recordingPtr,
+                                  *capacityPtr * sizeof(struct recording));
+  } // if
+
+  recordingPtr = &jobPtr->recordingPtr[jobPtr->recordingCount++];
+
+  memset(recordingPtr,0,sizeof(struct recording));
+  recordingPtr->fileNamePtr = strdup(fileNamePtr);
+
+  if (stat(fileNamePtr,&fileStatus) == 0)
+  {
+    recordingPtr->fileSize = (uint64_t)fileStatus.st_size;
+  } // if
+
+  return;
+
+} // addRecording
+
+/**************************************************************************
+
+  Name: loadFileList
+
+  Purpose: The purpose of this function is to add the recordings that
+  are named in a list file, one per line, to the list of recordings.
+  Blank lines are skipped.
+
+  Calling Sequence: success = loadFileList(jobPtr,listFileNamePtr,
+                                           capacityPtr)
+
+  Inputs:
+
+    jobPtr - A pointer to the job.
+
+    listFileNamePtr - The name of the list file.
+
+    capacityPtr - A pointer to the capacity of the list.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the list file was
+    read.
+
+**************************************************************************/
+static int loadFileList(struct batchJob *jobPtr,
+    const char *listFileNamePtr,
+    uint32_t *capacityPtr)
+{
+  FILE *filePtr;
+  size_t length;
+  char line[MAX_PATH_LENGTH];
+
+  filePtr = fopen(listFileNamePtr,"r");
+
+  if (filePtr == NULL)
+  {
+    return (0);
+  } // if
+
+  while (fgets(line,sizeof(line),filePtr) != NULL)
+  {
+    length = strcspn(line,"\r\n");
+    line[length] = '\0';
+
+    if (length != 0)
+    {
+      addRecording(jobPtr,line,capacityPtr);
+    } // if
+  } // while
+
+  fclose(filePtr);
+
+  return (1);
+
+} // loadFileList
+
+/**************************************************************************
+
+  Name: compareDouble
+
+  Purpose: The purpose of this function is to order two doubles for
+  qsort().
+
+  Calling Sequence: result = compareDouble(aPtr,bPtr)
+
+  Inputs:
+
+    aPtr - A pointer to the first double.
+
+    bPtr - A pointer to the second double.
+
+  Outputs:
+
+    result - A negative, zero or positive value as the first double is
+    less than, equal to or greater than the second.
+
+**************************************************************************/
+static int compareDouble(const void *aPtr,const void *bPtr)
+{
+  double a;
+  double b;
+
+  a = *(const double *)aPtr;
+  b = *(const double *)bPtr;
+
+  return ((a > b) - (a < b));
+
+} // compareDouble
+
+/**************************************************************************
+
+  Name: compareSize
+
+  Purpose: The purpose of this function is to order two recordings for
+  qsort(), largest first.  Recordings of the same size stay in the order
+  that they were given, which keeps the schedule repeatable.
+
+  Calling Sequence: result = compareSize(aPtr,bPtr)
+
+  Inputs:
+
+    aPtr - A pointer to the first recording's order entry.
+
+    bPtr - A pointer to the second recording's order entry.
+
+  Outputs:
+
+    result - A negative, zero or positive value as the first recording
+    goes before, with or after the second.
+
+**************************************************************************/
+static int compareSize(const void *aPtr,const void *bPtr)
+{
+  int result;
+  const struct orderEntry *a;
+  const struct orderEntry *b;
+
+  a = (const struct orderEntry *)aPtr;
+  b = (const struct orderEntry *)bPtr;
+
+  result = (a->fileSize < b->fileSize) - (a->fileSize > b->fileSize);
+
+  if (result == 0)
+  {
+    result = (a->index > b->index) - (a->index < b->index);
+  } // if
+
+  return (result);
+
+} // compareSize
+
+/**************************************************************************
+
+  Name: dealRecordings
+
+  Purpose: The purpose of this function is to deal the recordings out
+  to the worker queues, largest first, so that the queues start out
+  with similar amounts of work.
+
+  Calling Sequence: success = dealRecordings(jobPtr)
+
+  Inputs:
+
+    jobPtr - A pointer to the job.
+
+  Outputs:
+
+    success - A flag that indicates whether or not memory could be
+    allocated for the queues.
+
+**************************************************************************/
+static int dealRecordings(struct batchJob *jobPtr)
+{
+  int success;
+  uint32_t i;
+  struct orderEntry *orderPtr;
+  struct workQueue *queuePtr;
+
+  jobPtr->queuePtr =
+    (struct workQueue *)calloc(jobPtr->workerCount,sizeof(struct workQueue));
+  orderPtr = (struct orderEntry *)malloc(jobPtr->recordingCount *
+                                         sizeof(struct orderEntry));
+
+  success = (jobPtr->queuePtr != NULL) && (orderPtr != NULL);
+
+  for (i = 0; (i < jobPtr->workerCount) && success; i++)
+  {
+    pthread_mutex_init(&jobPtr->queuePtr[i].lock,NULL);
+
+    jobPtr->queuePtr[i].indexPtr =
+      (uint32_t *)malloc(jobPtr->recordingCount * sizeof(uint32_t));
+
+    success = (jobPtr->queuePtr[i].indexPtr != NULL);
+  } // for
+
+  if (success)
+  {
+    for (i = 0; i < jobPtr->recordingCount; i++)
+    {
+      orderPtr[i].fileSize = jobPtr->recordingPtr[i].fileSize;
+      orderPtr[i].index = i;
+    } // for
+
+    qsort(orderPtr,jobPtr->recordingCount,sizeof(struct orderEntry),
+          compareSize);
+
+    for (i = 0; i < jobPtr->recordingCount; i++)
+    {
+      queuePtr = &jobPtr->queuePtr[i % jobPtr->workerCount];
+      queuePtr->indexPtr[queuePtr->tail++] = orderPtr[i].index;
+    } // for
+  } // if
+
+  free(orderPtr);
+
+  return (success);
+
+} // dealRecordings
+
+/**************************************************************************
+
+  Name: printResults
+
+  Purpose: The purpose of this function is to print the results of
+  each recording, unless quiet, and the summary of the batch.
+
+  Calling Sequence: printResults(jobPtr,quiet,wallSeconds)
+
+  Inputs:
+
+    jobPtr - A pointer to the job.
+
+    quiet - A flag that indicates that only the summary is printed.
+
+    wallSeconds - The time that the batch took.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void printResults(struct batchJob *jobPtr,
+    int quiet,
+    double wallSeconds)
+{
+  uint32_t i;
+  uint32_t failedCount;
+  uint32_t convergedCount;
+  uint64_t blockCount;
+  uint64_t inBandBlockCount;
+  uint64_t clippedBlockCount;
+  uint64_t hardwareWriteCount;
+  uint64_t byteCount;
+  double recordedSeconds;
+  double totalRecordedSeconds;
+  double totalConvergenceTime;
+  double *convergenceTimePtr;
+  struct recording *recordingPtr;
+  struct agcReplayResults *resultsPtr;
+
+  failedCount = 0;
+  convergedCount = 0;
+  blockCount = 0;
+  inBandBlockCount = 0;
+  clippedBlockCount = 0;
+  hardwareWriteCount = 0;
+  byteCount = 0;
+  totalRecordedSeconds = 0;
+  totalConvergenceTime = 0;
+
+  convergenceTimePtr =
+    (double *)malloc((jobPtr->recordingCount + 1) * sizeof(double));
+
+  for (i = 0; i < jobPtr->recordingCount; i++)
+  {
+    recordingPtr = &jobPtr->recordingPtr[i];
+    resultsPtr = &recordingPtr->results;
+
+    if (recordingPtr->replayed)
+    {
+      recordedSeconds =
+        (double)resultsPtr->sampleCount / jobPtr->config.sampleRate;
+
+      totalRecordedSeconds += recordedSeconds;
+      blockCount += resultsPtr->blockCount;
+      inBandBlockCount += resultsPtr->inBandBlockCount;
+      clippedBlockCount += resultsPtr->clippedBlockCount;
+      hardwareWriteCount += resultsPtr->hardwareWriteCount;
+      byteCount += recordingPtr->fileSize;
+
+      if (resultsPtr->convergenceTimeInSeconds >= 0)
+      {
+        convergenceTimePtr[convergedCount++] =
+          resultsPtr->convergenceTimeInSeconds;
+        totalConvergenceTime += resultsPtr->convergenceTimeInSeconds;
+      } // if
+
+      if (!quiet)
+      {
+        printf("{\"file\":\"%s\",\"recordedSeconds\":%.3f,"
+               "\"hardwareWrites\":%llu,\"writesPerMinute\":%.1f,",
+               recordingPtr->fileNamePtr,
+               recordedSeconds,
+               (unsigned long long)resultsPtr->hardwareWriteCount,
+               (resultsPtr->hardwareWriteCount * 60.0) / recordedSeconds);
+
+        if (resultsPtr->convergenceTimeInSeconds >= 0)
+        {
+          printf("\"convergenceSeconds\":%.3f,",
+                 resultsPtr->convergenceTimeInSeconds);
+        } // if
+        else
+        {
+          printf("\"convergenceSeconds\":null,");
+        } // else
+
+        printf("\"inBandFraction\":%.3f,\"clippedFraction\":%.3f,"
+               "\"finalGainDb\":%u}\n",
+               (double)resultsPtr->inBandBlockCount /
+                 resultsPtr->blockCount,
+               (double)resultsPtr->clippedBlockCount /
+                 resultsPtr->blockCount,
+               resultsPtr->finalGainInDb);
+      } // if
+    } // if
+    else
+    {
+      failedCount++;
+
+      if (!quiet)
+      {
+        printf("{\"file\":\"%s\",\"error\":\"could not be replayed\"}\n",
+               recordingPtr->fileNamePtr);
+      } // if
+    } // else
+  } // for
+
+  fflush(stdout);
+
+  // Only the converged recordings have a convergence time.
+  qsort(convergenceTimePtr,convergedCount,sizeof(double),compareDouble);
+
+  if (convergedCount == 0)
+  {
+    convergenceTimePtr[0] = 0;
+  } // if
+
+  fprintf(stderr,"{\"files\":%u,\"failedFiles\":%u,\"threads\":%u,"
+          "\"steals\":%u,\"recordedHours\":%.3f,\"wallSeconds\":%.3f,"
+          "\"realTimeFactor\":%.0f,\"megabytesPerSecond\":%.0f,"
+          "\"hardwareWrites\":%llu,\"writesPerMinute\":%.1f,"
+          "\"convergedFiles\":%u,\"meanConvergenceSeconds\":%.3f,"
+          "\"medianConvergenceSeconds\":%.3f,"
+          "\"p95ConvergenceSeconds\":%.3f,\"maxConvergenceSeconds\":%.3f,"
+          "\"inBandFraction\":%.3f,\"clippedFraction\":%.3f}\n",
+          jobPtr->recordingCount,
+          failedCount,
+          jobPtr->workerCount,
+          jobPtr->stolenCount,
+          totalRecordedSeconds / 3600,
+          wallSeconds,
+          totalRecordedSeconds / wallSeconds,
+          ((double)byteCount / wallSeconds) * 1e-6,
+          (unsigned long long)hardwareWriteCount,
+          (totalRecordedSeconds > 0) ?
+            (hardwareWriteCount * 60.0) / totalRecordedSeconds : 0.0,
+          convergedCount,
+          (convergedCount != 0) ? totalConvergenceTime / convergedCount : 0,
+          convergenceTimePtr[convergedCount / 2],
+          convergenceTimePtr[(convergedCount * 95) / 100],
+          convergenceTimePtr[(convergedCount != 0) ?
+                             convergedCount - 1 : 0],
+          (blockCount != 0) ? (double)inBandBlockCount / blockCount : 0,
+          (blockCount != 0) ? (double)clippedBlockCount / blockCount : 0);
+
+  free(convergenceTimePtr);
+
+  return;
+
+} // printResults
+
+//************************************************************
+// Mainline code.
+//************************************************************
+int main(int argc,char **argv)
+{
+  int i;
+  int option;
+  int quiet;
+  uint32_t capacity;
+  uint32_t threadCount;
+  double startTime;
+  pthread_t *threadPtr;
+  struct worker *workerPtr;
+  struct batchJob job;
+
+  memset(&job,0,sizeof(job));
+  agcReplay_getDefaultConfig(&job.config);
+
+  job.samplesPerBlock = 16384;
+  threadCount = (uint32_t)sysconf(_SC_NPROCESSORS_ONLN);
+  quiet = 0;
+  capacity = 0;
+
+  while ((option = getopt(argc,argv,"l:j:qb:r:g:i:o:a:D:B:")) != -1)
+  {
+    switch (option)
+    {
+      case 'l':
+      {
+        if (!loadFileList(&job,optarg,&capacity))
+        {
+          fprintf(stderr,"Could not read %s\n",optarg);
+          return (1);
+        } // if
+        break;
+      } // case
+
+      case 'j':
+      {
+        threadCount = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'q':
+      {
+        quiet = 1;
+        break;
+      } // case
+
+      case 'b':
+      {
+        job.samplesPerBlock = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'r':
+      {
+        job.config.sampleRate = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'g':
+      {
+        job.config.recordedGainInDb = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'i':
+      {
+        job.config.initialGainInDb = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'o':
+      {
+        job.config.operatingPointInDbFs = atoi(optarg);
+        break;
+      } // case
+
+      case 'a':
+      {
+        job.config.filterCoefficient = (float)atof(optarg);
+        break;
+      } // case
+
+      case 'D':
+      {
+        job.config.deadbandInDb = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'B':
+      {
+        job.config.blankingLimit = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      default:
+      {
+        fprintf(stderr,"Usage: %s [-l listFile] [-j threads] [-q] "
+                "[-b samples] [-r sampleRate] [-g gainDb] [-i gainDb] "
+                "[-o dBFs] [-a alpha] [-D deadbandDb] [-B blankingLimit] "
+                "[file.bin ...]\n",
+                argv[0]);
+        return (1);
+      } // case
+    } // switch
+  } // while
+
+  for (i = optind; i < argc; i++)
+  {
+    addRecording(&job,argv[i],&capacity);
+  } // for
+
+  if (job.recordingCount == 0)
+  {
+    fprintf(stderr,"No recordings were given.\n");
+    return (1);
+  } // if
+
+  if (job.samplesPerBlock == 0)
+  {
+    job.samplesPerBlock = 16384;
+  } // if
+
+  if (threadCount == 0)
+  {
+    threadCount = 1;
+  } // if
+
+  // Idle workers would only steal from each other.
+  if (threadCount > job.recordingCount)
+  {
+    threadCount = job.recordingCount;
+  } // if
+
+  job.workerCount = threadCount;
+
+  if (!dealRecordings(&job))
+  {
+    fprintf(stderr,"Could not allocate the work queues.\n");
+    return (1);
+  } // if
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Replay the recordings with a pool of worker threads.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  startTime = getTimeInSeconds();
+
+  threadPtr = new pthread_t[threadCount];
+  workerPtr = new struct worker[threadCount];
+
+  for (i = 0; i < (int)threadCount; i++)
+  {
+    workerPtr[i].jobPtr = &job;
+    workerPtr[i].id = (uint32_t)i;
+
+    pthread_create(&threadPtr[i],NULL,runWorker,&workerPtr[i]);
+  } // for
+
+  for (i = 0; i < (int)threadCount; i++)
+  {
+    pthread_join(threadPtr[i],NULL);
+  } // for
+
+  delete[] workerPtr;
+  delete[] threadPtr;
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  printResults(&job,quiet,getTimeInSeconds() - startTime);
+
+  for (i = 0; i < (int)job.workerCount; i++)
+  {
+    pthread_mutex_destroy(&job.queuePtr[i].lock);
+    free(job.queuePtr[i].indexPtr);
+  } // for
+
+  for (i = 0; i < (int)job.recordingCount; i++)
+  {
+    free(job.recordingPtr[i].fileNamePtr);
+  } // for
+
+  free(job.queuePtr);
+  free(job.recordingPtr);
+
+  return (0);
+
+} // main
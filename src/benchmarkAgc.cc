@@ -0,0 +1,940 @@
+//*******************************************************************
+// File: benchmarkAgc.cc
+// This program measures the cost of the AGC hot paths.  The AGC is
+// driven into each of its steady states (blanked, deadband, clamped
+// at the maximum gain, and adjusting on every invocation), and the
+// cost of agc_acceptData() is measured in each of them.  The cost of
+// dbfs_convertMagnitudeToDbFs() is measured for a range of word
+// lengths.  The Agc template of agcTemplate.h, with a lambda for its
+// actuator, is measured in the same states, except for blanked, so
+// that it can be compared with the C AGC.
+//
+// Each benchmark is run several times, and the fastest run is
+// reported.  When the kernel allows it, the processor cycles and the
+// instructions retired are counted with perf_event_open().  Each result
+// is printed as one JSON object per line, so that the results of two
+// releases can be compared by a script:
+//
+//   {"benchmark":"acceptData/blanked","calls":10000000,"nsPerCall":4.21,
+//    "callsPerSec":237529691,"cyclesPerCall":12.6,
+//    "instructionsPerCall":41.0,"stateFraction":1.000}
+//
+// The cycle and instruction counts are null when the counters are not
+// available.  For the acceptData benchmarks, stateFraction is the
+// fraction of the timed invocations that were actually in the intended
+// state, as reported by agc_getStats().
+//
+// Usage: benchmarkAgc [callCount]
+//*******************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "AutomaticGainControl.h"
+#include "dbfsCalculator.h"
+#include "agcTemplate.h"
+
+// The number of times that each benchmark is run.
+#define REPETITIONS (5)
+
+// The default number of calls in each run.
+#define DEFAULT_CALL_COUNT (10000000)
+
+// The number of magnitudes that the dBFs benchmark cycles through.
+#define MAGNITUDE_TABLE_SIZE (4096)
+
+// AGC parameters, matching a 16-bit 2's complement converter.
+#define WORD_LENGTH_IN_BITS (15)
+#define OPERATING_POINT_IN_DBFS (-12)
+#define MAX_AMPLIFIER_GAIN_IN_DB (46)
+
+// Signal magnitudes of interest for 15 magnitude bits.
+#define FULL_SCALE_MAGNITUDE (32767)
+#define WEAK_MAGNITUDE (32)
+#define NEAR_OPERATING_POINT_MAGNITUDE (7334)
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// The hardware counters.  A file descriptor of -1 means that the
+// counters are not available.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+struct perfCounters
+{
+  int groupFd;
+  int instructionsFd;
+};
+
+// The result of one run of a benchmark.
+struct runResult
+{
+  double elapsedInNs;
+  int countersValid;
+  uint64_t cycles;
+  uint64_t instructions;
+};
+
+// The AGC state that a benchmark drives the AGC into.
+enum agcState
+{
+  STATE_BLANKED,
+  STATE_DEADBAND,
+  STATE_CLAMPED,
+  STATE_ADJUSTING
+};
+
+// Stands in for the hardware.
+static uint32_t hardwareGainInDb;
+
+// Keeps the compiler from discarding the dBFs conversions.
+static volatile int32_t sink;
+
+static struct perfCounters counters;
+
+/**************************************************************************
+
+  Name: setGainCallback
+
+  Purpose: The purpose of this function is to stand in for the client
+  callback that sets the amplifier gain.
+
+  Calling Sequence: setGainCallback(gainInDb)
+
+  Inputs:
+
+    gainInDb - The gain in decibels.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void setGainCallback(uint32_t gainInDb)
+{
+
+  hardwareGainInDb = gainInDb;
+
+  return;
+
+} // setGainCallback
+
+/**************************************************************************
+
+  Name: getGainCallback
+
+  Purpose: The purpose of this function is to stand in for the client
+  callback that retrieves the amplifier gain.
+
+  Calling Sequence: gainInDb = getGainCallback()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    gainInDb - The gain in decibels.
+
+**************************************************************************/
+static uint32_t getGainCallback(void)
+{
+
+  return (hardwareGainInDb);
+
+} // getGainCallback
+
+/**************************************************************************
+
+  Name: openCounter
+
+  Purpose: The purpose of this function is to open a hardware counter
+  that counts user space events of the calling thread.
+
+  Calling Sequence: fd = openCounter(config,groupFd)
+
+  Inputs:
+
+    config - The PERF_COUNT_HW_XXX event.
+
+    groupFd - The group leader, or -1 to create a group.
+
+  Outputs:
+
+    fd - The file descriptor of the counter, or -1 if the counter is
+    not available.
+
+**************************************************************************/
+static int openCounter(uint64_t config,int groupFd)
+{
+  struct perf_event_attr attributes;
+
+  memset(&attributes,0,sizeof(attributes));
+  attributes.type = PERF_TYPE_HARDWARE;
+  attributes.size = sizeof(attributes);
+  attributes.config = config;
+  attributes.disabled = (groupFd == -1);
+  attributes.exclude_kernel = 1;
+  attributes.exclude_hv = 1;
+  attributes.read_format = PERF_FORMAT_GROUP;
+
+  return ((int)syscall(__NR_perf_event_open,&attributes,0,-1,groupFd,0));
+
+} // openCounter
+
+/**************************************************************************
+
+  Name: openCounters
+
+  Purpose: The purpose of this function is to open the cycle and
+  instruction counters as a group, so that they count over the same
+  interval.
+
+  Calling Sequence: openCounters(countersPtr)
+
+  Inputs:
+
+    countersPtr - A pointer to the counters.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void openCounters(struct perfCounters *countersPtr)
+{
+
+  countersPtr->instructionsFd = -1;
+
+  countersPtr->groupFd = openCounter(PERF_COUNT_HW_CPU_CYCLES,-1);
+
+  if (countersPtr->groupFd != -1)
+  {
+    countersPtr->instructionsFd =
+      openCounter(PERF_COUNT_HW_INSTRUCTIONS,countersPtr->groupFd);
+
+    if (countersPtr->instructionsFd == -1)
+    {
+      // Half of the group is of no use.
+      close(countersPtr->groupFd);
+      countersPtr->groupFd = -1;
+    } // if
+  } // if
+
+  return;
+
+} // openCounters
+
+/**************************************************************************
+
+  Name: startRun
+
+  Purpose: The purpose of this function is to start timing a run.
+
+  Calling Sequence: startRun(startTimePtr)
+
+  Inputs:
+
+    startTimePtr - A pointer to storage for the start time.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void startRun(struct timespec *startTimePtr)
+{
+
+  if (counters.groupFd != -1)
+  {
+    ioctl(counters.groupFd,PERF_EVENT_IOC_RESET,PERF_IOC_FLAG_GROUP);
+    ioctl(counters.groupFd,PERF_EVENT_IOC_ENABLE,PERF_IOC_FLAG_GROUP);
+  } // if
+
+  clock_gettime(CLOCK_MONOTONIC,startTimePtr);
+
+  return;
+
+} // startRun
+
+/**************************************************************************
+
+  Name: stopRun
+
+  Purpose: The purpose of this function is to stop timing a run, and
+  to collect its measurements.
+
+  Calling Sequence: stopRun(startTimePtr,resultPtr)
+
+  Inputs:
+
+    startTimePtr - A pointer to the start time.
+
+    resultPtr - A pointer to storage for the measurements.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void stopRun(const struct timespec *startTimePtr,
+    struct runResult *resultPtr)
+{
+  struct timespec stopTime;
+  uint64_t values[3];
+
+  clock_gettime(CLOCK_MONOTONIC,&stopTime);
+
+  resultPtr->elapsedInNs =
+    ((double)(stopTime.tv_sec - startTimePtr->tv_sec) * 1e9) +
+    (double)(stopTime.tv_nsec - startTimePtr->tv_nsec);
+
+  resultPtr->countersValid = 0;
+
+  if (counters.groupFd != -1)
+  {
+    ioctl(counters.groupFd,PERF_EVENT_IOC_DISABLE,PERF_IOC_FLAG_GROUP);
+
+    // The group format is the number of counters followed by the values.
+    if (read(counters.groupFd,values,sizeof(values)) == sizeof(values))
+    {
+      resultPtr->countersValid = (values[0] == 2);
+      resultPtr->cycles = values[1];
+      resultPtr->instructions = values[2];
+    } // if
+  } // if
+
+  return;
+
+} // stopRun
+
+/**************************************************************************
+
+  Name: keepFastest
+
+  Purpose: The purpose of this function is to keep the fastest of the
+  runs of a benchmark.
+
+  Calling Sequence: keepFastest(runPtr,bestPtr,firstRun)
+
+  Inputs:
+
+    runPtr - A pointer to the run that just finished.
+
+    bestPtr - A pointer to the fastest run so far.
+
+    firstRun - A flag that indicates whether or not this is the first
+    run, in which case it is the fastest.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void keepFastest(const struct runResult *runPtr,
+    struct runResult *bestPtr,
+    int firstRun)
+{
+
+  if (firstRun || (runPtr->elapsedInNs < bestPtr->elapsedInNs))
+  {
+    *bestPtr = *runPtr;
+  } // if
+
+  return;
+
+} // keepFastest
+
+/**************************************************************************
+
+  Name: reportResult
+
+  Purpose: The purpose of this function is to print the result of a
+  benchmark as a JSON object.
+
+  Calling Sequence: reportResult(namePtr,callCount,resultPtr,
+                                 stateFraction)
+
+  Inputs:
+
+    namePtr - The name of the benchmark.
+
+    callCount - The number of calls in a run.
+
+    resultPtr - A pointer to the fastest run.
+
+    stateFraction - The fraction of the calls that were in the intended
+    state.  A negative value means that it does not apply.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void reportResult(const char *namePtr,
+    uint32_t callCount,
+    const struct runResult *resultPtr,
+    double stateFraction)
+{
+  double nsPerCall;
+
+  nsPerCall = resultPtr->elapsedInNs / callCount;
+
+  printf("{\"benchmark\":\"%s\",\"calls\":%u,\"nsPerCall\":%.3f,"
+         "\"callsPerSec\":%.0f",
+         namePtr,callCount,nsPerCall,1e9 / nsPerCall);
+
+  if (resultPtr->countersValid)
+  {
+    printf(",\"cyclesPerCall\":%.2f,\"instructionsPerCall\":%.2f",
+           (double)resultPtr->cycles / callCount,
+           (double)resultPtr->instructions / callCount);
+  } // if
+  else
+  {
+    printf(",\"cyclesPerCall\":null,\"instructionsPerCall\":null");
+  } // else
+
+  if (stateFraction >= 0)
+  {
+    printf(",\"stateFraction\":%.3f",stateFraction);
+  } // if
+
+  printf("}\n");
+
+  return;
+
+} // reportResult
+
+/**************************************************************************
+
+  Name: prepareAgc
+
+  Purpose: The purpose of this function is to initialize the AGC and to
+  drive it into a steady state.
+
+    Blanked - Duration blanking with an endless duration, after one
+    gain adjustment.
+
+    Deadband - A signal 1 dB below the operating point, with a deadband
+    of 2 dB.
+
+    Clamped - A weak signal, with the gain at its maximum.
+
+    Adjusting - A signal that alternates between full scale and weak,
+    with no deadband and no blanking, so that every invocation writes a
+    new gain.
+
+  Calling Sequence: prepareAgc(state,magnitudes)
+
+  Inputs:
+
+    state - The state of interest.
+
+    magnitudes - Storage for the two magnitudes that the benchmark
+    alternates between.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void prepareAgc(enum agcState state,uint32_t magnitudes[2])
+{
+  int i;
+
+  hardwareGainInDb = 24;
+
+  agc_init(OPERATING_POINT_IN_DBFS,
+           MAX_AMPLIFIER_GAIN_IN_DB,
+           WORD_LENGTH_IN_BITS,
+           setGainCallback,
+           getGainCallback);
+
+  agc_setAgcFilterCoefficient(0.7);
+  agc_setDeadband(0);
+  agc_setBlankingLimit(0);
+  agc_enable();
+
+  switch (state)
+  {
+    case STATE_BLANKED:
+    {
+      agc_setBlankingMode(AGC_BLANKING_BY_DURATION);
+      agc_setBlankingDuration(UINT64_MAX);
+
+      // Adjust once, and stay blanked from then on.
+      agc_acceptData(FULL_SCALE_MAGNITUDE);
+
+      magnitudes[0] = FULL_SCALE_MAGNITUDE;
+      magnitudes[1] = WEAK_MAGNITUDE;
+      break;
+    } // case
+
+    case STATE_DEADBAND:
+    {
+      agc_setDeadband(2);
+
+      magnitudes[0] = NEAR_OPERATING_POINT_MAGNITUDE;
+      magnitudes[1] = NEAR_OPERATING_POINT_MAGNITUDE;
+      break;
+    } // case
+
+    case STATE_CLAMPED:
+    {
+      // Run the gain up to its maximum.
+      for (i = 0; i < 100; i++)
+      {
+        agc_acceptData(WEAK_MAGNITUDE);
+      } // for
+
+      magnitudes[0] = WEAK_MAGNITUDE;
+      magnitudes[1] = WEAK_MAGNITUDE;
+      break;
+    } // case
+
+    case STATE_ADJUSTING:
+    {
+      magnitudes[0] = FULL_SCALE_MAGNITUDE;
+      magnitudes[1] = WEAK_MAGNITUDE;
+      break;
+    } // case
+  } // switch
+
+  return;
+
+} // prepareAgc
+
+/**************************************************************************
+
+  Name: countStateEvents
+
+  Purpose: The purpose of this function is to retrieve the counter that
+  tells how many invocations were in a given state.
+
+  Calling Sequence: count = countStateEvents(state)
+
+  Inputs:
+
+    state - The state of interest.
+
+  Outputs:
+
+    count - The value of the counter.
+
+**************************************************************************/
+static uint64_t countStateEvents(enum agcState state)
+{
+  uint64_t count;
+  struct agcStats stats;
+
+  agc_getStats(&stats);
+
+  count = 0;
+
+  switch (state)
+  {
+    case STATE_BLANKED:
+    {
+      count = stats.blankedCount;
+      break;
+    } // case
+
+    case STATE_DEADBAND:
+    {
+      count = stats.deadbandSuppressionCount;
+      break;
+    } // case
+
+    case STATE_CLAMPED:
+    {
+      count = stats.maxGainClampCount;
+      break;
+    } // case
+
+    case STATE_ADJUSTING:
+    {
+      count = stats.gainWriteCount;
+      break;
+    } // case
+  } // switch
+
+  return (count);
+
+} // countStateEvents
+
+/**************************************************************************
+
+  Name: benchmarkAcceptData
+
+  Purpose: The purpose of this function is to measure the cost of
+  agc_acceptData() in a given state.
+
+  Calling Sequence: benchmarkAcceptData(namePtr,state,callCount)
+
+  Inputs:
+
+    namePtr - The name of the benchmark.
+
+    state - The state of interest.
+
+    callCount - The number of calls in a run.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void benchmarkAcceptData(const char *namePtr,
+    enum agcState state,
+    uint32_t callCount)
+{
+  int repetition;
+  uint32_t i;
+  uint32_t magnitudes[2];
+  uint64_t eventCount;
+  double stateFraction;
+  struct timespec startTime;
+  struct runResult run;
+  struct runResult best;
+
+  stateFraction = 1;
+
+  for (repetition = 0; repetition < REPETITIONS; repetition++)
+  {
+    prepareAgc(state,magnitudes);
+
+    eventCount = countStateEvents(state);
+
+    startRun(&startTime);
+
+    for (i = 0; i < callCount; i++)
+    {
+      agc_acceptData(magnitudes[i & 1]);
+    } // for
+
+    stopRun(&startTime,&run);
+
+    eventCount = countStateEvents(state) - eventCount;
+
+    // Report the worst run, so that a broken setup is not hidden.
+    if (((double)eventCount / callCount) < stateFraction)
+    {
+      stateFraction = (double)eventCount / callCount;
+    } // if
+
+    keepFastest(&run,&best,repetition == 0);
+  } // for
+
+  reportResult(namePtr,callCount,&best,stateFraction);
+
+  return;
+
+} // benchmarkAcceptData
+
+/**************************************************************************
+
+  Name: prepareTemplateAgc
+
+  Purpose: The purpose of this function is to configure a template AGC
+  and to drive it into a steady state, as prepareAgc() does for the C
+  AGC.  The blanked state is not supported, since the template only
+  blanks for a number of invocations.
+
+  Calling Sequence: prepareTemplateAgc(agc,state,magnitudes)
+
+  Inputs:
+
+    agc - The AGC.
+
+    state - The state of interest.
+
+    magnitudes - Storage for the two magnitudes that the benchmark
+    alternates between.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+template <typename AgcT>
+static void prepareTemplateAgc(AgcT &agc,
+    enum agcState state,
+    uint32_t magnitudes[2])
+{
+  int i;
+
+  agc.setAgcFilterCoefficient(0.7);
+  agc.setDeadband(0);
+  agc.setBlankingLimit(0);
+  agc.enable();
+
+  magnitudes[0] = FULL_SCALE_MAGNITUDE;
+  magnitudes[1] = WEAK_MAGNITUDE;
+
+  if (state == STATE_DEADBAND)
+  {
+    agc.setDeadband(2);
+
+    magnitudes[0] = NEAR_OPERATING_POINT_MAGNITUDE;
+    magnitudes[1] = NEAR_OPERATING_POINT_MAGNITUDE;
+  } // if
+  else
+  {
+    if (state == STATE_CLAMPED)
+    {
+      // Run the gain up to its maximum.
+      for (i = 0; i < 100; i++)
+      {
+        agc.acceptData(WEAK_MAGNITUDE);
+      } // for
+
+      magnitudes[0] = WEAK_MAGNITUDE;
+    } // if
+  } // else
+
+  return;
+
+} // prepareTemplateAgc
+
+/**************************************************************************
+
+  Name: countTemplateEvents
+
+  Purpose: The purpose of this function is to retrieve the counter of a
+  template AGC that tells how many invocations were in a given state.
+
+  Calling Sequence: count = countTemplateEvents(agc,state)
+
+  Inputs:
+
+    agc - The AGC.
+
+    state - The state of interest.
+
+  Outputs:
+
+    count - The value of the counter.
+
+**************************************************************************/
+template <typename AgcT>
+static uint64_t countTemplateEvents(const AgcT &agc,enum agcState state)
+{
+  uint64_t count;
+
+  count = agc.getCounters().gainWriteCount;
+
+  if (state == STATE_DEADBAND)
+  {
+    count = agc.getCounters().deadbandSuppressionCount;
+  } // if
+  else
+  {
+    if (state == STATE_CLAMPED)
+    {
+      count = agc.getCounters().maxGainClampCount;
+    } // if
+  } // else
+
+  return (count);
+
+} // countTemplateEvents
+
+/**************************************************************************
+
+  Name: benchmarkTemplate
+
+  Purpose: The purpose of this function is to measure the cost of
+  Agc::acceptData() in a given state.  The AGC uses the pass through
+  detector and the floating point control law, as the C AGC does by
+  default, and its actuator is a lambda that the compiler can inline.
+
+  Calling Sequence: benchmarkTemplate(namePtr,state,callCount)
+
+  Inputs:
+
+    namePtr - The name of the benchmark.
+
+    state - The state of interest.
+
+    callCount - The number of calls in a run.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void benchmarkTemplate(const char *namePtr,
+    enum agcState state,
+    uint32_t callCount)
+{
+  int repetition;
+  uint32_t i;
+  uint32_t magnitudes[2];
+  uint64_t eventCount;
+  double stateFraction;
+  struct timespec startTime;
+  struct runResult run;
+  struct runResult best;
+
+  stateFraction = 1;
+
+  for (repetition = 0; repetition < REPETITIONS; repetition++)
+  {
+    hardwareGainInDb = 24;
+
+    auto agc = makeAgc<AgcPassThroughDetector,AgcFloatControlLaw,int16_t>(
+        OPERATING_POINT_IN_DBFS,
+        MAX_AMPLIFIER_GAIN_IN_DB,
+        WORD_LENGTH_IN_BITS,
+        [](uint32_t gainInDb) { hardwareGainInDb = gainInDb; });
+
+    prepareTemplateAgc(agc,state,magnitudes);
+
+    eventCount = countTemplateEvents(agc,state);
+
+    startRun(&startTime);
+
+    for (i = 0; i < callCount; i++)
+    {
+      agc.acceptData(magnitudes[i & 1]);
+    } // for
+
+    stopRun(&startTime,&run);
+
+    eventCount = countTemplateEvents(agc,state) - eventCount;
+
+    // Report the worst run, so that a broken setup is not hidden.
+    if (((double)eventCount / callCount) < stateFraction)
+    {
+      stateFraction = (double)eventCount / callCount;
+    } // if
+
+    keepFastest(&run,&best,repetition == 0);
+  } // for
+
+  reportResult(namePtr,callCount,&best,stateFraction);
+
+  return;
+
+} // benchmarkTemplate
+
+/**************************************************************************
+
+  Name: benchmarkDbfs
+
+  Purpose: The purpose of this function is to measure the cost of
+  dbfs_convertMagnitudeToDbFs() for a given word length.  The
+  magnitudes are spread over the whole range of the word length.
+
+  Calling Sequence: benchmarkDbfs(wordLengthInBits,callCount)
+
+  Inputs:
+
+    wordLengthInBits - The word length of interest.
+
+    callCount - The number of calls in a run.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void benchmarkDbfs(uint32_t wordLengthInBits,uint32_t callCount)
+{
+  int repetition;
+  uint32_t i;
+  uint32_t seed;
+  uint32_t mask;
+  int32_t sum;
+  char name[64];
+  struct timespec startTime;
+  struct runResult run;
+  struct runResult best;
+  static uint32_t magnitudes[MAGNITUDE_TABLE_SIZE];
+
+  dbfs_init(wordLengthInBits);
+
+  mask = (uint32_t)((1ULL << wordLengthInBits) - 1);
+
+  // Spread the magnitudes over all of the bit positions.
+  seed = 1;
+
+  for (i = 0; i < MAGNITUDE_TABLE_SIZE; i++)
+  {
+    seed = (seed * 1664525) + 1013904223;
+    magnitudes[i] = (seed & mask) >> (i % wordLengthInBits);
+  } // for
+
+  for (repetition = 0; repetition < REPETITIONS; repetition++)
+  {
+    sum = 0;
+
+    startRun(&startTime);
+
+    for (i = 0; i < callCount; i++)
+    {
+      sum += dbfs_convertMagnitudeToDbFs(
+        magnitudes[i & (MAGNITUDE_TABLE_SIZE - 1)]);
+    } // for
+
+    stopRun(&startTime,&run);
+
+    sink = sum;
+
+    keepFastest(&run,&best,repetition == 0);
+  } // for
+
+  snprintf(name,sizeof(name),"dbfsConvert/%ubit",wordLengthInBits);
+
+  reportResult(name,callCount,&best,-1);
+
+  return;
+
+} // benchmarkDbfs
+
+//************************************************************
+// Mainline code.
+//************************************************************
+int main(int argc,char **argv)
+{
+  uint32_t i;
+  uint32_t callCount;
+  static const uint32_t wordLengths[] = {7,12,15,24,31};
+
+  callCount = DEFAULT_CALL_COUNT;
+
+  if (argc > 1)
+  {
+    callCount = (uint32_t)strtoul(argv[1],NULL,0);
+
+    if (callCount == 0)
+    {
+      fprintf(stderr,"Usage: %s [callCount]\n",argv[0]);
+      return (1);
+    } // if
+  } // if
+
+  openCounters(&counters);
+
+  benchmarkAcceptData("acceptData/blanked",STATE_BLANKED,callCount);
+  benchmarkAcceptData("acceptData/deadband",STATE_DEADBAND,callCount);
+  benchmarkAcceptData("acceptData/clamped",STATE_CLAMPED,callCount);
+  benchmarkAcceptData("acceptData/adjusting",STATE_ADJUSTING,callCount);
+
+  benchmarkTemplate("template/deadband",STATE_DEADBAND,callCount);
+  benchmarkTemplate("template/clamped",STATE_CLAMPED,callCount);
+  benchmarkTemplate("template/adjusting",STATE_ADJUSTING,callCount);
+
+  for (i = 0; i < (sizeof(wordLengths) / sizeof(wordLengths[0])); i++)
+  {
+    benchmarkDbfs(wordLengths[i],callCount);
+  } // for
+
+  return (0);
+
+} // main
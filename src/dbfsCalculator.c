@@ -5,43 +5,140 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
-#include <math.h>
 
 #include "dbfsCalculator.h"
 
 // Allow a maximum of 31 bit wordlength.
 #define MAX_WORD_LENGTH (31)
 
-// This is the size of the magnitude to decibel lookup.
-#define MAX_LOOKUP_INDEX (256)
-
-// All private stuff is bundled in one structure.
-static struct privateData
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// Magnitudes are normalized so that at most the 9 most significant
+// bits are used as a table index.  The index is therefore in the range
+// of [0,511], and the truncation of the discarded bits costs at most
+// 20log10(257/256) = 0.034dB.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+#define MANTISSA_BITS (9)
+#define MAX_LOOKUP_INDEX ((1 << MANTISSA_BITS) - 1)
+
+// 20log10(2) in Q16 format.  This is added for each discarded bit.
+#define SIX_DB_Q16 (394566)
+
+// Returned when a calculator has not been initialized.
+#define OUT_OF_RANGE_DB (-9999)
+#define OUT_OF_RANGE_DB_Q8 (OUT_OF_RANGE_DB * (1 << DBFS_FRACTIONAL_BITS))
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// The normalized table does not depend upon the word length, so one
+// table is shared by every calculator in the process.  Entry i is
+// lrint(20log10(i) * 256), the Q8 decibel value of i, and entry 0 is
+// that of 1 to avoid minus infinity.  The table is constant, so it
+// lives in read-only data, and initializing a calculator needs neither
+// the math library nor any time to build the table.  The extra entry
+// at the end lets the vectorized code load each 16-bit entry as a
+// 32-bit quantity.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+static const int16_t dbTable[MAX_LOOKUP_INDEX + 2]
+  __attribute__((aligned(64))) =
+{
+     0,    0, 1541, 2443, 3083, 3579, 3984, 4327, 4624, 4886,
+  5120, 5332, 5525, 5703, 5868, 6022, 6165, 6300, 6427, 6547,
+  6661, 6770, 6873, 6972, 7067, 7157, 7245, 7329, 7409, 7487,
+  7563, 7636, 7706, 7775, 7841, 7906, 7968, 8029, 8088, 8146,
+  8203, 8257, 8311, 8363, 8414, 8464, 8513, 8561, 8608, 8654,
+  8699, 8743, 8786, 8828, 8870, 8911, 8951, 8990, 9029, 9067,
+  9104, 9141, 9177, 9213, 9248, 9282, 9316, 9350, 9382, 9415,
+  9447, 9478, 9510, 9540, 9570, 9600, 9630, 9659, 9688, 9716,
+  9744, 9771, 9799, 9826, 9852, 9879, 9905, 9930, 9956, 9981,
+ 10006,10030,10055,10079,10102,10126,10149,10172,10195,10218,
+ 10240,10262,10284,10306,10327,10348,10370,10390,10411,10432,
+ 10452,10472,10492,10512,10531,10551,10570,10589,10608,10627,
+ 10645,10664,10682,10700,10718,10736,10754,10771,10789,10806,
+ 10823,10840,10857,10874,10891,10907,10924,10940,10956,10972,
+ 10988,11004,11020,11035,11051,11066,11081,11097,11112,11127,
+ 11142,11156,11171,11186,11200,11214,11229,11243,11257,11271,
+ 11285,11299,11313,11326,11340,11354,11367,11380,11394,11407,
+ 11420,11433,11446,11459,11472,11484,11497,11510,11522,11535,
+ 11547,11559,11572,11584,11596,11608,11620,11632,11644,11655,
+ 11667,11679,11691,11702,11714,11725,11736,11748,11759,11770,
+ 11781,11792,11803,11814,11825,11836,11847,11858,11868,11879,
+ 11890,11900,11911,11921,11932,11942,11952,11963,11973,11983,
+ 11993,12003,12013,12023,12033,12043,12053,12063,12073,12082,
+ 12092,12102,12111,12121,12130,12140,12149,12159,12168,12177,
+ 12187,12196,12205,12214,12223,12233,12242,12251,12260,12269,
+ 12277,12286,12295,12304,12313,12321,12330,12339,12347,12356,
+ 12365,12373,12382,12390,12399,12407,12415,12424,12432,12440,
+ 12449,12457,12465,12473,12481,12489,12497,12505,12514,12521,
+ 12529,12537,12545,12553,12561,12569,12577,12584,12592,12600,
+ 12607,12615,12623,12630,12638,12645,12653,12661,12668,12675,
+ 12683,12690,12698,12705,12712,12720,12727,12734,12741,12749,
+ 12756,12763,12770,12777,12784,12791,12798,12805,12812,12819,
+ 12826,12833,12840,12847,12854,12861,12868,12874,12881,12888,
+ 12895,12902,12908,12915,12922,12928,12935,12941,12948,12955,
+ 12961,12968,12974,12981,12987,12994,13000,13006,13013,13019,
+ 13026,13032,13038,13045,13051,13057,13063,13070,13076,13082,
+ 13088,13094,13101,13107,13113,13119,13125,13131,13137,13143,
+ 13149,13155,13161,13167,13173,13179,13185,13191,13197,13203,
+ 13208,13214,13220,13226,13232,13238,13243,13249,13255,13261,
+ 13266,13272,13278,13283,13289,13295,13300,13306,13311,13317,
+ 13323,13328,13334,13339,13345,13350,13356,13361,13367,13372,
+ 13377,13383,13388,13394,13399,13404,13410,13415,13420,13426,
+ 13431,13436,13442,13447,13452,13457,13463,13468,13473,13478,
+ 13483,13489,13494,13499,13504,13509,13514,13519,13524,13529,
+ 13534,13540,13545,13550,13555,13560,13565,13570,13575,13580,
+ 13584,13589,13594,13599,13604,13609,13614,13619,13624,13628,
+ 13633,13638,13643,13648,13653,13657,13662,13667,13672,13676,
+ 13681,13686,13691,13695,13700,13705,13709,13714,13719,13723,
+ 13728,13733,13737,13742,13746,13751,13756,13760,13765,13769,
+ 13774,13778,13783,13787,13792,13796,13801,13805,13810,13814,
+ 13819,13823,13828,13832,13836,13841,13845,13850,13854,13858,
+ 13863,13867,    0
+};
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// The full scale value of each word length in Q8 decibels, that is,
+// lrint(20log10(2^n - 1) * 256) for a word length of n bits.  A word
+// length of 0 is treated as 1.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+static const int32_t fullScaleInDbQ8[MAX_WORD_LENGTH + 1] =
 {
-  // Don't run unless the system has been initialized.
-  int initialized;
+       0,      0,   2443,   4327,   6022,   7636,   9213,  10771,
+   12321,  13867,  15411,  16953,  18495,  20036,  21578,  23119,
+   24660,  26202,  27743,  29284,  30825,  32367,  33908,  35449,
+   36991,  38532,  40073,  41614,  43156,  44697,  46238,  47779
+};
 
-  // The full scale value is 2^(number of bits).
-  uint32_t fullScaleValue;
+// This calculator is used by the dbfs_xxx() functions.
+static struct dbfsCalculator defaultCalculator;
 
-  // This is used for dBFs computations.
-  uint32_t fullScaleValueInDb;
+static void convertBlockScalar(const struct dbfsCalculator *calculatorPtr,
+    const uint32_t *signalMagnitudePtr,
+    int32_t *dbFsQ8Ptr,
+    uint32_t count);
 
-  // This table is used to compute decibels for values [0,255].
-  int32_t dbTable[257];
-} me;
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+
+static void convertBlockAvx2(const struct dbfsCalculator *calculatorPtr,
+    const uint32_t *signalMagnitudePtr,
+    int32_t *dbFsQ8Ptr,
+    uint32_t count);
+#endif
 
 /*****************************************************************************
 
-  Name: dbfs_init()
+  Name: dbfsCalculator_init
 
   Purpose: The purpose of this function is to serve as the contructor for
-  an instance of a DbfsCalculator.
+  an instance of a DbfsCalculator.  Calculators with different word
+  lengths can coexist in one process.
 
-  Calling Sequence: initialized = dbfs_init(wordLengthInBits)
+  Calling Sequence: initialized = dbfsCalculator_init(calculatorPtr,
+                                                      wordLengthInBits)
 
   Inputs:
 
+    calculatorPtr - A pointer to the calculator.
+
     wordLengthInBits - The number of bits in the full scale value.
 
  Outputs:
@@ -50,13 +147,9 @@ static struct privateData
     initialized, and a value of zero indicates that was not initialized..
 
 *****************************************************************************/
-int dbfs_init(uint32_t wordLengthInBits)
+int dbfsCalculator_init(struct dbfsCalculator *calculatorPtr,
+    uint32_t wordLengthInBits)
 {
-  uint32_t i;
-  float dbLevel;
-
-  // Make sure this indicates we're not initialized.
-  me.initialized = 0;
 
   if (wordLengthInBits > MAX_WORD_LENGTH)
   {
@@ -64,95 +157,447 @@ int dbfs_init(uint32_t wordLengthInBits)
     wordLengthInBits = MAX_WORD_LENGTH;
   } // if
 
+  if (wordLengthInBits == 0)
+  {
+    // Avoid a full scale value of zero.
+    wordLengthInBits = 1;
+  } // if
+
   // Save for later use.
-  me.fullScaleValue = (1 << wordLengthInBits) - 1;
+  calculatorPtr->fullScaleValue = (1U << wordLengthInBits) - 1;
 
   // Note that 2's complement demands (full scale) / 2.
-  me.fullScaleValueInDb = (uint32_t)(20 * log10((double)me.fullScaleValue));
-  
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-  // Construct the decibel table. The table can allow a
-  // lookup that maps magnitudes from zero to 256 into
-  // decibels.
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
-  for (i = 1; i <= MAX_LOOKUP_INDEX; i++)
+  calculatorPtr->fullScaleValueInDbQ8 = fullScaleInDbQ8[wordLengthInBits];
+
+  // Reference the shared table.
+  calculatorPtr->dbTablePtr = dbTable;
+
+  return (1);
+
+} // dbfsCalculator_init
+
+/**************************************************************************
+
+  Name: dbfsCalculator_convertMagnitudeToDbFsQ8
+
+  Purpose: The purpose of this function is to convert a signal magnitude
+  to decibels referred to the full scale value with a resolution of
+  1/256 dB.  The magnitude is normalized with a count-leading-zeros
+  operation, so the conversion takes the same time for any magnitude.
+
+  Calling Sequence: dbFsValue =
+                      dbfsCalculator_convertMagnitudeToDbFsQ8(calculatorPtr,
+                                                              signalMagnitude)
+
+  Inputs:
+
+    calculatorPtr - A pointer to the calculator.
+
+    signalMagnitude - The magnitude of the signal.
+
+  Outputs:
+
+    dbFsValue - The signal level in Q8 decibels referenced to full scale.
+
+**************************************************************************/
+int32_t dbfsCalculator_convertMagnitudeToDbFsQ8(
+    const struct dbfsCalculator *calculatorPtr,
+    uint32_t signalMagnitude)
+{
+  int32_t shift;
+  int32_t dbFsValue;
+
+  if (calculatorPtr->dbTablePtr != NULL)
   {
-    dbLevel = 20 * log10((float)i);
-    me.dbTable[i] = (int32_t)dbLevel;
-  } // for 
+    // Clip it.
+    signalMagnitude = (signalMagnitude > calculatorPtr->fullScaleValue) ?
+      calculatorPtr->fullScaleValue : signalMagnitude;
 
-  // Avoid minus infinity.
-  me.dbTable[0] = me.dbTable[1]; 
-  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+    // Discard all but the 9 most significant bits.  Zero maps to one.
+    shift = (31 - __builtin_clz(signalMagnitude | 1)) - (MANTISSA_BITS - 1);
+    shift &= ~(shift >> 31);
 
-  // This is the top level qualifier for the system to run.
-  me.initialized = 1;
+    // Map to decibels, and add 6dB for each bit that was discarded.
+    dbFsValue = calculatorPtr->dbTablePtr[signalMagnitude >> shift];
+    dbFsValue += (shift * SIX_DB_Q16) >> 8;
 
-  return (me.initialized);
+    // Compute to decibels below the full scale value.
+    dbFsValue -= calculatorPtr->fullScaleValueInDbQ8;
+  } // if
+  else
+  {
+    // Return something out of range
+    dbFsValue = OUT_OF_RANGE_DB_Q8;
+  } // else
 
-} // dbfs_init
+  return (dbFsValue);
+
+} // dbfsCalculator_convertMagnitudeToDbFsQ8
 
 /**************************************************************************
 
-  Name: dbfs_convertMagnitudeToDbFs
+  Name: dbfsCalculator_convertMagnitudeToDbFs
 
   Purpose: The purpose of this function is to convert a signal magnitude
-  to decibels referred to the full scale value.
+  to decibels referred to the full scale value.  The result is rounded
+  to the nearest decibel.
 
-  Calling Sequence: dbFsValue = dbfs_convertMagnitudeToDbFs(signalMagnitude)
+  Calling Sequence: dbFsValue =
+                      dbfsCalculator_convertMagnitudeToDbFs(calculatorPtr,
+                                                            signalMagnitude)
 
   Inputs:
 
+    calculatorPtr - A pointer to the calculator.
+
     signalMagnitude - The magnitude of the signal.
 
   Outputs:
 
-    None.
+    dbFsValue - The signal level in decibels referenced to full scale.
 
 **************************************************************************/
-int32_t dbfs_convertMagnitudeToDbFs(
+int32_t dbfsCalculator_convertMagnitudeToDbFs(
+    const struct dbfsCalculator *calculatorPtr,
     uint32_t signalMagnitude)
 {
-  int32_t decibels;
   int32_t dbFsValue;
 
-  // Initial value of no overhead.
-  decibels = 0;
+  dbFsValue = dbfsCalculator_convertMagnitudeToDbFsQ8(calculatorPtr,
+                                                      signalMagnitude);
+
+  // Round to the nearest decibel.
+  dbFsValue = (dbFsValue + (1 << (DBFS_FRACTIONAL_BITS - 1))) >>
+    DBFS_FRACTIONAL_BITS;
+
+  return (dbFsValue);
+
+} // dbfsCalculator_convertMagnitudeToDbFs
 
-  if (me.initialized)
+/**************************************************************************
+
+  Name: dbfsCalculator_convertBlock
+
+  Purpose: The purpose of this function is to convert an array of signal
+  magnitudes to Q8 decibels referred to the full scale value.  The
+  results are identical to those of
+  dbfsCalculator_convertMagnitudeToDbFsQ8(), and an AVX2 implementation
+  is used when the processor supports it.
+
+  Calling Sequence: dbfsCalculator_convertBlock(calculatorPtr,
+                                                signalMagnitudePtr,
+                                                dbFsQ8Ptr,
+                                                count)
+
+  Inputs:
+
+    calculatorPtr - A pointer to the calculator.
+
+    signalMagnitudePtr - A pointer to the signal magnitudes.
+
+    dbFsQ8Ptr - A pointer to storage for the results.
+
+    count - The number of magnitudes to convert.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void dbfsCalculator_convertBlock(
+    const struct dbfsCalculator *calculatorPtr,
+    const uint32_t *signalMagnitudePtr,
+    int32_t *dbFsQ8Ptr,
+    uint32_t count)
+{
+  uint32_t i;
+
+  if (calculatorPtr->dbTablePtr == NULL)
   {
+    for (i = 0; i < count; i++)
+    {
+      // Return something out of range
+      dbFsQ8Ptr[i] = OUT_OF_RANGE_DB_Q8;
+    } // for
 
-  if (signalMagnitude > me.fullScaleValue)
+    return;
+  } // if
+
+#if defined(__x86_64__) || defined(__i386__)
+  if (__builtin_cpu_supports("avx2"))
   {
-    // Clip it.
-    signalMagnitude = me.fullScaleValue;
+    convertBlockAvx2(calculatorPtr,signalMagnitudePtr,dbFsQ8Ptr,count);
+    return;
   } // if
+#endif
+
+  convertBlockScalar(calculatorPtr,signalMagnitudePtr,dbFsQ8Ptr,count);
+
+  return;
+
+} // dbfsCalculator_convertBlock
+
+/*****************************************************************************
+
+  Name: dbfs_init()
+
+  Purpose: The purpose of this function is to initialize the default
+  calculator.
+
+  Calling Sequence: initialized = dbfs_init(wordLengthInBits)
+
+  Inputs:
+
+    wordLengthInBits - The number of bits in the full scale value.
+
+ Outputs:
+
+    initialized - A flag that indicate whether the system was properly
+    initialized, and a value of zero indicates that was not initialized..
+
+*****************************************************************************/
+int dbfs_init(uint32_t wordLengthInBits)
+{
+
+  return (dbfsCalculator_init(&defaultCalculator,wordLengthInBits));
+
+} // dbfs_init
+
+/**************************************************************************
+
+  Name: dbfs_convertMagnitudeToDbFs
+
+  Purpose: The purpose of this function is to convert a signal magnitude
+  to decibels referred to the full scale value using the default
+  calculator.
 
-  // Scale the signal magnitude so that it can be used as an index.
-  while (signalMagnitude > MAX_LOOKUP_INDEX)
+  Calling Sequence: dbFsValue = dbfs_convertMagnitudeToDbFs(signalMagnitude)
+
+  Inputs:
+
+    signalMagnitude - The magnitude of the signal.
+
+  Outputs:
+
+    dbFsValue - The signal level in decibels referenced to full scale.
+
+**************************************************************************/
+int32_t dbfs_convertMagnitudeToDbFs(
+    uint32_t signalMagnitude)
+{
+
+  return (dbfsCalculator_convertMagnitudeToDbFs(&defaultCalculator,
+                                                signalMagnitude));
+
+} // dbfs_convertMagnitudeToDbFs
+
+/**************************************************************************
+
+  Name: dbfs_convertMagnitudeToDbFsQ8
+
+  Purpose: The purpose of this function is to convert a signal magnitude
+  to Q8 decibels referred to the full scale value using the default
+  calculator.
+
+  Calling Sequence: dbFsValue = dbfs_convertMagnitudeToDbFsQ8(signalMagnitude)
+
+  Inputs:
+
+    signalMagnitude - The magnitude of the signal.
+
+  Outputs:
+
+    dbFsValue - The signal level in Q8 decibels referenced to full scale.
+
+**************************************************************************/
+int32_t dbfs_convertMagnitudeToDbFsQ8(
+    uint32_t signalMagnitude)
+{
+
+  return (dbfsCalculator_convertMagnitudeToDbFsQ8(&defaultCalculator,
+                                                  signalMagnitude));
+
+} // dbfs_convertMagnitudeToDbFsQ8
+
+/**************************************************************************
+
+  Name: dbfs_convertBlock
+
+  Purpose: The purpose of this function is to convert an array of signal
+  magnitudes to Q8 decibels referred to the full scale value using the
+  default calculator.
+
+  Calling Sequence: dbfs_convertBlock(signalMagnitudePtr,dbFsQ8Ptr,count)
+
+  Inputs:
+
+    signalMagnitudePtr - A pointer to the signal magnitudes.
+
+    dbFsQ8Ptr - A pointer to storage for the results.
+
+    count - The number of magnitudes to convert.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void dbfs_convertBlock(const uint32_t *signalMagnitudePtr,
+    int32_t *dbFsQ8Ptr,
+    uint32_t count)
+{
+
+  dbfsCalculator_convertBlock(&defaultCalculator,
+                              signalMagnitudePtr,
+                              dbFsQ8Ptr,
+                              count);
+
+  return;
+
+} // dbfs_convertBlock
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// Static functions.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+/**************************************************************************
+
+  Name: convertBlockScalar
+
+  Purpose: The purpose of this function is to convert an array of signal
+  magnitudes to Q8 decibels one at a time.
+
+  Calling Sequence: convertBlockScalar(calculatorPtr,
+                                       signalMagnitudePtr,
+                                       dbFsQ8Ptr,
+                                       count)
+
+  Inputs:
+
+    calculatorPtr - A pointer to an initialized calculator.
+
+    signalMagnitudePtr - A pointer to the signal magnitudes.
+
+    dbFsQ8Ptr - A pointer to storage for the results.
+
+    count - The number of magnitudes to convert.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void convertBlockScalar(const struct dbfsCalculator *calculatorPtr,
+    const uint32_t *signalMagnitudePtr,
+    int32_t *dbFsQ8Ptr,
+    uint32_t count)
+{
+  uint32_t i;
+
+  for (i = 0; i < count; i++)
   {
-    // Scale it..
-    signalMagnitude /= 2;
+    dbFsQ8Ptr[i] =
+      dbfsCalculator_convertMagnitudeToDbFsQ8(calculatorPtr,
+                                              signalMagnitudePtr[i]);
+  } // for
 
-    // Add 6dB to account for the divide by 2.
-    decibels += 6;
-  } // while
+  return;
 
-  // Map to decibels. 
-  dbFsValue = me.dbTable[signalMagnitude];
+} // convertBlockScalar
 
-  // Add in the compensation for any scaling.
-  dbFsValue += decibels;
+#if defined(__x86_64__) || defined(__i386__)
+/**************************************************************************
 
-  // Compute to decibels below the full scale value.
-  dbFsValue -= me.fullScaleValueInDb;
-  } // if
-  else
+  Name: convertBlockAvx2
+
+  Purpose: The purpose of this function is to convert an array of signal
+  magnitudes to Q8 decibels eight at a time.  AVX2 has no count leading
+  zeros instruction, so the position of the most significant bit is
+  taken from the exponent of the magnitude converted to floating point.
+  The 8 least significant bits are cleared before the conversion so that
+  the conversion is exact, and so that magnitudes that need no
+  normalization produce a shift of zero.
+
+  Calling Sequence: convertBlockAvx2(calculatorPtr,
+                                     signalMagnitudePtr,
+                                     dbFsQ8Ptr,
+                                     count)
+
+  Inputs:
+
+    calculatorPtr - A pointer to an initialized calculator.
+
+    signalMagnitudePtr - A pointer to the signal magnitudes.
+
+    dbFsQ8Ptr - A pointer to storage for the results.
+
+    count - The number of magnitudes to convert.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+__attribute__((target("avx2")))
+static void convertBlockAvx2(const struct dbfsCalculator *calculatorPtr,
+    const uint32_t *signalMagnitudePtr,
+    int32_t *dbFsQ8Ptr,
+    uint32_t count)
+{
+  uint32_t i;
+  __m256i magnitude;
+  __m256i shift;
+  __m256i decibels;
+  const __m256i fullScaleValue =
+    _mm256_set1_epi32((int32_t)calculatorPtr->fullScaleValue);
+  const __m256i fullScaleValueInDbQ8 =
+    _mm256_set1_epi32(calculatorPtr->fullScaleValueInDbQ8);
+  const __m256i lowBitMask = _mm256_set1_epi32(~0xff);
+  const __m256i exponentBias = _mm256_set1_epi32(127 + MANTISSA_BITS - 1);
+  const __m256i sixDb = _mm256_set1_epi32(SIX_DB_Q16);
+  const __m256i entryMask = _mm256_set1_epi32(0xffff);
+
+  for (i = 0; (i + 8) <= count; i += 8)
   {
-    // Return something out of range
-    dbFsValue =  -9999;
-  } // else
+    magnitude =
+      _mm256_loadu_si256((const __m256i *)&signalMagnitudePtr[i]);
 
-  return (dbFsValue);
+    // Clip it.  The full scale value is less than 2^31.
+    magnitude = _mm256_min_epu32(magnitude,fullScaleValue);
 
-} // dbfs_convertMagnitudeToDbFs
+    // Extract the position of the most significant bit.
+    shift = _mm256_castps_si256(_mm256_cvtepi32_ps(
+      _mm256_and_si256(magnitude,lowBitMask)));
+    shift = _mm256_sub_epi32(_mm256_srli_epi32(shift,23),exponentBias);
+    shift = _mm256_max_epi32(shift,_mm256_setzero_si256());
+
+    // Map to decibels.
+    decibels = _mm256_i32gather_epi32((const int *)calculatorPtr->dbTablePtr,
+                                      _mm256_srlv_epi32(magnitude,shift),
+                                      2);
+    decibels = _mm256_and_si256(decibels,entryMask);
+
+    // Add 6dB for each bit that was discarded.
+    decibels = _mm256_add_epi32(decibels,
+      _mm256_srai_epi32(_mm256_mullo_epi32(shift,sixDb),8));
+
+    // Compute to decibels below the full scale value.
+    decibels = _mm256_sub_epi32(decibels,fullScaleValueInDbQ8);
+
+    _mm256_storeu_si256((__m256i *)&dbFsQ8Ptr[i],decibels);
+  } // for
+
+  // Take care of the leftovers.
+  convertBlockScalar(calculatorPtr,
+                     &signalMagnitudePtr[i],
+                     &dbFsQ8Ptr[i],
+                     count - i);
+
+  return;
+
+} // convertBlockAvx2
+#endif
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// End of static functions
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
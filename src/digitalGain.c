@@ -0,0 +1,906 @@
+//**************************************************************************
+// file name: digitalGain.c
+//**************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "digitalGain.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define X86_KERNELS
+#include <immintrin.h>
+#endif
+
+// The kernels round with vcvtnq_s32_f32(), which only AArch64 has.
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#define NEON_KERNELS
+#include <arm_neon.h>
+#endif
+
+// Sample formats.
+#define FORMAT_S8 (0)
+#define FORMAT_S16 (1)
+#define FORMAT_F32 (2)
+
+static void applyGain(void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    float startGain,
+    float endGain);
+
+static int32_t saturate(int32_t value,int32_t limit);
+
+static void applyGainScalar(void *iqPtr,
+    uint32_t firstSample,
+    uint32_t sampleCount,
+    int format,
+    float startGain,
+    float gainStep);
+
+#ifdef X86_KERNELS
+static void applyGainAvx2(void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    float startGain,
+    float gainStep,
+    uint32_t *processedCountPtr);
+
+static void applyGainSse2(void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    float startGain,
+    float gainStep,
+    uint32_t *processedCountPtr);
+#endif
+
+#ifdef NEON_KERNELS
+static void applyGainNeon(void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    float startGain,
+    float gainStep,
+    uint32_t *processedCountPtr);
+#endif
+
+/**************************************************************************
+
+  Name: digitalGain_applyS8
+
+  Purpose: The purpose of this function is to apply a gain ramp to a
+  block of interleaved IQ samples that are stored as signed bytes, as
+  produced by the HackRF.
+
+  Calling Sequence: digitalGain_applyS8(iqPtr,
+                                        sampleCount,
+                                        startGain,
+                                        endGain)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    startGain - The linear gain before the block.
+
+    endGain - The linear gain of the last sample of the block.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void digitalGain_applyS8(int8_t *iqPtr,
+    uint32_t sampleCount,
+    float startGain,
+    float endGain)
+{
+
+  applyGain(iqPtr,sampleCount,FORMAT_S8,startGain,endGain);
+
+  return;
+
+} // digitalGain_applyS8
+
+/**************************************************************************
+
+  Name: digitalGain_applyS16
+
+  Purpose: The purpose of this function is to apply a gain ramp to a
+  block of interleaved IQ samples that are stored as signed 16-bit
+  quantities.
+
+  Calling Sequence: digitalGain_applyS16(iqPtr,
+                                         sampleCount,
+                                         startGain,
+                                         endGain)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    startGain - The linear gain before the block.
+
+    endGain - The linear gain of the last sample of the block.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void digitalGain_applyS16(int16_t *iqPtr,
+    uint32_t sampleCount,
+    float startGain,
+    float endGain)
+{
+
+  applyGain(iqPtr,sampleCount,FORMAT_S16,startGain,endGain);
+
+  return;
+
+} // digitalGain_applyS16
+
+/**************************************************************************
+
+  Name: digitalGain_applyF32
+
+  Purpose: The purpose of this function is to apply a gain ramp to a
+  block of interleaved IQ samples that are stored as floats.
+
+  Calling Sequence: digitalGain_applyF32(iqPtr,
+                                         sampleCount,
+                                         startGain,
+                                         endGain)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    startGain - The linear gain before the block.
+
+    endGain - The linear gain of the last sample of the block.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void digitalGain_applyF32(float *iqPtr,
+    uint32_t sampleCount,
+    float startGain,
+    float endGain)
+{
+
+  applyGain(iqPtr,sampleCount,FORMAT_F32,startGain,endGain);
+
+  return;
+
+} // digitalGain_applyF32
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// Static functions.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+/**************************************************************************
+
+  Name: applyGain
+
+  Purpose: The purpose of this function is to apply a gain ramp to a
+  block of samples.  Sample i (counting from 0) gets the gain
+  startGain + (i + 1) * gainStep, where gainStep is the change of the
+  gain per sample.  The best vector kernel that the processor supports
+  processes the bulk of the block, and the scalar kernel processes
+  whatever is left over.  Every kernel computes the gains the same way,
+  so the result does not depend upon the kernel.
+
+  Calling Sequence: applyGain(iqPtr,sampleCount,format,startGain,endGain)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    format - The sample format.
+
+    startGain - The linear gain before the block.
+
+    endGain - The linear gain of the last sample of the block.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void applyGain(void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    float startGain,
+    float endGain)
+{
+  uint32_t processedCount;
+  float gainStep;
+
+  // Nothing has been processed by a vector kernel yet.
+  processedCount = 0;
+
+  if (sampleCount != 0)
+  {
+    gainStep = (endGain - startGain) / (float)sampleCount;
+
+#ifdef X86_KERNELS
+    if (__builtin_cpu_supports("avx2"))
+    {
+      applyGainAvx2(iqPtr,
+                    sampleCount,
+                    format,
+                    startGain,
+                    gainStep,
+                    &processedCount);
+    } // if
+    else
+    {
+      if (__builtin_cpu_supports("sse2"))
+      {
+        applyGainSse2(iqPtr,
+                      sampleCount,
+                      format,
+                      startGain,
+                      gainStep,
+                      &processedCount);
+      } // if
+    } // else
+#endif
+
+#ifdef NEON_KERNELS
+    applyGainNeon(iqPtr,
+                  sampleCount,
+                  format,
+                  startGain,
+                  gainStep,
+                  &processedCount);
+#endif
+
+    // Take care of the leftovers.
+    applyGainScalar(iqPtr,
+                    processedCount,
+                    sampleCount - processedCount,
+                    format,
+                    startGain,
+                    gainStep);
+  } // if
+
+  return;
+
+} // applyGain
+
+/**************************************************************************
+
+  Name: saturate
+
+  Purpose: The purpose of this function is to limit a value to the
+  range of a signed integer.
+
+  Calling Sequence: result = saturate(value,limit)
+
+  Inputs:
+
+    value - The value to limit.
+
+    limit - The largest value of the integer.  The smallest value is
+    -limit - 1.
+
+  Outputs:
+
+    result - The limited value.
+
+**************************************************************************/
+static int32_t saturate(int32_t value,int32_t limit)
+{
+  int32_t result;
+
+  result = value;
+
+  if (value > limit)
+  {
+    result = limit;
+  } // if
+  else
+  {
+    if (value < (-limit - 1))
+    {
+      result = -limit - 1;
+    } // if
+  } // else
+
+  return (result);
+
+} // saturate
+
+/**************************************************************************
+
+  Name: applyGainScalar
+
+  Purpose: The purpose of this function is to apply a gain ramp to a
+  range of samples.  Products are rounded to the nearest integer, with
+  ties to even, as the vector kernels do.
+
+  Calling Sequence: applyGainScalar(iqPtr,
+                                    firstSample,
+                                    sampleCount,
+                                    format,
+                                    startGain,
+                                    gainStep)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    firstSample - The index of the first complex sample to process.
+
+    sampleCount - The number of complex samples to process.
+
+    format - The sample format.
+
+    startGain - The linear gain before the block.
+
+    gainStep - The change of the gain per sample.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void applyGainScalar(void *iqPtr,
+    uint32_t firstSample,
+    uint32_t sampleCount,
+    int format,
+    float startGain,
+    float gainStep)
+{
+  uint32_t i;
+  uint32_t j;
+  float gain;
+  int8_t *s8Ptr;
+  int16_t *s16Ptr;
+  float *f32Ptr;
+
+  s8Ptr = (int8_t *)iqPtr;
+  s16Ptr = (int16_t *)iqPtr;
+  f32Ptr = (float *)iqPtr;
+
+  for (i = firstSample; i < (firstSample + sampleCount); i++)
+  {
+    gain = startGain + (gainStep * (float)(i + 1));
+
+    // Both components of the sample get the same gain.
+    for (j = 2 * i; j < ((2 * i) + 2); j++)
+    {
+      switch (format)
+      {
+        case FORMAT_S8:
+        {
+          s8Ptr[j] = (int8_t)saturate((int32_t)lrintf(s8Ptr[j] * gain),127);
+          break;
+        } // case
+
+        case FORMAT_S16:
+        {
+          s16Ptr[j] =
+            (int16_t)saturate((int32_t)lrintf(s16Ptr[j] * gain),32767);
+          break;
+        } // case
+
+        default:
+        {
+          f32Ptr[j] *= gain;
+          break;
+        } // case
+      } // switch
+    } // for
+  } // for
+
+  return;
+
+} // applyGainScalar
+
+#ifdef X86_KERNELS
+/**************************************************************************
+
+  Name: scaleAvx2
+
+  Purpose: The purpose of this function is to multiply 8 complex
+  samples, held in 16 signed 16-bit lanes, by their gains.
+
+  Calling Sequence: iq = scaleAvx2(iq,lowGains,highGains)
+
+  Inputs:
+
+    iq - The samples, with I in the even lanes and Q in the odd lanes.
+
+    lowGains - The gains of the components of samples 0 through 3.
+
+    highGains - The gains of the components of samples 4 through 7.
+
+  Outputs:
+
+    iq - The rounded and saturated products.
+
+**************************************************************************/
+__attribute__((target("avx2")))
+static inline __m256i scaleAvx2(__m256i iq,__m256 lowGains,__m256 highGains)
+{
+  __m256i low;
+  __m256i high;
+
+  low = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(iq));
+  high = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(iq,1));
+
+  low = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(low),lowGains));
+  high =
+    _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(high),highGains));
+
+  // The pack works within 128-bit lanes, so put the halves back.
+  iq = _mm256_permute4x64_epi64(_mm256_packs_epi32(low,high),0xd8);
+
+  return (iq);
+
+} // scaleAvx2
+
+/**************************************************************************
+
+  Name: applyGainAvx2
+
+  Purpose: The purpose of this function is to apply a gain ramp to a
+  block, 8 samples at a time.  The sample numbers of the components are
+  kept in integer lanes, and the gain of each component is computed from
+  its sample number as it is by the scalar kernel.
+
+  Calling Sequence: applyGainAvx2(iqPtr,
+                                  sampleCount,
+                                  format,
+                                  startGain,
+                                  gainStep,
+                                  &processedCount)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    format - The sample format.
+
+    startGain - The linear gain before the block.
+
+    gainStep - The change of the gain per sample.
+
+    processedCountPtr - A pointer to storage for the number of samples
+    that were processed.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+__attribute__((target("avx2")))
+static void applyGainAvx2(void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    float startGain,
+    float gainStep,
+    uint32_t *processedCountPtr)
+{
+  uint32_t i;
+  uint32_t iterationCount;
+  int8_t *s8Ptr;
+  int16_t *s16Ptr;
+  float *f32Ptr;
+  __m128i bytes;
+  __m256i iq;
+  __m256i lowIndices;
+  __m256i highIndices;
+  __m256 lowGains;
+  __m256 highGains;
+  const __m256i indexStep = _mm256_set1_epi32(8);
+  const __m256 start = _mm256_set1_ps(startGain);
+  const __m256 step = _mm256_set1_ps(gainStep);
+
+  s8Ptr = (int8_t *)iqPtr;
+  s16Ptr = (int16_t *)iqPtr;
+  f32Ptr = (float *)iqPtr;
+
+  // Sample i gets the gain of sample number i + 1.
+  lowIndices = _mm256_setr_epi32(1,1,2,2,3,3,4,4);
+  highIndices = _mm256_setr_epi32(5,5,6,6,7,7,8,8);
+
+  iterationCount = sampleCount / 8;
+
+  for (i = 0; i < iterationCount; i++)
+  {
+    lowGains = _mm256_add_ps(start,
+      _mm256_mul_ps(step,_mm256_cvtepi32_ps(lowIndices)));
+    highGains = _mm256_add_ps(start,
+      _mm256_mul_ps(step,_mm256_cvtepi32_ps(highIndices)));
+
+    lowIndices = _mm256_add_epi32(lowIndices,indexStep);
+    highIndices = _mm256_add_epi32(highIndices,indexStep);
+
+    switch (format)
+    {
+      case FORMAT_S8:
+      {
+        bytes = _mm_loadu_si128((const __m128i *)(s8Ptr + (16 * i)));
+
+        iq = scaleAvx2(_mm256_cvtepi8_epi16(bytes),lowGains,highGains);
+
+        bytes = _mm_packs_epi16(_mm256_castsi256_si128(iq),
+                                _mm256_extracti128_si256(iq,1));
+
+        _mm_storeu_si128((__m128i *)(s8Ptr + (16 * i)),bytes);
+        break;
+      } // case
+
+      case FORMAT_S16:
+      {
+        iq = _mm256_loadu_si256((const __m256i *)(s16Ptr + (16 * i)));
+
+        iq = scaleAvx2(iq,lowGains,highGains);
+
+        _mm256_storeu_si256((__m256i *)(s16Ptr + (16 * i)),iq);
+        break;
+      } // case
+
+      default:
+      {
+        _mm256_storeu_ps(f32Ptr + (16 * i),
+          _mm256_mul_ps(_mm256_loadu_ps(f32Ptr + (16 * i)),lowGains));
+        _mm256_storeu_ps(f32Ptr + (16 * i) + 8,
+          _mm256_mul_ps(_mm256_loadu_ps(f32Ptr + (16 * i) + 8),highGains));
+        break;
+      } // case
+    } // switch
+  } // for
+
+  *processedCountPtr = iterationCount * 8;
+
+  return;
+
+} // applyGainAvx2
+
+/**************************************************************************
+
+  Name: scaleSse2
+
+  Purpose: The purpose of this function is to multiply 4 complex
+  samples, held in 8 signed 16-bit lanes, by their gains.
+
+  Calling Sequence: iq = scaleSse2(iq,lowGains,highGains)
+
+  Inputs:
+
+    iq - The samples, with I in the even lanes and Q in the odd lanes.
+
+    lowGains - The gains of the components of samples 0 and 1.
+
+    highGains - The gains of the components of samples 2 and 3.
+
+  Outputs:
+
+    iq - The rounded and saturated products.
+
+**************************************************************************/
+__attribute__((target("sse2")))
+static inline __m128i scaleSse2(__m128i iq,__m128 lowGains,__m128 highGains)
+{
+  __m128i low;
+  __m128i high;
+
+  // Sign extend to 32 bits.
+  low = _mm_srai_epi32(_mm_unpacklo_epi16(iq,iq),16);
+  high = _mm_srai_epi32(_mm_unpackhi_epi16(iq,iq),16);
+
+  low = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(low),lowGains));
+  high = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(high),highGains));
+
+  return (_mm_packs_epi32(low,high));
+
+} // scaleSse2
+
+/**************************************************************************
+
+  Name: applyGainSse2
+
+  Purpose: The purpose of this function is to apply a gain ramp to a
+  block, 4 samples at a time.  This is the SSE2 version of
+  applyGainAvx2().
+
+  Calling Sequence: applyGainSse2(iqPtr,
+                                  sampleCount,
+                                  format,
+                                  startGain,
+                                  gainStep,
+                                  &processedCount)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    format - The sample format.
+
+    startGain - The linear gain before the block.
+
+    gainStep - The change of the gain per sample.
+
+    processedCountPtr - A pointer to storage for the number of samples
+    that were processed.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+__attribute__((target("sse2")))
+static void applyGainSse2(void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    float startGain,
+    float gainStep,
+    uint32_t *processedCountPtr)
+{
+  uint32_t i;
+  uint32_t iterationCount;
+  int8_t *s8Ptr;
+  int16_t *s16Ptr;
+  float *f32Ptr;
+  __m128i iq;
+  __m128i lowIndices;
+  __m128i highIndices;
+  __m128 lowGains;
+  __m128 highGains;
+  const __m128i indexStep = _mm_set1_epi32(4);
+  const __m128 start = _mm_set1_ps(startGain);
+  const __m128 step = _mm_set1_ps(gainStep);
+
+  s8Ptr = (int8_t *)iqPtr;
+  s16Ptr = (int16_t *)iqPtr;
+  f32Ptr = (float *)iqPtr;
+
+  // Sample i gets the gain of sample number i + 1.
+  lowIndices = _mm_setr_epi32(1,1,2,2);
+  highIndices = _mm_setr_epi32(3,3,4,4);
+
+  iterationCount = sampleCount / 4;
+
+  for (i = 0; i < iterationCount; i++)
+  {
+    lowGains = _mm_add_ps(start,_mm_mul_ps(step,_mm_cvtepi32_ps(lowIndices)));
+    highGains =
+      _mm_add_ps(start,_mm_mul_ps(step,_mm_cvtepi32_ps(highIndices)));
+
+    lowIndices = _mm_add_epi32(lowIndices,indexStep);
+    highIndices = _mm_add_epi32(highIndices,indexStep);
+
+    switch (format)
+    {
+      case FORMAT_S8:
+      {
+        iq = _mm_loadl_epi64((const __m128i *)(s8Ptr + (8 * i)));
+
+        // Sign extend the bytes to 16 bits.
+        iq = _mm_srai_epi16(_mm_unpacklo_epi8(iq,iq),8);
+
+        iq = scaleSse2(iq,lowGains,highGains);
+
+        _mm_storel_epi64((__m128i *)(s8Ptr + (8 * i)),_mm_packs_epi16(iq,iq));
+        break;
+      } // case
+
+      case FORMAT_S16:
+      {
+        iq = _mm_loadu_si128((const __m128i *)(s16Ptr + (8 * i)));
+
+        iq = scaleSse2(iq,lowGains,highGains);
+
+        _mm_storeu_si128((__m128i *)(s16Ptr + (8 * i)),iq);
+        break;
+      } // case
+
+      default:
+      {
+        _mm_storeu_ps(f32Ptr + (8 * i),
+          _mm_mul_ps(_mm_loadu_ps(f32Ptr + (8 * i)),lowGains));
+        _mm_storeu_ps(f32Ptr + (8 * i) + 4,
+          _mm_mul_ps(_mm_loadu_ps(f32Ptr + (8 * i) + 4),highGains));
+        break;
+      } // case
+    } // switch
+  } // for
+
+  *processedCountPtr = iterationCount * 4;
+
+  return;
+
+} // applyGainSse2
+#endif // X86_KERNELS
+
+#ifdef NEON_KERNELS
+/**************************************************************************
+
+  Name: scaleNeon
+
+  Purpose: The purpose of this function is to multiply 8 components,
+  held in signed 16-bit lanes, by their gains.
+
+  Calling Sequence: values = scaleNeon(values,lowGains,highGains)
+
+  Inputs:
+
+    values - The components of samples 0 through 7.
+
+    lowGains - The gains of samples 0 through 3.
+
+    highGains - The gains of samples 4 through 7.
+
+  Outputs:
+
+    values - The rounded and saturated products.
+
+**************************************************************************/
+static inline int16x8_t scaleNeon(int16x8_t values,
+    float32x4_t lowGains,
+    float32x4_t highGains)
+{
+  float32x4_t low;
+  float32x4_t high;
+
+  low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(values)));
+  high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(values)));
+
+  low = vmulq_f32(low,lowGains);
+  high = vmulq_f32(high,highGains);
+
+  return (vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(low)),
+                       vqmovn_s32(vcvtnq_s32_f32(high))));
+
+} // scaleNeon
+
+/**************************************************************************
+
+  Name: applyGainNeon
+
+  Purpose: The purpose of this function is to apply a gain ramp to a
+  block, 8 samples at a time.  The samples are deinterleaved as they
+  are loaded, so the I and Q vectors share their gains.
+
+  Calling Sequence: applyGainNeon(iqPtr,
+                                  sampleCount,
+                                  format,
+                                  startGain,
+                                  gainStep,
+                                  &processedCount)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    format - The sample format.
+
+    startGain - The linear gain before the block.
+
+    gainStep - The change of the gain per sample.
+
+    processedCountPtr - A pointer to storage for the number of samples
+    that were processed.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void applyGainNeon(void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    float startGain,
+    float gainStep,
+    uint32_t *processedCountPtr)
+{
+  uint32_t i;
+  uint32_t iterationCount;
+  int8_t *s8Ptr;
+  int16_t *s16Ptr;
+  float *f32Ptr;
+  int8x8x2_t bytes;
+  int16x8x2_t iq;
+  float32x4x2_t floats;
+  int32x4_t lowIndices;
+  int32x4_t highIndices;
+  float32x4_t lowGains;
+  float32x4_t highGains;
+  const int32x4_t indexStep = vdupq_n_s32(8);
+  const float32x4_t start = vdupq_n_f32(startGain);
+  const float32x4_t step = vdupq_n_f32(gainStep);
+  static const int32_t firstIndices[8] = {1,2,3,4,5,6,7,8};
+
+  s8Ptr = (int8_t *)iqPtr;
+  s16Ptr = (int16_t *)iqPtr;
+  f32Ptr = (float *)iqPtr;
+
+  // Sample i gets the gain of sample number i + 1.
+  lowIndices = vld1q_s32(&firstIndices[0]);
+  highIndices = vld1q_s32(&firstIndices[4]);
+
+  iterationCount = sampleCount / 8;
+
+  for (i = 0; i < iterationCount; i++)
+  {
+    lowGains = vaddq_f32(start,vmulq_f32(step,vcvtq_f32_s32(lowIndices)));
+    highGains = vaddq_f32(start,vmulq_f32(step,vcvtq_f32_s32(highIndices)));
+
+    lowIndices = vaddq_s32(lowIndices,indexStep);
+    highIndices = vaddq_s32(highIndices,indexStep);
+
+    switch (format)
+    {
+      case FORMAT_S8:
+      {
+        bytes = vld2_s8(s8Ptr + (16 * i));
+
+        iq.val[0] = scaleNeon(vmovl_s8(bytes.val[0]),lowGains,highGains);
+        iq.val[1] = scaleNeon(vmovl_s8(bytes.val[1]),lowGains,highGains);
+
+        bytes.val[0] = vqmovn_s16(iq.val[0]);
+        bytes.val[1] = vqmovn_s16(iq.val[1]);
+
+        vst2_s8(s8Ptr + (16 * i),bytes);
+        break;
+      } // case
+
+      case FORMAT_S16:
+      {
+        iq = vld2q_s16(s16Ptr + (16 * i));
+
+        iq.val[0] = scaleNeon(iq.val[0],lowGains,highGains);
+        iq.val[1] = scaleNeon(iq.val[1],lowGains,highGains);
+
+        vst2q_s16(s16Ptr + (16 * i),iq);
+        break;
+      } // case
+
+      default:
+      {
+        floats = vld2q_f32(f32Ptr + (16 * i));
+        floats.val[0] = vmulq_f32(floats.val[0],lowGains);
+        floats.val[1] = vmulq_f32(floats.val[1],lowGains);
+        vst2q_f32(f32Ptr + (16 * i),floats);
+
+        floats = vld2q_f32(f32Ptr + (16 * i) + 8);
+        floats.val[0] = vmulq_f32(floats.val[0],highGains);
+        floats.val[1] = vmulq_f32(floats.val[1],highGains);
+        vst2q_f32(f32Ptr + (16 * i) + 8,floats);
+        break;
+      } // case
+    } // switch
+  } // for
+
+  *processedCountPtr = iterationCount * 8;
+
+  return;
+
+} // applyGainNeon
+#endif // NEON_KERNELS
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// End of static functions
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
@@ -0,0 +1,1701 @@
+//**************************************************************************
+// file name: magnitudeEstimator.c
+//**************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "magnitudeEstimator.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define X86_KERNELS
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON)
+#define NEON_KERNELS
+#include <arm_neon.h>
+#endif
+
+// Sample formats.
+#define FORMAT_U8 (0)
+#define FORMAT_S8 (1)
+#define FORMAT_S16 (2)
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// The alpha max plus beta min estimate is
+// (15/16)max(|I|,|Q|) + (15/32)min(|I|,|Q|), and its peak error is about
+// 6 percent.  The terms are accumulated as 30max + 15min, and the
+// division by 32 is performed once per block.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+#define ALPHA_NUMERATOR (30)
+#define BETA_NUMERATOR (15)
+#define ESTIMATE_SHIFT (5)
+
+// Component magnitudes are limited so that they fit in a signed 16 bits.
+#define MAX_COMPONENT_MAGNITUDE (32767)
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// The vector kernels accumulate in narrow lanes, and the lanes are
+// added to wide accumulators after this many iterations so that they
+// can't overflow or lose precision.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+#define FLUSH_INTERVAL (1024)
+
+static uint32_t averageMagnitude(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    int method);
+
+static uint32_t countClipped(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t clipLevel);
+
+static int32_t loadComponent(const void *iqPtr,uint32_t index,int format);
+
+static uint64_t sumAlphaMaxBetaMinScalar(const void *iqPtr,
+    uint32_t firstSample,
+    uint32_t sampleCount,
+    int format);
+
+static double sumExactScalar(const void *iqPtr,
+    uint32_t firstSample,
+    uint32_t sampleCount,
+    int format);
+
+static uint32_t countClippedScalar(const void *iqPtr,
+    uint32_t firstSample,
+    uint32_t sampleCount,
+    int format,
+    uint32_t clipLevel);
+
+#ifdef X86_KERNELS
+static uint64_t sumAlphaMaxBetaMinAvx2(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t *processedCountPtr);
+
+static double sumExactAvx2(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t *processedCountPtr);
+
+static uint32_t countClippedAvx2(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t clipLevel,
+    uint32_t *processedCountPtr);
+
+static uint64_t sumAlphaMaxBetaMinSse2(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t *processedCountPtr);
+
+static double sumExactSse2(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t *processedCountPtr);
+
+static uint32_t countClippedSse2(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t clipLevel,
+    uint32_t *processedCountPtr);
+#endif
+
+#ifdef NEON_KERNELS
+static uint64_t sumAlphaMaxBetaMinNeon(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t *processedCountPtr);
+
+static uint32_t countClippedNeon(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t clipLevel,
+    uint32_t *processedCountPtr);
+
+#ifdef __aarch64__
+static double sumExactNeon(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t *processedCountPtr);
+#endif
+#endif
+
+/**************************************************************************
+
+  Name: magnitude_averageU8
+
+  Purpose: The purpose of this function is to compute the average
+  magnitude of a block of interleaved IQ samples that are stored as
+  unsigned offset binary bytes, as produced by the rtl-sdr.  A value of
+  128 represents zero.
+
+  Calling Sequence: magnitude = magnitude_averageU8(iqPtr,
+                                                    sampleCount,
+                                                    method)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    method - The magnitude estimation method.  Valid values are
+    MAGNITUDE_ALPHA_MAX_BETA_MIN and MAGNITUDE_EXACT.
+
+  Outputs:
+
+    magnitude - The average magnitude of the block.
+
+**************************************************************************/
+uint32_t magnitude_averageU8(const uint8_t *iqPtr,
+    uint32_t sampleCount,
+    int method)
+{
+
+  return (averageMagnitude(iqPtr,sampleCount,FORMAT_U8,method));
+
+} // magnitude_averageU8
+
+/**************************************************************************
+
+  Name: magnitude_averageS8
+
+  Purpose: The purpose of this function is to compute the average
+  magnitude of a block of interleaved IQ samples that are stored as
+  signed bytes, as produced by the HackRF.
+
+  Calling Sequence: magnitude = magnitude_averageS8(iqPtr,
+                                                    sampleCount,
+                                                    method)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    method - The magnitude estimation method.  Valid values are
+    MAGNITUDE_ALPHA_MAX_BETA_MIN and MAGNITUDE_EXACT.
+
+  Outputs:
+
+    magnitude - The average magnitude of the block.
+
+**************************************************************************/
+uint32_t magnitude_averageS8(const int8_t *iqPtr,
+    uint32_t sampleCount,
+    int method)
+{
+
+  return (averageMagnitude(iqPtr,sampleCount,FORMAT_S8,method));
+
+} // magnitude_averageS8
+
+/**************************************************************************
+
+  Name: magnitude_averageS16
+
+  Purpose: The purpose of this function is to compute the average
+  magnitude of a block of interleaved IQ samples that are stored as
+  signed 16-bit quantities.
+
+  Calling Sequence: magnitude = magnitude_averageS16(iqPtr,
+                                                     sampleCount,
+                                                     method)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    method - The magnitude estimation method.  Valid values are
+    MAGNITUDE_ALPHA_MAX_BETA_MIN and MAGNITUDE_EXACT.
+
+  Outputs:
+
+    magnitude - The average magnitude of the block.
+
+**************************************************************************/
+uint32_t magnitude_averageS16(const int16_t *iqPtr,
+    uint32_t sampleCount,
+    int method)
+{
+
+  return (averageMagnitude(iqPtr,sampleCount,FORMAT_S16,method));
+
+} // magnitude_averageS16
+
+/**************************************************************************
+
+  Name: magnitude_countClippedU8
+
+  Purpose: The purpose of this function is to count the clipped samples
+  of a block of interleaved IQ samples that are stored as unsigned
+  offset binary bytes, as produced by the rtl-sdr.  A sample is clipped
+  when the magnitude of its I or Q component is at least the clip
+  level.
+
+  Calling Sequence: clippedCount = magnitude_countClippedU8(iqPtr,
+                                                            sampleCount,
+                                                            clipLevel)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    clipLevel - The component magnitude at which the ADC clips.
+
+  Outputs:
+
+    clippedCount - The number of clipped samples.
+
+**************************************************************************/
+uint32_t magnitude_countClippedU8(const uint8_t *iqPtr,
+    uint32_t sampleCount,
+    uint32_t clipLevel)
+{
+
+  return (countClipped(iqPtr,sampleCount,FORMAT_U8,clipLevel));
+
+} // magnitude_countClippedU8
+
+/**************************************************************************
+
+  Name: magnitude_countClippedS8
+
+  Purpose: The purpose of this function is to count the clipped samples
+  of a block of interleaved IQ samples that are stored as signed bytes,
+  as produced by the HackRF.
+
+  Calling Sequence: clippedCount = magnitude_countClippedS8(iqPtr,
+                                                            sampleCount,
+                                                            clipLevel)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    clipLevel - The component magnitude at which the ADC clips.
+
+  Outputs:
+
+    clippedCount - The number of clipped samples.
+
+**************************************************************************/
+uint32_t magnitude_countClippedS8(const int8_t *iqPtr,
+    uint32_t sampleCount,
+    uint32_t clipLevel)
+{
+
+  return (countClipped(iqPtr,sampleCount,FORMAT_S8,clipLevel));
+
+} // magnitude_countClippedS8
+
+/**************************************************************************
+
+  Name: magnitude_countClippedS16
+
+  Purpose: The purpose of this function is to count the clipped samples
+  of a block of interleaved IQ samples that are stored as signed 16-bit
+  quantities.
+
+  Calling Sequence: clippedCount = magnitude_countClippedS16(iqPtr,
+                                                             sampleCount,
+                                                             clipLevel)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    clipLevel - The component magnitude at which the ADC clips.
+
+  Outputs:
+
+    clippedCount - The number of clipped samples.
+
+**************************************************************************/
+uint32_t magnitude_countClippedS16(const int16_t *iqPtr,
+    uint32_t sampleCount,
+    uint32_t clipLevel)
+{
+
+  return (countClipped(iqPtr,sampleCount,FORMAT_S16,clipLevel));
+
+} // magnitude_countClippedS16
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// Static functions.
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+/**************************************************************************
+
+  Name: averageMagnitude
+
+  Purpose: The purpose of this function is to compute the average
+  magnitude of a block of samples.  The best vector kernel that the
+  processor supports processes the bulk of the block, and the scalar
+  kernel processes whatever is left over.
+
+  Calling Sequence: magnitude = averageMagnitude(iqPtr,
+                                                 sampleCount,
+                                                 format,
+                                                 method)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    format - The sample format.
+
+    method - The magnitude estimation method.
+
+  Outputs:
+
+    magnitude - The average magnitude of the block.
+
+**************************************************************************/
+static uint32_t averageMagnitude(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    int method)
+{
+  uint32_t magnitude;
+  uint32_t processedCount;
+  uint64_t estimateSum;
+  double exactSum;
+
+  // Nothing has been processed by a vector kernel yet.
+  processedCount = 0;
+
+  if (sampleCount == 0)
+  {
+    // There is no signal to measure.
+    return (0);
+  } // if
+
+  if (method == MAGNITUDE_EXACT)
+  {
+    exactSum = 0;
+
+#ifdef X86_KERNELS
+    if (__builtin_cpu_supports("avx2"))
+    {
+      exactSum = sumExactAvx2(iqPtr,sampleCount,format,&processedCount);
+    } // if
+    else
+    {
+      if (__builtin_cpu_supports("sse2"))
+      {
+        exactSum = sumExactSse2(iqPtr,sampleCount,format,&processedCount);
+      } // if
+    } // else
+#endif
+
+#if defined(NEON_KERNELS) && defined(__aarch64__)
+    exactSum = sumExactNeon(iqPtr,sampleCount,format,&processedCount);
+#endif
+
+    // Take care of the leftovers.
+    exactSum += sumExactScalar(iqPtr,
+                               processedCount,
+                               sampleCount - processedCount,
+                               format);
+
+    magnitude = (uint32_t)((exactSum / sampleCount) + 0.5);
+  } // if
+  else
+  {
+    estimateSum = 0;
+
+#ifdef X86_KERNELS
+    if (__builtin_cpu_supports("avx2"))
+    {
+      estimateSum = sumAlphaMaxBetaMinAvx2(iqPtr,
+                                           sampleCount,
+                                           format,
+                                           &processedCount);
+    } // if
+    else
+    {
+      if (__builtin_cpu_supports("sse2"))
+      {
+        estimateSum = sumAlphaMaxBetaMinSse2(iqPtr,
+                                             sampleCount,
+                                             format,
+                                             &processedCount);
+      } // if
+    } // else
+#endif
+
+#ifdef NEON_KERNELS
+    estimateSum = sumAlphaMaxBetaMinNeon(iqPtr,
+                                         sampleCount,
+                                         format,
+                                         &processedCount);
+#endif
+
+    // Take care of the leftovers.
+    estimateSum += sumAlphaMaxBetaMinScalar(iqPtr,
+                                            processedCount,
+                                            sampleCount - processedCount,
+                                            format);
+
+    // Apply the scaling of the estimate, and round.
+    estimateSum += ((uint64_t)sampleCount << (ESTIMATE_SHIFT - 1));
+    magnitude =
+      (uint32_t)(estimateSum / ((uint64_t)sampleCount << ESTIMATE_SHIFT));
+  } // else
+
+  return (magnitude);
+
+} // averageMagnitude
+
+/**************************************************************************
+
+  Name: countClipped
+
+  Purpose: The purpose of this function is to count the clipped samples
+  of a block.  The best vector kernel that the processor supports
+  processes the bulk of the block, and the scalar kernel processes
+  whatever is left over.  Component magnitudes saturate at 32767, so
+  nothing clips at a higher clip level.
+
+  Calling Sequence: clippedCount = countClipped(iqPtr,
+                                                sampleCount,
+                                                format,
+                                                clipLevel)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    format - The sample format.
+
+    clipLevel - The component magnitude at which the ADC clips.
+
+  Outputs:
+
+    clippedCount - The number of clipped samples.
+
+**************************************************************************/
+static uint32_t countClipped(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t clipLevel)
+{
+  uint32_t clippedCount;
+  uint32_t processedCount;
+
+  clippedCount = 0;
+
+  // Nothing has been processed by a vector kernel yet.
+  processedCount = 0;
+
+  if (clipLevel <= MAX_COMPONENT_MAGNITUDE)
+  {
+#ifdef X86_KERNELS
+    if (__builtin_cpu_supports("avx2"))
+    {
+      clippedCount = countClippedAvx2(iqPtr,
+                                      sampleCount,
+                                      format,
+                                      clipLevel,
+                                      &processedCount);
+    } // if
+    else
+    {
+      if (__builtin_cpu_supports("sse2"))
+      {
+        clippedCount = countClippedSse2(iqPtr,
+                                        sampleCount,
+                                        format,
+                                        clipLevel,
+                                        &processedCount);
+      } // if
+    } // else
+#endif
+
+#ifdef NEON_KERNELS
+    clippedCount = countClippedNeon(iqPtr,
+                                    sampleCount,
+                                    format,
+                                    clipLevel,
+                                    &processedCount);
+#endif
+
+    // Take care of the leftovers.
+    clippedCount += countClippedScalar(iqPtr,
+                                       processedCount,
+                                       sampleCount - processedCount,
+                                       format,
+                                       clipLevel);
+  } // if
+
+  return (clippedCount);
+
+} // countClipped
+
+/**************************************************************************
+
+  Name: loadComponent
+
+  Purpose: The purpose of this function is to retrieve one component
+  (I or Q) of a sample as a signed quantity.
+
+  Calling Sequence: value = loadComponent(iqPtr,index,format)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    index - The index of the component.
+
+    format - The sample format.
+
+  Outputs:
+
+    value - The value of the component.
+
+**************************************************************************/
+static int32_t loadComponent(const void *iqPtr,uint32_t index,int format)
+{
+  int32_t value;
+
+  switch (format)
+  {
+    case FORMAT_U8:
+    {
+      value = (int32_t)((const uint8_t *)iqPtr)[index] - 128;
+      break;
+    } // case
+
+    case FORMAT_S8:
+    {
+      value = ((const int8_t *)iqPtr)[index];
+      break;
+    } // case
+
+    default:
+    {
+      value = ((const int16_t *)iqPtr)[index];
+      break;
+    } // case
+  } // switch
+
+  return (value);
+
+} // loadComponent
+
+/**************************************************************************
+
+  Name: sumAlphaMaxBetaMinScalar
+
+  Purpose: The purpose of this function is to accumulate the alpha max
+  plus beta min terms of a range of samples.
+
+  Calling Sequence: sum = sumAlphaMaxBetaMinScalar(iqPtr,
+                                                   firstSample,
+                                                   sampleCount,
+                                                   format)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    firstSample - The index of the first complex sample to process.
+
+    sampleCount - The number of complex samples to process.
+
+    format - The sample format.
+
+  Outputs:
+
+    sum - The sum of 30max + 15min over the samples.
+
+**************************************************************************/
+static uint64_t sumAlphaMaxBetaMinScalar(const void *iqPtr,
+    uint32_t firstSample,
+    uint32_t sampleCount,
+    int format)
+{
+  uint32_t i;
+  int32_t inPhase;
+  int32_t quadrature;
+  int32_t big;
+  int32_t small;
+  uint64_t sum;
+
+  sum = 0;
+
+  for (i = firstSample; i < (firstSample + sampleCount); i++)
+  {
+    inPhase = abs(loadComponent(iqPtr,2 * i,format));
+    quadrature = abs(loadComponent(iqPtr,(2 * i) + 1,format));
+
+    // Match the saturation of the vector kernels.
+    inPhase = (inPhase > MAX_COMPONENT_MAGNITUDE) ?
+      MAX_COMPONENT_MAGNITUDE : inPhase;
+    quadrature = (quadrature > MAX_COMPONENT_MAGNITUDE) ?
+      MAX_COMPONENT_MAGNITUDE : quadrature;
+
+    big = (inPhase > quadrature) ? inPhase : quadrature;
+    small = (inPhase > quadrature) ? quadrature : inPhase;
+
+    sum += (uint64_t)((ALPHA_NUMERATOR * big) + (BETA_NUMERATOR * small));
+  } // for
+
+  return (sum);
+
+} // sumAlphaMaxBetaMinScalar
+
+/**************************************************************************
+
+  Name: sumExactScalar
+
+  Purpose: The purpose of this function is to accumulate the exact
+  magnitudes of a range of samples.
+
+  Calling Sequence: sum = sumExactScalar(iqPtr,
+                                         firstSample,
+                                         sampleCount,
+                                         format)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    firstSample - The index of the first complex sample to process.
+
+    sampleCount - The number of complex samples to process.
+
+    format - The sample format.
+
+  Outputs:
+
+    sum - The sum of the magnitudes.
+
+**************************************************************************/
+static double sumExactScalar(const void *iqPtr,
+    uint32_t firstSample,
+    uint32_t sampleCount,
+    int format)
+{
+  uint32_t i;
+  float inPhase;
+  float quadrature;
+  double sum;
+
+  sum = 0;
+
+  for (i = firstSample; i < (firstSample + sampleCount); i++)
+  {
+    inPhase = (float)loadComponent(iqPtr,2 * i,format);
+    quadrature = (float)loadComponent(iqPtr,(2 * i) + 1,format);
+
+    sum += sqrtf((inPhase * inPhase) + (quadrature * quadrature));
+  } // for
+
+  return (sum);
+
+} // sumExactScalar
+
+/**************************************************************************
+
+  Name: countClippedScalar
+
+  Purpose: The purpose of this function is to count the clipped samples
+  of a range of samples.
+
+  Calling Sequence: clippedCount = countClippedScalar(iqPtr,
+                                                      firstSample,
+                                                      sampleCount,
+                                                      format,
+                                                      clipLevel)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    firstSample - The index of the first complex sample to process.
+
+    sampleCount - The number of complex samples to process.
+
+    format - The sample format.
+
+    clipLevel - The component magnitude at which the ADC clips.
+
+  Outputs:
+
+    clippedCount - The number of clipped samples.
+
+**************************************************************************/
+static uint32_t countClippedScalar(const void *iqPtr,
+    uint32_t firstSample,
+    uint32_t sampleCount,
+    int format,
+    uint32_t clipLevel)
+{
+  uint32_t i;
+  int32_t inPhase;
+  int32_t quadrature;
+  uint32_t clippedCount;
+
+  clippedCount = 0;
+
+  for (i = firstSample; i < (firstSample + sampleCount); i++)
+  {
+    inPhase = abs(loadComponent(iqPtr,2 * i,format));
+    quadrature = abs(loadComponent(iqPtr,(2 * i) + 1,format));
+
+    // Match the saturation of the vector kernels.
+    inPhase = (inPhase > MAX_COMPONENT_MAGNITUDE) ?
+      MAX_COMPONENT_MAGNITUDE : inPhase;
+    quadrature = (quadrature > MAX_COMPONENT_MAGNITUDE) ?
+      MAX_COMPONENT_MAGNITUDE : quadrature;
+
+    if (((uint32_t)inPhase >= clipLevel) ||
+        ((uint32_t)quadrature >= clipLevel))
+    {
+      clippedCount++;
+    } // if
+  } // for
+
+  return (clippedCount);
+
+} // countClippedScalar
+
+#ifdef X86_KERNELS
+/**************************************************************************
+
+  Name: loadIqAvx2
+
+  Purpose: The purpose of this function is to load 8 complex samples
+  into 16 signed 16-bit lanes, with I in the even lanes and Q in the
+  odd lanes.
+
+  Calling Sequence: iq = loadIqAvx2(iqPtr,firstSample,format)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    firstSample - The index of the first complex sample to load.
+
+    format - The sample format.
+
+  Outputs:
+
+    iq - The samples.
+
+**************************************************************************/
+__attribute__((target("avx2")))
+static inline __m256i loadIqAvx2(const void *iqPtr,
+    uint32_t firstSample,
+    int format)
+{
+  __m128i bytes;
+  __m256i iq;
+
+  if (format == FORMAT_S16)
+  {
+    iq = _mm256_loadu_si256(
+      (const __m256i *)((const int16_t *)iqPtr + (2 * firstSample)));
+  } // if
+  else
+  {
+    bytes = _mm_loadu_si128(
+      (const __m128i *)((const int8_t *)iqPtr + (2 * firstSample)));
+
+    if (format == FORMAT_U8)
+    {
+      // Offset binary to 2's complement.
+      bytes = _mm_xor_si128(bytes,_mm_set1_epi8((char)0x80));
+    } // if
+
+    iq = _mm256_cvtepi8_epi16(bytes);
+  } // else
+
+  return (iq);
+
+} // loadIqAvx2
+
+/**************************************************************************
+
+  Name: sumAlphaMaxBetaMinAvx2
+
+  Purpose: The purpose of this function is to accumulate the alpha max
+  plus beta min terms of a block, 8 samples at a time.  The magnitudes
+  of I and Q are swapped within each 32-bit lane so that the maximum
+  lands in the low half and the minimum in the high half, and one
+  multiply-add then produces 30max + 15min per sample.
+
+  Calling Sequence: sum = sumAlphaMaxBetaMinAvx2(iqPtr,
+                                                 sampleCount,
+                                                 format,
+                                                 &processedCount)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    format - The sample format.
+
+    processedCountPtr - A pointer to storage for the number of samples
+    that were processed.
+
+  Outputs:
+
+    sum - The sum of 30max + 15min over the processed samples.
+
+**************************************************************************/
+__attribute__((target("avx2")))
+static uint64_t sumAlphaMaxBetaMinAvx2(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t *processedCountPtr)
+{
+  uint32_t i;
+  uint32_t iterationCount;
+  uint64_t lanes[4];
+  __m256i magnitudes;
+  __m256i swapped;
+  __m256i terms;
+  __m256i narrowSum;
+  __m256i wideSum;
+  const __m256i limit = _mm256_set1_epi16(MAX_COMPONENT_MAGNITUDE);
+  const __m256i coefficients =
+    _mm256_set1_epi32((BETA_NUMERATOR << 16) | ALPHA_NUMERATOR);
+
+  narrowSum = _mm256_setzero_si256();
+  wideSum = _mm256_setzero_si256();
+
+  iterationCount = sampleCount / 8;
+
+  for (i = 0; i < iterationCount; i++)
+  {
+    magnitudes = _mm256_abs_epi16(loadIqAvx2(iqPtr,8 * i,format));
+    magnitudes = _mm256_min_epu16(magnitudes,limit);
+
+    swapped = _mm256_shufflehi_epi16(
+      _mm256_shufflelo_epi16(magnitudes,0xb1),0xb1);
+
+    // Maximum in the low half, minimum in the high half.
+    terms = _mm256_blend_epi16(_mm256_max_epi16(magnitudes,swapped),
+                               _mm256_min_epi16(magnitudes,swapped),
+                               0xaa);
+
+    narrowSum = _mm256_add_epi32(narrowSum,
+                                 _mm256_madd_epi16(terms,coefficients));
+
+    if ((i % FLUSH_INTERVAL) == (FLUSH_INTERVAL - 1))
+    {
+      wideSum = _mm256_add_epi64(wideSum,
+        _mm256_cvtepu32_epi64(_mm256_castsi256_si128(narrowSum)));
+      wideSum = _mm256_add_epi64(wideSum,
+        _mm256_cvtepu32_epi64(_mm256_extracti128_si256(narrowSum,1)));
+      narrowSum = _mm256_setzero_si256();
+    } // if
+  } // for
+
+  wideSum = _mm256_add_epi64(wideSum,
+    _mm256_cvtepu32_epi64(_mm256_castsi256_si128(narrowSum)));
+  wideSum = _mm256_add_epi64(wideSum,
+    _mm256_cvtepu32_epi64(_mm256_extracti128_si256(narrowSum,1)));
+
+  _mm256_storeu_si256((__m256i *)lanes,wideSum);
+
+  *processedCountPtr = iterationCount * 8;
+
+  return (lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+
+} // sumAlphaMaxBetaMinAvx2
+
+/**************************************************************************
+
+  Name: sumExactAvx2
+
+  Purpose: The purpose of this function is to accumulate the exact
+  magnitudes of a block, 8 samples at a time.  I^2 + Q^2 is formed in
+  both lanes of each pair, so each magnitude is accumulated twice, and
+  the sum is halved at the end.
+
+  Calling Sequence: sum = sumExactAvx2(iqPtr,
+                                       sampleCount,
+                                       format,
+                                       &processedCount)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    format - The sample format.
+
+    processedCountPtr - A pointer to storage for the number of samples
+    that were processed.
+
+  Outputs:
+
+    sum - The sum of the magnitudes of the processed samples.
+
+**************************************************************************/
+__attribute__((target("avx2")))
+static double sumExactAvx2(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t *processedCountPtr)
+{
+  uint32_t i;
+  uint32_t iterationCount;
+  double lanes[4];
+  __m256i iq;
+  __m256 low;
+  __m256 high;
+  __m256 narrowSum;
+  __m256d wideSum;
+
+  narrowSum = _mm256_setzero_ps();
+  wideSum = _mm256_setzero_pd();
+
+  iterationCount = sampleCount / 8;
+
+  for (i = 0; i < iterationCount; i++)
+  {
+    iq = loadIqAvx2(iqPtr,8 * i,format);
+
+    low = _mm256_cvtepi32_ps(
+      _mm256_cvtepi16_epi32(_mm256_castsi256_si128(iq)));
+    high = _mm256_cvtepi32_ps(
+      _mm256_cvtepi16_epi32(_mm256_extracti128_si256(iq,1)));
+
+    low = _mm256_mul_ps(low,low);
+    high = _mm256_mul_ps(high,high);
+
+    // I^2 + Q^2 in both lanes of a pair.
+    low = _mm256_add_ps(low,_mm256_permute_ps(low,0xb1));
+    high = _mm256_add_ps(high,_mm256_permute_ps(high,0xb1));
+
+    narrowSum = _mm256_add_ps(narrowSum,_mm256_sqrt_ps(low));
+    narrowSum = _mm256_add_ps(narrowSum,_mm256_sqrt_ps(high));
+
+    if ((i % FLUSH_INTERVAL) == (FLUSH_INTERVAL - 1))
+    {
+      wideSum = _mm256_add_pd(wideSum,
+        _mm256_cvtps_pd(_mm256_castps256_ps128(narrowSum)));
+      wideSum = _mm256_add_pd(wideSum,
+        _mm256_cvtps_pd(_mm256_extractf128_ps(narrowSum,1)));
+      narrowSum = _mm256_setzero_ps();
+    } // if
+  } // for
+
+  wideSum = _mm256_add_pd(wideSum,
+    _mm256_cvtps_pd(_mm256_castps256_ps128(narrowSum)));
+  wideSum = _mm256_add_pd(wideSum,
+    _mm256_cvtps_pd(_mm256_extractf128_ps(narrowSum,1)));
+
+  _mm256_storeu_pd(lanes,wideSum);
+
+  *processedCountPtr = iterationCount * 8;
+
+  return ((lanes[0] + lanes[1] + lanes[2] + lanes[3]) / 2);
+
+} // sumExactAvx2
+
+/**************************************************************************
+
+  Name: countClippedAvx2
+
+  Purpose: The purpose of this function is to count the clipped samples
+  of a block, 8 samples at a time.  Each component is compared with the
+  clip level, and the result is ORed with that of the other component
+  of its sample, so that a clipped sample sets the 4 bytes of its pair
+  of lanes.  The bytes are counted with the byte mask of the compare.
+
+  Calling Sequence: clippedCount = countClippedAvx2(iqPtr,
+                                                    sampleCount,
+                                                    format,
+                                                    clipLevel,
+                                                    &processedCount)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    format - The sample format.
+
+    clipLevel - The component magnitude at which the ADC clips.  It
+    must not exceed 32767.
+
+    processedCountPtr - A pointer to storage for the number of samples
+    that were processed.
+
+  Outputs:
+
+    clippedCount - The number of clipped samples that were processed.
+
+**************************************************************************/
+__attribute__((target("avx2,popcnt")))
+static uint32_t countClippedAvx2(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t clipLevel,
+    uint32_t *processedCountPtr)
+{
+  uint32_t i;
+  uint32_t iterationCount;
+  uint64_t clippedByteCount;
+  __m256i magnitudes;
+  __m256i clipped;
+  const __m256i limit = _mm256_set1_epi16(MAX_COMPONENT_MAGNITUDE);
+  const __m256i threshold = _mm256_set1_epi16((short)(clipLevel - 1));
+
+  clippedByteCount = 0;
+
+  iterationCount = sampleCount / 8;
+
+  for (i = 0; i < iterationCount; i++)
+  {
+    magnitudes = _mm256_abs_epi16(loadIqAvx2(iqPtr,8 * i,format));
+    magnitudes = _mm256_min_epu16(magnitudes,limit);
+
+    clipped = _mm256_cmpgt_epi16(magnitudes,threshold);
+
+    // Either component clips the sample.
+    clipped = _mm256_or_si256(clipped,
+      _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(clipped,0xb1),0xb1));
+
+    clippedByteCount +=
+      (uint32_t)__builtin_popcount((uint32_t)_mm256_movemask_epi8(clipped));
+  } // for
+
+  *processedCountPtr = iterationCount * 8;
+
+  return ((uint32_t)(clippedByteCount / 4));
+
+} // countClippedAvx2
+
+/**************************************************************************
+
+  Name: loadIqSse2
+
+  Purpose: The purpose of this function is to load 4 complex samples
+  into 8 signed 16-bit lanes, with I in the even lanes and Q in the odd
+  lanes.
+
+  Calling Sequence: iq = loadIqSse2(iqPtr,firstSample,format)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    firstSample - The index of the first complex sample to load.
+
+    format - The sample format.
+
+  Outputs:
+
+    iq - The samples.
+
+**************************************************************************/
+__attribute__((target("sse2")))
+static inline __m128i loadIqSse2(const void *iqPtr,
+    uint32_t firstSample,
+    int format)
+{
+  __m128i iq;
+
+  if (format == FORMAT_S16)
+  {
+    iq = _mm_loadu_si128(
+      (const __m128i *)((const int16_t *)iqPtr + (2 * firstSample)));
+  } // if
+  else
+  {
+    iq = _mm_loadl_epi64(
+      (const __m128i *)((const int8_t *)iqPtr + (2 * firstSample)));
+
+    if (format == FORMAT_U8)
+    {
+      // Offset binary to 2's complement.
+      iq = _mm_xor_si128(iq,_mm_set1_epi8((char)0x80));
+    } // if
+
+    // Sign extend the bytes to 16 bits.
+    iq = _mm_srai_epi16(_mm_unpacklo_epi8(iq,iq),8);
+  } // else
+
+  return (iq);
+
+} // loadIqSse2
+
+/**************************************************************************
+
+  Name: sumAlphaMaxBetaMinSse2
+
+  Purpose: The purpose of this function is to accumulate the alpha max
+  plus beta min terms of a block, 4 samples at a time.  This is the
+  SSE2 version of sumAlphaMaxBetaMinAvx2().
+
+  Calling Sequence: sum = sumAlphaMaxBetaMinSse2(iqPtr,
+                                                 sampleCount,
+                                                 format,
+                                                 &processedCount)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    format - The sample format.
+
+    processedCountPtr - A pointer to storage for the number of samples
+    that were processed.
+
+  Outputs:
+
+    sum - The sum of 30max + 15min over the processed samples.
+
+**************************************************************************/
+__attribute__((target("sse2")))
+static uint64_t sumAlphaMaxBetaMinSse2(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t *processedCountPtr)
+{
+  uint32_t i;
+  uint32_t iterationCount;
+  uint64_t lanes[2];
+  __m128i iq;
+  __m128i magnitudes;
+  __m128i swapped;
+  __m128i terms;
+  __m128i narrowSum;
+  __m128i wideSum;
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i lowHalfMask = _mm_set1_epi32(0x0000ffff);
+  const __m128i coefficients =
+    _mm_set1_epi32((BETA_NUMERATOR << 16) | ALPHA_NUMERATOR);
+
+  narrowSum = _mm_setzero_si128();
+  wideSum = _mm_setzero_si128();
+
+  iterationCount = sampleCount / 4;
+
+  for (i = 0; i < iterationCount; i++)
+  {
+    iq = loadIqSse2(iqPtr,4 * i,format);
+
+    // The saturating negate limits -32768 to 32767.
+    magnitudes = _mm_max_epi16(iq,_mm_subs_epi16(zero,iq));
+
+    swapped = _mm_shufflehi_epi16(_mm_shufflelo_epi16(magnitudes,0xb1),0xb1);
+
+    // Maximum in the low half, minimum in the high half.
+    terms = _mm_or_si128(
+      _mm_and_si128(_mm_max_epi16(magnitudes,swapped),lowHalfMask),
+      _mm_andnot_si128(lowHalfMask,_mm_min_epi16(magnitudes,swapped)));
+
+    narrowSum = _mm_add_epi32(narrowSum,_mm_madd_epi16(terms,coefficients));
+
+    if ((i % FLUSH_INTERVAL) == (FLUSH_INTERVAL - 1))
+    {
+      wideSum = _mm_add_epi64(wideSum,_mm_unpacklo_epi32(narrowSum,zero));
+      wideSum = _mm_add_epi64(wideSum,_mm_unpackhi_epi32(narrowSum,zero));
+      narrowSum = _mm_setzero_si128();
+    } // if
+  } // for
+
+  wideSum = _mm_add_epi64(wideSum,_mm_unpacklo_epi32(narrowSum,zero));
+  wideSum = _mm_add_epi64(wideSum,_mm_unpackhi_epi32(narrowSum,zero));
+
+  _mm_storeu_si128((__m128i *)lanes,wideSum);
+
+  *processedCountPtr = iterationCount * 4;
+
+  return (lanes[0] + lanes[1]);
+
+} // sumAlphaMaxBetaMinSse2
+
+/**************************************************************************
+
+  Name: sumExactSse2
+
+  Purpose: The purpose of this function is to accumulate the exact
+  magnitudes of a block, 4 samples at a time.  This is the SSE2 version
+  of sumExactAvx2().
+
+  Calling Sequence: sum = sumExactSse2(iqPtr,
+                                       sampleCount,
+                                       format,
+                                       &processedCount)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    format - The sample format.
+
+    processedCountPtr - A pointer to storage for the number of samples
+    that were processed.
+
+  Outputs:
+
+    sum - The sum of the magnitudes of the processed samples.
+
+**************************************************************************/
+__attribute__((target("sse2")))
+static double sumExactSse2(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t *processedCountPtr)
+{
+  uint32_t i;
+  uint32_t iterationCount;
+  double lanes[2];
+  __m128i iq;
+  __m128 low;
+  __m128 high;
+  __m128 narrowSum;
+  __m128d wideSum;
+
+  narrowSum = _mm_setzero_ps();
+  wideSum = _mm_setzero_pd();
+
+  iterationCount = sampleCount / 4;
+
+  for (i = 0; i < iterationCount; i++)
+  {
+    iq = loadIqSse2(iqPtr,4 * i,format);
+
+    // Sign extend to 32 bits.
+    low = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(iq,iq),16));
+    high = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(iq,iq),16));
+
+    low = _mm_mul_ps(low,low);
+    high = _mm_mul_ps(high,high);
+
+    // I^2 + Q^2 in both lanes of a pair.
+    low = _mm_add_ps(low,_mm_shuffle_ps(low,low,0xb1));
+    high = _mm_add_ps(high,_mm_shuffle_ps(high,high,0xb1));
+
+    narrowSum = _mm_add_ps(narrowSum,_mm_sqrt_ps(low));
+    narrowSum = _mm_add_ps(narrowSum,_mm_sqrt_ps(high));
+
+    if ((i % FLUSH_INTERVAL) == (FLUSH_INTERVAL - 1))
+    {
+      wideSum = _mm_add_pd(wideSum,_mm_cvtps_pd(narrowSum));
+      wideSum = _mm_add_pd(wideSum,
+        _mm_cvtps_pd(_mm_movehl_ps(narrowSum,narrowSum)));
+      narrowSum = _mm_setzero_ps();
+    } // if
+  } // for
+
+  wideSum = _mm_add_pd(wideSum,_mm_cvtps_pd(narrowSum));
+  wideSum = _mm_add_pd(wideSum,
+    _mm_cvtps_pd(_mm_movehl_ps(narrowSum,narrowSum)));
+
+  _mm_storeu_pd(lanes,wideSum);
+
+  *processedCountPtr = iterationCount * 4;
+
+  return ((lanes[0] + lanes[1]) / 2);
+
+} // sumExactSse2
+
+/**************************************************************************
+
+  Name: countClippedSse2
+
+  Purpose: The purpose of this function is to count the clipped samples
+  of a block, 4 samples at a time.  This is the SSE2 version of
+  countClippedAvx2().
+
+  Calling Sequence: clippedCount = countClippedSse2(iqPtr,
+                                                    sampleCount,
+                                                    format,
+                                                    clipLevel,
+                                                    &processedCount)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    format - The sample format.
+
+    clipLevel - The component magnitude at which the ADC clips.  It
+    must not exceed 32767.
+
+    processedCountPtr - A pointer to storage for the number of samples
+    that were processed.
+
+  Outputs:
+
+    clippedCount - The number of clipped samples that were processed.
+
+**************************************************************************/
+__attribute__((target("sse2")))
+static uint32_t countClippedSse2(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t clipLevel,
+    uint32_t *processedCountPtr)
+{
+  uint32_t i;
+  uint32_t iterationCount;
+  uint64_t clippedByteCount;
+  __m128i iq;
+  __m128i magnitudes;
+  __m128i clipped;
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i threshold = _mm_set1_epi16((short)(clipLevel - 1));
+
+  clippedByteCount = 0;
+
+  iterationCount = sampleCount / 4;
+
+  for (i = 0; i < iterationCount; i++)
+  {
+    iq = loadIqSse2(iqPtr,4 * i,format);
+
+    // The saturating negate limits -32768 to 32767.
+    magnitudes = _mm_max_epi16(iq,_mm_subs_epi16(zero,iq));
+
+    clipped = _mm_cmpgt_epi16(magnitudes,threshold);
+
+    // Either component clips the sample.
+    clipped = _mm_or_si128(clipped,
+      _mm_shufflehi_epi16(_mm_shufflelo_epi16(clipped,0xb1),0xb1));
+
+    clippedByteCount +=
+      (uint32_t)__builtin_popcount((uint32_t)_mm_movemask_epi8(clipped));
+  } // for
+
+  *processedCountPtr = iterationCount * 4;
+
+  return ((uint32_t)(clippedByteCount / 4));
+
+} // countClippedSse2
+#endif // X86_KERNELS
+
+#ifdef NEON_KERNELS
+/**************************************************************************
+
+  Name: loadIqNeon
+
+  Purpose: The purpose of this function is to load 8 complex samples
+  and deinterleave them into I and Q vectors of signed 16-bit lanes.
+
+  Calling Sequence: iq = loadIqNeon(iqPtr,firstSample,format)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    firstSample - The index of the first complex sample to load.
+
+    format - The sample format.
+
+  Outputs:
+
+    iq - The I samples in val[0] and the Q samples in val[1].
+
+**************************************************************************/
+static inline int16x8x2_t loadIqNeon(const void *iqPtr,
+    uint32_t firstSample,
+    int format)
+{
+  int16x8x2_t iq;
+  int8x8x2_t signedBytes;
+  uint8x8x2_t unsignedBytes;
+
+  switch (format)
+  {
+    case FORMAT_U8:
+    {
+      unsignedBytes = vld2_u8((const uint8_t *)iqPtr + (2 * firstSample));
+
+      // Offset binary to 2's complement.
+      signedBytes.val[0] =
+        vreinterpret_s8_u8(veor_u8(unsignedBytes.val[0],vdup_n_u8(0x80)));
+      signedBytes.val[1] =
+        vreinterpret_s8_u8(veor_u8(unsignedBytes.val[1],vdup_n_u8(0x80)));
+
+      iq.val[0] = vmovl_s8(signedBytes.val[0]);
+      iq.val[1] = vmovl_s8(signedBytes.val[1]);
+      break;
+    } // case
+
+    case FORMAT_S8:
+    {
+      signedBytes = vld2_s8((const int8_t *)iqPtr + (2 * firstSample));
+
+      iq.val[0] = vmovl_s8(signedBytes.val[0]);
+      iq.val[1] = vmovl_s8(signedBytes.val[1]);
+      break;
+    } // case
+
+    default:
+    {
+      iq = vld2q_s16((const int16_t *)iqPtr + (2 * firstSample));
+      break;
+    } // case
+  } // switch
+
+  return (iq);
+
+} // loadIqNeon
+
+/**************************************************************************
+
+  Name: sumAlphaMaxBetaMinNeon
+
+  Purpose: The purpose of this function is to accumulate the alpha max
+  plus beta min terms of a block, 8 samples at a time.  The terms are
+  widened into 64-bit accumulators on every iteration.
+
+  Calling Sequence: sum = sumAlphaMaxBetaMinNeon(iqPtr,
+                                                 sampleCount,
+                                                 format,
+                                                 &processedCount)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    format - The sample format.
+
+    processedCountPtr - A pointer to storage for the number of samples
+    that were processed.
+
+  Outputs:
+
+    sum - The sum of 30max + 15min over the processed samples.
+
+**************************************************************************/
+static uint64_t sumAlphaMaxBetaMinNeon(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t *processedCountPtr)
+{
+  uint32_t i;
+  uint32_t iterationCount;
+  int16x8x2_t iq;
+  int16x8_t inPhase;
+  int16x8_t quadrature;
+  int16x8_t big;
+  int16x8_t small;
+  int32x4_t terms;
+  uint64x2_t wideSum;
+
+  wideSum = vdupq_n_u64(0);
+
+  iterationCount = sampleCount / 8;
+
+  for (i = 0; i < iterationCount; i++)
+  {
+    iq = loadIqNeon(iqPtr,8 * i,format);
+
+    // The saturating absolute value limits -32768 to 32767.
+    inPhase = vqabsq_s16(iq.val[0]);
+    quadrature = vqabsq_s16(iq.val[1]);
+
+    big = vmaxq_s16(inPhase,quadrature);
+    small = vminq_s16(inPhase,quadrature);
+
+    terms = vmull_n_s16(vget_low_s16(big),ALPHA_NUMERATOR);
+    terms = vmlal_n_s16(terms,vget_low_s16(small),BETA_NUMERATOR);
+    wideSum = vpadalq_u32(wideSum,vreinterpretq_u32_s32(terms));
+
+    terms = vmull_n_s16(vget_high_s16(big),ALPHA_NUMERATOR);
+    terms = vmlal_n_s16(terms,vget_high_s16(small),BETA_NUMERATOR);
+    wideSum = vpadalq_u32(wideSum,vreinterpretq_u32_s32(terms));
+  } // for
+
+  *processedCountPtr = iterationCount * 8;
+
+  return (vgetq_lane_u64(wideSum,0) + vgetq_lane_u64(wideSum,1));
+
+} // sumAlphaMaxBetaMinNeon
+
+/**************************************************************************
+
+  Name: countClippedNeon
+
+  Purpose: The purpose of this function is to count the clipped samples
+  of a block, 8 samples at a time.  The I and Q compares are ORed, and
+  the clipped samples are counted in 32-bit lanes.
+
+  Calling Sequence: clippedCount = countClippedNeon(iqPtr,
+                                                    sampleCount,
+                                                    format,
+                                                    clipLevel,
+                                                    &processedCount)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    format - The sample format.
+
+    clipLevel - The component magnitude at which the ADC clips.  It
+    must not exceed 32767.
+
+    processedCountPtr - A pointer to storage for the number of samples
+    that were processed.
+
+  Outputs:
+
+    clippedCount - The number of clipped samples that were processed.
+
+**************************************************************************/
+static uint32_t countClippedNeon(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t clipLevel,
+    uint32_t *processedCountPtr)
+{
+  uint32_t i;
+  uint32_t iterationCount;
+  int16x8x2_t iq;
+  uint16x8_t clipped;
+  uint32x4_t clippedCount;
+  const int16x8_t threshold = vdupq_n_s16((int16_t)clipLevel);
+
+  clippedCount = vdupq_n_u32(0);
+
+  iterationCount = sampleCount / 8;
+
+  for (i = 0; i < iterationCount; i++)
+  {
+    iq = loadIqNeon(iqPtr,8 * i,format);
+
+    // The saturating absolute value limits -32768 to 32767.
+    clipped = vorrq_u16(vcgeq_s16(vqabsq_s16(iq.val[0]),threshold),
+                        vcgeq_s16(vqabsq_s16(iq.val[1]),threshold));
+
+    // One per clipped sample.
+    clippedCount = vpadalq_u16(clippedCount,vshrq_n_u16(clipped,15));
+  } // for
+
+  *processedCountPtr = iterationCount * 8;
+
+  return (vgetq_lane_u32(clippedCount,0) + vgetq_lane_u32(clippedCount,1) +
+          vgetq_lane_u32(clippedCount,2) + vgetq_lane_u32(clippedCount,3));
+
+} // countClippedNeon
+
+#ifdef __aarch64__
+/**************************************************************************
+
+  Name: sumExactNeon
+
+  Purpose: The purpose of this function is to accumulate the exact
+  magnitudes of a block, 8 samples at a time.  The vector square root
+  is only available on AArch64.
+
+  Calling Sequence: sum = sumExactNeon(iqPtr,
+                                       sampleCount,
+                                       format,
+                                       &processedCount)
+
+  Inputs:
+
+    iqPtr - A pointer to the interleaved IQ samples.
+
+    sampleCount - The number of complex samples in the block.
+
+    format - The sample format.
+
+    processedCountPtr - A pointer to storage for the number of samples
+    that were processed.
+
+  Outputs:
+
+    sum - The sum of the magnitudes of the processed samples.
+
+**************************************************************************/
+static double sumExactNeon(const void *iqPtr,
+    uint32_t sampleCount,
+    int format,
+    uint32_t *processedCountPtr)
+{
+  uint32_t i;
+  uint32_t iterationCount;
+  int16x8x2_t iq;
+  float32x4_t inPhase;
+  float32x4_t quadrature;
+  float32x4_t narrowSum;
+  float64x2_t wideSum;
+
+  narrowSum = vdupq_n_f32(0);
+  wideSum = vdupq_n_f64(0);
+
+  iterationCount = sampleCount / 8;
+
+  for (i = 0; i < iterationCount; i++)
+  {
+    iq = loadIqNeon(iqPtr,8 * i,format);
+
+    inPhase = vcvtq_f32_s32(vmovl_s16(vget_low_s16(iq.val[0])));
+    quadrature = vcvtq_f32_s32(vmovl_s16(vget_low_s16(iq.val[1])));
+    narrowSum = vaddq_f32(narrowSum,vsqrtq_f32(
+      vaddq_f32(vmulq_f32(inPhase,inPhase),vmulq_f32(quadrature,quadrature))));
+
+    inPhase = vcvtq_f32_s32(vmovl_s16(vget_high_s16(iq.val[0])));
+    quadrature = vcvtq_f32_s32(vmovl_s16(vget_high_s16(iq.val[1])));
+    narrowSum = vaddq_f32(narrowSum,vsqrtq_f32(
+      vaddq_f32(vmulq_f32(inPhase,inPhase),vmulq_f32(quadrature,quadrature))));
+
+    if ((i % FLUSH_INTERVAL) == (FLUSH_INTERVAL - 1))
+    {
+      wideSum = vaddq_f64(wideSum,vcvt_f64_f32(vget_low_f32(narrowSum)));
+      wideSum = vaddq_f64(wideSum,vcvt_high_f64_f32(narrowSum));
+      narrowSum = vdupq_n_f32(0);
+    } // if
+  } // for
+
+  wideSum = vaddq_f64(wideSum,vcvt_f64_f32(vget_low_f32(narrowSum)));
+  wideSum = vaddq_f64(wideSum,vcvt_high_f64_f32(narrowSum));
+
+  *processedCountPtr = iterationCount * 8;
+
+  return (vgetq_lane_f64(wideSum,0) + vgetq_lane_f64(wideSum,1));
+
+} // sumExactNeon
+#endif // __aarch64__
+#endif // NEON_KERNELS
+
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+// End of static functions
+//_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
@@ -0,0 +1,343 @@
+//*******************************************************************
+// File: replayAgc.cc
+// This program replays an rtl_sdr recording (interleaved unsigned
+// 8-bit IQ samples) through the AGC, as fast as the samples can be
+// read.  The file is memory mapped, and each block is handed to the
+// replay (see agcReplay.h) where it lies in the mapping.  The gain
+// that the AGC applies is simulated, and a gain/RSSI timeline is
+// printed as comma separated values:
+//
+//   time,gainInDb,rssiInDbFs,signalInDbFs
+//   0.000000,24,-37.19,-13.19
+//
+// The time is in seconds from the start of the recording, the gain is
+// the gain that the block was given, the RSSI is the signal level at
+// the antenna (the recorded level less the gain of the recording), and
+// the signal level is the level that the AGC saw.  A summary is
+// printed to stderr as a JSON object.
+//
+// Usage: replayAgc [options] file.bin
+//
+//   -b samples       Samples per block (default 16384).
+//   -r sampleRate    Sample rate of the recording (default 2048000).
+//   -g gainDb        Gain that the recording was made with (default 24).
+//   -i gainDb        Gain that the AGC starts from (default 24).
+//   -o dBFs          AGC operating point (default -12).
+//   -a alpha         AGC filter coefficient (default 0.7).
+//   -D deadbandDb    AGC deadband (default 1).
+//   -B blankingLimit AGC blanking limit (default 1).
+//   -d decimation    Print every nth block of the timeline (default 1).
+//   -q               Do not print the timeline.
+//   -p               Read the whole file into memory before replaying.
+//*******************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "agcReplay.h"
+
+/**************************************************************************
+
+  Name: getTimeInSeconds
+
+  Purpose: The purpose of this function is to read the monotonic clock.
+
+  Calling Sequence: t = getTimeInSeconds()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    t - The time in seconds.
+
+**************************************************************************/
+static double getTimeInSeconds(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC,&now);
+
+  return ((double)now.tv_sec + ((double)now.tv_nsec * 1e-9));
+
+} // getTimeInSeconds
+
+//************************************************************
+// Mainline code.
+//************************************************************
+int main(int argc,char **argv)
+{
+  int fd;
+  int option;
+  int mapFlags;
+  int timelineEnabled;
+  uint32_t samplesPerBlock;
+  uint32_t decimation;
+  uint32_t sampleCount;
+  uint64_t blockIndex;
+  uint64_t offset;
+  uint64_t fileSize;
+  double startTime;
+  double wallSeconds;
+  double recordedSeconds;
+  const uint8_t *iqPtr;
+  struct stat fileStatus;
+  struct agcReplayConfig config;
+  struct agcReplayPoint point;
+  struct agcReplayResults results;
+  struct agcReplay *replayPtr;
+
+  agcReplay_getDefaultConfig(&config);
+
+  samplesPerBlock = 16384;
+  decimation = 1;
+  timelineEnabled = 1;
+  mapFlags = MAP_PRIVATE;
+
+  while ((option = getopt(argc,argv,"b:r:g:i:o:a:D:B:d:qp")) != -1)
+  {
+    switch (option)
+    {
+      case 'b':
+      {
+        samplesPerBlock = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'r':
+      {
+        config.sampleRate = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'g':
+      {
+        config.recordedGainInDb = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'i':
+      {
+        config.initialGainInDb = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'o':
+      {
+        config.operatingPointInDbFs = atoi(optarg);
+        break;
+      } // case
+
+      case 'a':
+      {
+        config.filterCoefficient = (float)atof(optarg);
+        break;
+      } // case
+
+      case 'D':
+      {
+        config.deadbandInDb = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'B':
+      {
+        config.blankingLimit = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'd':
+      {
+        decimation = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'q':
+      {
+        timelineEnabled = 0;
+        break;
+      } // case
+
+      case 'p':
+      {
+        mapFlags |= MAP_POPULATE;
+        break;
+      } // case
+
+      default:
+      {
+        fprintf(stderr,"Usage: %s [-b samples] [-r sampleRate] "
+                "[-g gainDb] [-i gainDb] [-o dBFs] [-a alpha] "
+                "[-D deadbandDb] [-B blankingLimit] [-d decimation] "
+                "[-q] [-p] file.bin\n",
+                argv[0]);
+        return (1);
+      } // case
+    } // switch
+  } // while
+
+  if (optind != (argc - 1))
+  {
+    fprintf(stderr,"Usage: %s [options] file.bin\n",argv[0]);
+    return (1);
+  } // if
+
+  if (samplesPerBlock == 0)
+  {
+    samplesPerBlock = 16384;
+  } // if
+
+  if (decimation == 0)
+  {
+    decimation = 1;
+  } // if
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Map the recording.  The kernel is told that it will be read
+  // from front to back, so that it reads ahead aggressively and
+  // drops the pages that have been replayed.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  fd = open(argv[optind],O_RDONLY);
+
+  if (fd < 0)
+  {
+    fprintf(stderr,"Could not open %s\n",argv[optind]);
+    return (1);
+  } // if
+
+  if (fstat(fd,&fileStatus) != 0)
+  {
+    fprintf(stderr,"Could not read the size of %s\n",argv[optind]);
+    close(fd);
+    return (1);
+  } // if
+
+  fileSize = (uint64_t)fileStatus.st_size;
+
+  if (fileSize < 2)
+  {
+    fprintf(stderr,"%s does not hold a sample\n",argv[optind]);
+    close(fd);
+    return (1);
+  } // if
+
+  iqPtr = (const uint8_t *)mmap(NULL,fileSize,PROT_READ,mapFlags,fd,0);
+
+  // The mapping keeps the file open.
+  close(fd);
+
+  if (iqPtr == (const uint8_t *)MAP_FAILED)
+  {
+    fprintf(stderr,"Could not map %s\n",argv[optind]);
+    return (1);
+  } // if
+
+  madvise((void *)iqPtr,fileSize,MADV_SEQUENTIAL);
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  replayPtr = agcReplay_create(&config);
+
+  if (replayPtr == NULL)
+  {
+    fprintf(stderr,"Could not create the replay.\n");
+    munmap((void *)iqPtr,fileSize);
+    return (1);
+  } // if
+
+  if (timelineEnabled)
+  {
+    // Let stdio write the timeline in large pieces.
+    setvbuf(stdout,NULL,_IOFBF,1 << 20);
+    printf("time,gainInDb,rssiInDbFs,signalInDbFs\n");
+  } // if
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Replay the recording.  A trailing odd byte is not a sample, and
+  // the last block may be short.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  startTime = getTimeInSeconds();
+
+  blockIndex = 0;
+
+  for (offset = 0; (offset + 2) <= fileSize; offset += 2 * sampleCount)
+  {
+    sampleCount = samplesPerBlock;
+
+    if ((offset + (2 * (uint64_t)sampleCount)) > fileSize)
+    {
+      sampleCount = (uint32_t)((fileSize - offset) / 2);
+    } // if
+
+    if (timelineEnabled && ((blockIndex % decimation) == 0))
+    {
+      agcReplay_acceptIqBlockU8(replayPtr,
+                                &iqPtr[offset],
+                                sampleCount,
+                                &point);
+
+      printf("%.6f,%u,%.2f,%.2f\n",
+             point.timeInSeconds,
+             point.gainInDb,
+             point.rssiInDbFs,
+             point.signalInDbFs);
+    } // if
+    else
+    {
+      agcReplay_acceptIqBlockU8(replayPtr,
+                                &iqPtr[offset],
+                                sampleCount,
+                                NULL);
+    } // else
+
+    blockIndex++;
+  } // for
+
+  fflush(stdout);
+
+  wallSeconds = getTimeInSeconds() - startTime;
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  agcReplay_getResults(replayPtr,&results);
+  agcReplay_destroy(replayPtr);
+  munmap((void *)iqPtr,fileSize);
+
+  recordedSeconds = (double)results.sampleCount / config.sampleRate;
+
+  fprintf(stderr,"{\"file\":\"%s\",\"samples\":%llu,\"blocks\":%llu,"
+          "\"recordedSeconds\":%.3f,\"wallSeconds\":%.3f,"
+          "\"realTimeFactor\":%.0f,\"megabytesPerSecond\":%.0f,"
+          "\"hardwareWrites\":%llu,\"inBandFraction\":%.3f,"
+          "\"clippedFraction\":%.3f,",
+          argv[optind],
+          (unsigned long long)results.sampleCount,
+          (unsigned long long)results.blockCount,
+          recordedSeconds,
+          wallSeconds,
+          recordedSeconds / wallSeconds,
+          ((double)fileSize / wallSeconds) * 1e-6,
+          (unsigned long long)results.hardwareWriteCount,
+          (double)results.inBandBlockCount / results.blockCount,
+          (double)results.clippedBlockCount / results.blockCount);
+
+  if (results.convergenceTimeInSeconds >= 0)
+  {
+    fprintf(stderr,"\"convergenceSeconds\":%.3f,",
+            results.convergenceTimeInSeconds);
+  } // if
+  else
+  {
+    fprintf(stderr,"\"convergenceSeconds\":null,");
+  } // else
+
+  fprintf(stderr,"\"finalGainDb\":%u}\n",results.finalGainInDb);
+
+  return (0);
+
+} // main
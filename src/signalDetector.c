@@ -0,0 +1,598 @@
+//**************************************************************************
+// file name: signalDetector.c
+//**************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "signalDetector.h"
+
+// The deque is indexed modulo its capacity, which is a power of two.
+#define DEQUE_MASK (DETECTOR_MAX_WINDOW_LENGTH - 1)
+
+// Decibel values are converted this many at a time.
+#define CONVERSION_CHUNK_SIZE (64)
+
+static void acceptPeak(struct signalDetector *me,uint32_t signalMagnitude);
+static void acceptValue(struct signalDetector *me,int64_t value);
+static uint64_t computeSquareRoot(uint64_t value);
+
+/**************************************************************************
+
+  Name: signalDetector_init
+
+  Purpose: The purpose of this function is to serve as the constructor
+  of a signal detector.  The detector starts out without a method, so
+  that it passes each magnitude through.
+
+  Calling Sequence: signalDetector_init(detectorPtr,dbfsPtr)
+
+  Inputs:
+
+    detectorPtr - A pointer to the detector.
+
+    dbfsPtr - A pointer to the calculator that converts magnitudes to
+    decibels.  It must outlive the detector.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void signalDetector_init(struct signalDetector *me,
+    const struct dbfsCalculator *dbfsPtr)
+{
+
+  me->dbfsPtr = dbfsPtr;
+
+  signalDetector_configure(me,
+                           DETECTOR_NONE,
+                           1,
+                           DETECTOR_COEFFICIENT_ONE,
+                           DETECTOR_COEFFICIENT_ONE);
+
+  return;
+
+} // signalDetector_init
+
+/**************************************************************************
+
+  Name: signalDetector_configure
+
+  Purpose: The purpose of this function is to set the method, the
+  window length and the smoothing of a detector.  The detector starts
+  over with an empty window.
+
+  Calling Sequence: signalDetector_configure(detectorPtr,mode,
+                                             windowLength,attackQ15,
+                                             decayQ15)
+
+  Inputs:
+
+    detectorPtr - A pointer to the detector.
+
+    mode - The detection method, DETECTOR_XXX.
+
+    windowLength - The number of magnitudes in the window, from 1 to
+    DETECTOR_MAX_WINDOW_LENGTH.
+
+    attackQ15 - The Q1.15 smoothing coefficient for a rising
+    measurement, from 1 to DETECTOR_COEFFICIENT_ONE.
+
+    decayQ15 - The Q1.15 smoothing coefficient for a falling
+    measurement, from 1 to DETECTOR_COEFFICIENT_ONE.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void signalDetector_configure(struct signalDetector *me,
+    int mode,
+    uint32_t windowLength,
+    uint32_t attackQ15,
+    uint32_t decayQ15)
+{
+
+  me->mode = mode;
+  me->windowLength = windowLength;
+  me->attackQ15 = attackQ15;
+  me->decayQ15 = decayQ15;
+
+  signalDetector_reset(me);
+
+  return;
+
+} // signalDetector_configure
+
+/**************************************************************************
+
+  Name: signalDetector_reset
+
+  Purpose: The purpose of this function is to empty the window and to
+  forget the smoothed measurement.  The AGC does this when the gain
+  changes, since the magnitudes in the window were taken with the old
+  gain.
+
+  Calling Sequence: signalDetector_reset(detectorPtr)
+
+  Inputs:
+
+    detectorPtr - A pointer to the detector.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void signalDetector_reset(struct signalDetector *me)
+{
+
+  me->sum = 0;
+  me->count = 0;
+  me->next = 0;
+
+  me->dequeHead = 0;
+  me->dequeCount = 0;
+  me->inputCount = 0;
+
+  me->smoothedQ8 = 0;
+  me->primed = 0;
+
+  me->blockSum = 0;
+  me->blockCount = 0;
+
+  return;
+
+} // signalDetector_reset
+
+/**************************************************************************
+
+  Name: signalDetector_accept
+
+  Purpose: The purpose of this function is to feed magnitudes to a
+  detector, one at a time or a block at a time.  Without a method, the
+  detector only remembers the magnitudes of this call.
+
+  Calling Sequence: signalDetector_accept(detectorPtr,signalMagnitudePtr,
+                                          count)
+
+  Inputs:
+
+    detectorPtr - A pointer to the detector.
+
+    signalMagnitudePtr - A pointer to the magnitudes.
+
+    count - The number of magnitudes.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void signalDetector_accept(struct signalDetector *me,
+    const uint32_t *signalMagnitudePtr,
+    uint32_t count)
+{
+  uint32_t i;
+  uint32_t j;
+  uint32_t chunkSize;
+  int32_t dbFsQ8[CONVERSION_CHUNK_SIZE];
+
+  switch (me->mode)
+  {
+    case DETECTOR_MEAN:
+    {
+      for (i = 0; i < count; i++)
+      {
+        acceptValue(me,signalMagnitudePtr[i]);
+      } // for
+      break;
+    } // case
+
+    case DETECTOR_RMS:
+    {
+      for (i = 0; i < count; i++)
+      {
+        acceptValue(me,
+                    (int64_t)((uint64_t)signalMagnitudePtr[i] *
+                              signalMagnitudePtr[i]));
+      } // for
+      break;
+    } // case
+
+    case DETECTOR_LOG_AVERAGE:
+    {
+      // Keep the mean magnitude of the block for display.
+      me->blockSum = 0;
+      me->blockCount = count;
+
+      for (i = 0; i < count; i++)
+      {
+        me->blockSum += signalMagnitudePtr[i];
+      } // for
+
+      // Let the calculator convert the magnitudes in bulk.
+      for (i = 0; i < count; i += chunkSize)
+      {
+        chunkSize = count - i;
+
+        if (chunkSize > CONVERSION_CHUNK_SIZE)
+        {
+          chunkSize = CONVERSION_CHUNK_SIZE;
+        } // if
+
+        dbfsCalculator_convertBlock(me->dbfsPtr,
+                                    &signalMagnitudePtr[i],
+                                    dbFsQ8,
+                                    chunkSize);
+
+        for (j = 0; j < chunkSize; j++)
+        {
+          acceptValue(me,dbFsQ8[j]);
+        } // for
+      } // for
+      break;
+    } // case
+
+    case DETECTOR_PEAK:
+    {
+      for (i = 0; i < count; i++)
+      {
+        acceptPeak(me,signalMagnitudePtr[i]);
+      } // for
+      break;
+    } // case
+
+    default:
+    {
+      // Only the magnitudes of this call count.
+      me->sum = 0;
+      me->count = count;
+
+      for (i = 0; i < count; i++)
+      {
+        me->sum += signalMagnitudePtr[i];
+      } // for
+      break;
+    } // case
+  } // switch
+
+  return;
+
+} // signalDetector_accept
+
+/**************************************************************************
+
+  Name: signalDetector_isReady
+
+  Purpose: The purpose of this function is to determine whether or not
+  the window of a detector has filled up since it was last reset.
+  Without a method, the detector is always ready.
+
+  Calling Sequence: ready = signalDetector_isReady(detectorPtr)
+
+  Inputs:
+
+    detectorPtr - A pointer to the detector.
+
+  Outputs:
+
+    ready - A flag that indicates whether or not the window is full.
+
+**************************************************************************/
+int signalDetector_isReady(const struct signalDetector *me)
+{
+  int ready;
+
+  if (me->mode == DETECTOR_NONE)
+  {
+    ready = (me->count != 0);
+  } // if
+  else
+  {
+    ready = (me->count == me->windowLength);
+  } // else
+
+  return (ready);
+
+} // signalDetector_isReady
+
+/**************************************************************************
+
+  Name: signalDetector_measure
+
+  Purpose: The purpose of this function is to measure the window, to
+  smooth the measurement, and to express the result in Q8 decibels
+  referenced to full scale, which is what the AGC algorithm acts upon.
+  The measurement rises with the attack coefficient and falls with the
+  decay coefficient.  The mean, the RMS value and the peak are smoothed
+  as magnitudes, and the log average is smoothed in decibels, so it is
+  returned as it is, with no conversion back to a magnitude.  Without a
+  method, the result is that of the rounded mean of the magnitudes of
+  the last call to signalDetector_accept(), without smoothing.
+
+  A magnitude is also provided for display.  It is the detected
+  magnitude, except for the log average, which reports the rounded
+  mean of the magnitudes of the last call to signalDetector_accept().
+
+  Calling Sequence: signalInDbFsQ8 =
+                      signalDetector_measure(detectorPtr,
+                                             signalMagnitudePtr)
+
+  Inputs:
+
+    detectorPtr - A pointer to the detector.
+
+    signalMagnitudePtr - A pointer to storage for the magnitude.
+
+  Outputs:
+
+    signalInDbFsQ8 - The detected level in Q8 decibels referenced to
+    full scale.
+
+**************************************************************************/
+int32_t signalDetector_measure(struct signalDetector *me,
+    uint32_t *signalMagnitudePtr)
+{
+  int64_t measurementQ8;
+  uint64_t meanSquare;
+  uint32_t coefficientQ15;
+  int32_t signalInDbFsQ8;
+
+  measurementQ8 = 0;
+
+  if (me->count != 0)
+  {
+    switch (me->mode)
+    {
+      case DETECTOR_RMS:
+      {
+        meanSquare = (uint64_t)me->sum / me->count;
+
+        // Keep 8 fractional bits unless that would overflow.
+        if (meanSquare < (1ULL << 48))
+        {
+          measurementQ8 = (int64_t)computeSquareRoot(meanSquare << 16);
+        } // if
+        else
+        {
+          measurementQ8 = (int64_t)computeSquareRoot(meanSquare) << 8;
+        } // else
+        break;
+      } // case
+
+      case DETECTOR_LOG_AVERAGE:
+      {
+        // The values are Q8 decibels already.
+        measurementQ8 = me->sum / me->count;
+        break;
+      } // case
+
+      case DETECTOR_PEAK:
+      {
+        measurementQ8 = (int64_t)me->dequeMagnitude[me->dequeHead] << 8;
+        break;
+      } // case
+
+      default:
+      {
+        measurementQ8 = (me->sum << 8) / me->count;
+        break;
+      } // case
+    } // switch
+  } // if
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Smooth the measurement.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  if ((me->mode == DETECTOR_NONE) || (!me->primed))
+  {
+    me->smoothedQ8 = measurementQ8;
+    me->primed = 1;
+  } // if
+  else
+  {
+    if (measurementQ8 > me->smoothedQ8)
+    {
+      coefficientQ15 = me->attackQ15;
+    } // if
+    else
+    {
+      coefficientQ15 = me->decayQ15;
+    } // else
+
+    me->smoothedQ8 += ((measurementQ8 - me->smoothedQ8) *
+                       (int64_t)coefficientQ15) / DETECTOR_COEFFICIENT_ONE;
+  } // else
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  if (me->mode == DETECTOR_LOG_AVERAGE)
+  {
+    // The measurement is in decibels below full scale already.
+    signalInDbFsQ8 = (int32_t)me->smoothedQ8;
+
+    *signalMagnitudePtr = 0;
+
+    if (me->blockCount != 0)
+    {
+      *signalMagnitudePtr =
+        (uint32_t)((me->blockSum + (me->blockCount / 2)) / me->blockCount);
+    } // if
+  } // if
+  else
+  {
+    *signalMagnitudePtr = (uint32_t)((me->smoothedQ8 + 128) >> 8);
+
+    signalInDbFsQ8 =
+      dbfsCalculator_convertMagnitudeToDbFsQ8(me->dbfsPtr,
+                                              *signalMagnitudePtr);
+  } // else
+
+  return (signalInDbFsQ8);
+
+} // signalDetector_measure
+
+/**************************************************************************
+
+  Name: acceptValue
+
+  Purpose: The purpose of this function is to add a value to the window
+  of a mean, RMS or log average detector.  When the window is full, the
+  oldest value makes room for it.
+
+  Calling Sequence: acceptValue(detectorPtr,value)
+
+  Inputs:
+
+    detectorPtr - A pointer to the detector.
+
+    value - The magnitude, its square, or its Q8 decibel value.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void acceptValue(struct signalDetector *me,int64_t value)
+{
+
+  if (me->count == me->windowLength)
+  {
+    me->sum -= me->window[me->next];
+  } // if
+  else
+  {
+    me->count++;
+  } // else
+
+  me->window[me->next] = value;
+  me->sum += value;
+
+  me->next++;
+
+  if (me->next == me->windowLength)
+  {
+    me->next = 0;
+  } // if
+
+  return;
+
+} // acceptValue
+
+/**************************************************************************
+
+  Name: acceptPeak
+
+  Purpose: The purpose of this function is to add a magnitude to the
+  deque of a peak detector.  The peak leaves the head of the deque when
+  it leaves the window.  Magnitudes at the tail that are no larger than
+  the new one can never be the peak again, so they are removed before
+  the new one is added.  Each magnitude is added and removed once, so
+  the cost is O(1) amortized.
+
+  Calling Sequence: acceptPeak(detectorPtr,signalMagnitude)
+
+  Inputs:
+
+    detectorPtr - A pointer to the detector.
+
+    signalMagnitude - The magnitude.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+void acceptPeak(struct signalDetector *me,uint32_t signalMagnitude)
+{
+  uint32_t tail;
+
+  // Inputs arrive one at a time, so at most one can leave the window.
+  if (me->dequeCount != 0)
+  {
+    if ((me->inputCount - me->dequeInput[me->dequeHead]) >=
+        me->windowLength)
+    {
+      me->dequeHead = (me->dequeHead + 1) & DEQUE_MASK;
+      me->dequeCount--;
+    } // if
+  } // if
+
+  // Drop the magnitudes that the new one hides.
+  while ((me->dequeCount != 0) &&
+         (me->dequeMagnitude[(me->dequeHead + me->dequeCount - 1) &
+                             DEQUE_MASK] <= signalMagnitude))
+  {
+    me->dequeCount--;
+  } // while
+
+  tail = (me->dequeHead + me->dequeCount) & DEQUE_MASK;
+
+  me->dequeMagnitude[tail] = signalMagnitude;
+  me->dequeInput[tail] = me->inputCount;
+  me->dequeCount++;
+
+  me->inputCount++;
+
+  if (me->count < me->windowLength)
+  {
+    me->count++;
+  } // if
+
+  return;
+
+} // acceptPeak
+
+/**************************************************************************
+
+  Name: computeSquareRoot
+
+  Purpose: The purpose of this function is to compute the integer
+  square root of a 64-bit value, one result bit at a time.
+
+  Calling Sequence: root = computeSquareRoot(value)
+
+  Inputs:
+
+    value - The value.
+
+  Outputs:
+
+    root - The largest integer whose square does not exceed the value.
+
+**************************************************************************/
+uint64_t computeSquareRoot(uint64_t value)
+{
+  uint64_t root;
+  uint64_t bit;
+
+  root = 0;
+
+  // Start with the highest power of four that fits.
+  bit = 1ULL << 62;
+
+  while (bit > value)
+  {
+    bit >>= 2;
+  } // while
+
+  while (bit != 0)
+  {
+    if (value >= (root + bit))
+    {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } // if
+    else
+    {
+      root >>= 1;
+    } // else
+
+    bit >>= 2;
+  } // while
+
+  return (root);
+
+} // computeSquareRoot
@@ -0,0 +1,387 @@
+//*******************************************************************
+// File: simulateAgc.cc
+// This program runs the AGC in a closed loop around a simulated
+// receiver (see agcSimulator.h), so that the AGC can be evaluated
+// without a radio.  Each scenario is run a number of times with
+// different random seeds, and the results are printed as one JSON
+// object per scenario:
+//
+//   {"scenario":"step","runs":100,"simulatedSeconds":1000.0,
+//    "wallSeconds":0.21,"realTimeFactor":4761,"events":200,
+//    "convergedEvents":200,"meanConvergenceMs":38.0,
+//    "maxConvergenceMs":61.0,"maxOvershootDb":9.1,
+//    "hardwareWritesPerRun":12.0,"inBandFraction":0.991,
+//    "clippedFraction":0.001}
+//
+// Usage: simulateAgc [options] [scenario ...]
+//
+//   Scenarios: step, fading, bursty, noise-only (default: all).
+//
+//   -r runs          Runs per scenario (default 1).
+//   -b bits          ADC magnitude bits (default 7).
+//   -d delayUs       VGA actuation delay (default 1000).
+//   -s settlingUs    VGA settling time constant (default 500).
+//   -t transientDb   Gain glitch after a gain change (default 6).
+//   -a alpha         AGC filter coefficient (default 0.7).
+//   -D deadbandDb    AGC deadband (default 1).
+//   -B blankingLimit AGC blanking limit (default 1).
+//*******************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "AutomaticGainControl.h"
+#include "agcSimulator.h"
+
+// The simulator that the AGC callbacks are connected to.
+static struct agcSimulator *simulatorPtr;
+
+/**************************************************************************
+
+  Name: setGainCallback
+
+  Purpose: The purpose of this function is to connect the AGC's set
+  gain callback to the simulated VGA.
+
+  Calling Sequence: setGainCallback(gainInDb)
+
+  Inputs:
+
+    gainInDb - The gain in decibels.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void setGainCallback(uint32_t gainInDb)
+{
+
+  agcSimulator_setGain(simulatorPtr,gainInDb);
+
+  return;
+
+} // setGainCallback
+
+/**************************************************************************
+
+  Name: getGainCallback
+
+  Purpose: The purpose of this function is to connect the AGC's get
+  gain callback to the simulated VGA.
+
+  Calling Sequence: gainInDb = getGainCallback()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    gainInDb - The gain in decibels.
+
+**************************************************************************/
+static uint32_t getGainCallback(void)
+{
+
+  return (agcSimulator_getGain(simulatorPtr));
+
+} // getGainCallback
+
+/**************************************************************************
+
+  Name: getTimeInSeconds
+
+  Purpose: The purpose of this function is to read the monotonic clock.
+
+  Calling Sequence: t = getTimeInSeconds()
+
+  Inputs:
+
+    None.
+
+  Outputs:
+
+    t - The time in seconds.
+
+**************************************************************************/
+static double getTimeInSeconds(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC,&now);
+
+  return ((double)now.tv_sec + ((double)now.tv_nsec * 1e-9));
+
+} // getTimeInSeconds
+
+/**************************************************************************
+
+  Name: runScenario
+
+  Purpose: The purpose of this function is to run a scenario a number
+  of times, and to print the combined results.
+
+  Calling Sequence: success = runScenario(namePtr,configPtr,runCount,
+                                          alpha,deadbandInDb,
+                                          blankingLimit)
+
+  Inputs:
+
+    namePtr - The name of the scenario.
+
+    configPtr - A pointer to the receiver configuration.
+
+    runCount - The number of runs.
+
+    alpha - The AGC filter coefficient.
+
+    deadbandInDb - The AGC deadband.
+
+    blankingLimit - The AGC blanking limit.
+
+  Outputs:
+
+    success - A flag that indicates whether or not the scenario was
+    run.  A value of 0 indicates that the scenario does not exist.
+
+**************************************************************************/
+static int runScenario(const char *namePtr,
+    struct agcSimulatorConfig *configPtr,
+    uint32_t runCount,
+    float alpha,
+    uint32_t deadbandInDb,
+    uint32_t blankingLimit)
+{
+  uint32_t run;
+  uint32_t signalMagnitude;
+  uint64_t timeInUs;
+  uint64_t eventCount;
+  uint64_t convergedEventCount;
+  uint64_t blockCount;
+  uint64_t inBandBlockCount;
+  uint64_t clippedBlockCount;
+  uint64_t hardwareWriteCount;
+  double simulatedSeconds;
+  double totalConvergenceTimeInUs;
+  double maxConvergenceTimeInUs;
+  double maxOvershootInDb;
+  double startTime;
+  double wallSeconds;
+  struct agcScenario scenario;
+  struct agcSimulatorResults results;
+
+  if (!agcSimulator_getScenario(namePtr,&scenario))
+  {
+    fprintf(stderr,"Unknown scenario: %s\n",namePtr);
+    return (0);
+  } // if
+
+  eventCount = 0;
+  convergedEventCount = 0;
+  blockCount = 0;
+  inBandBlockCount = 0;
+  clippedBlockCount = 0;
+  hardwareWriteCount = 0;
+  simulatedSeconds = 0;
+  totalConvergenceTimeInUs = 0;
+  maxConvergenceTimeInUs = 0;
+  maxOvershootInDb = 0;
+
+  startTime = getTimeInSeconds();
+
+  for (run = 0; run < runCount; run++)
+  {
+    configPtr->seed = run + 1;
+
+    simulatorPtr = agcSimulator_create(configPtr,&scenario);
+
+    if (simulatorPtr == NULL)
+    {
+      fprintf(stderr,"Could not create the simulator.\n");
+      return (0);
+    } // if
+
+    agc_init(configPtr->operatingPointInDbFs,
+             configPtr->maxGainInDb,
+             configPtr->signalMagnitudeBitCount,
+             setGainCallback,
+             getGainCallback);
+
+    agc_setAgcFilterCoefficient(alpha);
+    agc_setDeadband(deadbandInDb);
+    agc_setBlankingLimit(blankingLimit);
+    agc_enable();
+
+    while (agcSimulator_step(simulatorPtr,&signalMagnitude,&timeInUs))
+    {
+      agc_acceptDataAt(signalMagnitude,timeInUs);
+    } // while
+
+    agcSimulator_getResults(simulatorPtr,&results);
+    agcSimulator_destroy(simulatorPtr);
+    simulatorPtr = NULL;
+
+    eventCount += results.eventCount;
+    convergedEventCount += results.convergedEventCount;
+    blockCount += results.blockCount;
+    inBandBlockCount += results.inBandBlockCount;
+    clippedBlockCount += results.clippedBlockCount;
+    hardwareWriteCount += results.hardwareWriteCount;
+    simulatedSeconds += (double)results.simulatedTimeInUs * 1e-6;
+    totalConvergenceTimeInUs +=
+      results.meanConvergenceTimeInUs * results.convergedEventCount;
+
+    if (results.maxConvergenceTimeInUs > maxConvergenceTimeInUs)
+    {
+      maxConvergenceTimeInUs = results.maxConvergenceTimeInUs;
+    } // if
+
+    if (results.maxOvershootInDb > maxOvershootInDb)
+    {
+      maxOvershootInDb = results.maxOvershootInDb;
+    } // if
+  } // for
+
+  wallSeconds = getTimeInSeconds() - startTime;
+
+  printf("{\"scenario\":\"%s\",\"runs\":%u,\"simulatedSeconds\":%.1f,"
+         "\"wallSeconds\":%.3f,\"realTimeFactor\":%.0f,"
+         "\"events\":%llu,\"convergedEvents\":%llu,"
+         "\"meanConvergenceMs\":%.1f,\"maxConvergenceMs\":%.1f,"
+         "\"maxOvershootDb\":%.1f,\"hardwareWritesPerRun\":%.1f,"
+         "\"inBandFraction\":%.3f,\"clippedFraction\":%.3f}\n",
+         namePtr,
+         runCount,
+         simulatedSeconds,
+         wallSeconds,
+         simulatedSeconds / wallSeconds,
+         (unsigned long long)eventCount,
+         (unsigned long long)convergedEventCount,
+         (convergedEventCount != 0) ?
+           (totalConvergenceTimeInUs / convergedEventCount) * 1e-3 : 0.0,
+         maxConvergenceTimeInUs * 1e-3,
+         maxOvershootInDb,
+         (double)hardwareWriteCount / runCount,
+         (double)inBandBlockCount / blockCount,
+         (double)clippedBlockCount / blockCount);
+
+  return (1);
+
+} // runScenario
+
+//************************************************************
+// Mainline code.
+//************************************************************
+int main(int argc,char **argv)
+{
+  int i;
+  int option;
+  int success;
+  uint32_t runCount;
+  uint32_t deadbandInDb;
+  uint32_t blankingLimit;
+  float alpha;
+  struct agcSimulatorConfig config;
+  static const char *allScenarios[] = {"step","fading","bursty","noise-only"};
+
+  agcSimulator_getDefaultConfig(&config);
+
+  runCount = 1;
+  alpha = 0.7f;
+  deadbandInDb = 1;
+  blankingLimit = 1;
+
+  while ((option = getopt(argc,argv,"r:b:d:s:t:a:D:B:")) != -1)
+  {
+    switch (option)
+    {
+      case 'r':
+      {
+        runCount = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'b':
+      {
+        config.signalMagnitudeBitCount = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'd':
+      {
+        config.actuationDelayInUs = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 's':
+      {
+        config.settlingTimeInUs = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 't':
+      {
+        config.transientInDb = (float)atof(optarg);
+        break;
+      } // case
+
+      case 'a':
+      {
+        alpha = (float)atof(optarg);
+        break;
+      } // case
+
+      case 'D':
+      {
+        deadbandInDb = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'B':
+      {
+        blankingLimit = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      default:
+      {
+        fprintf(stderr,"Usage: %s [-r runs] [-b bits] [-d delayUs] "
+                "[-s settlingUs] [-t transientDb] [-a alpha] "
+                "[-D deadbandDb] [-B blankingLimit] [scenario ...]\n",
+                argv[0]);
+        return (1);
+      } // case
+    } // switch
+  } // while
+
+  if (runCount == 0)
+  {
+    runCount = 1;
+  } // if
+
+  success = 1;
+
+  if (optind < argc)
+  {
+    for (i = optind; i < argc; i++)
+    {
+      success &= runScenario(argv[i],&config,runCount,
+                             alpha,deadbandInDb,blankingLimit);
+    } // for
+  } // if
+  else
+  {
+    for (i = 0; i < 4; i++)
+    {
+      success &= runScenario(allScenarios[i],&config,runCount,
+                             alpha,deadbandInDb,blankingLimit);
+    } // for
+  } // else
+
+  return (success ? 0 : 1);
+
+} // main
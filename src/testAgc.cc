@@ -102,7 +102,6 @@ static uint32_t getGainCallback(void)
 //************************************************************  
 int main(int argc,char **argv)
 {
-  uint32_t i;
   uint32_t numberOfBits;
   uint32_t maxAmplifierGainInDb;
   int32_t operatingPointInDbFs;
@@ -158,13 +157,6 @@ int main(int argc,char **argv)
   agc_displayInternalInformation(&displayBufferPtr);
   printf("%s\n\n",displayBufferPtr);
 
-  i = 0;
-
-  while (1)
-  {
-    i = i + 1;
-  } // while
-
   // Free resources.Ptr;
   delete[] displayBufferPtr;
 
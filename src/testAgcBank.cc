@@ -0,0 +1,278 @@
+//*******************************************************************
+// File: testAgcBank.cc
+// This program checks that the AVX2 kernel of the AGC bank computes
+// exactly what the scalar loop computes.  buildTestAgcBank.sh compiles
+// agcBank.c a second time with AGC_BANK_SCALAR_ONLY defined, and
+// renames the functions of that build to scalar_agcBank_xxx(), so both
+// builds run in this program.  Each bank closes a loop around its own
+// simulated amplifiers, and both are given the same channel
+// configurations, the same input signal levels and the same external
+// gain changes.  After every step, the gains and the lists of changed
+// channels of the two banks must be identical.  The channel count is
+// not a multiple of 8, so the scalar leftovers of the vector build are
+// exercised as well.  The program exits with a status of 0 if the two
+// banks agree, and it exits with a status of 1 otherwise.
+//*******************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "agcBank.h"
+
+extern "C"
+{
+// The scalar-only build of the bank.
+struct agcBank *scalar_agcBank_create(uint32_t channelCount);
+void scalar_agcBank_destroy(struct agcBank *bankPtr);
+int scalar_agcBank_init(struct agcBank *bankPtr,
+    int32_t operatingPointInDbFs,
+    uint32_t maxAmplifierGainInDb,
+    uint32_t signalMagnitudeBitCount);
+int scalar_agcBank_setOperatingPoint(struct agcBank *bankPtr,
+    uint32_t channel,
+    int32_t operatingPointInDbFs);
+int scalar_agcBank_setAgcFilterCoefficient(struct agcBank *bankPtr,
+    uint32_t channel,
+    float coefficient);
+int scalar_agcBank_setDeadband(struct agcBank *bankPtr,
+    uint32_t channel,
+    uint32_t deadbandInDb);
+int scalar_agcBank_setBlankingLimit(struct agcBank *bankPtr,
+    uint32_t channel,
+    uint32_t blankingLimit);
+int scalar_agcBank_setGainInDb(struct agcBank *bankPtr,
+    uint32_t channel,
+    uint32_t gainInDb);
+uint32_t scalar_agcBank_run(struct agcBank *bankPtr,
+    const uint32_t *signalMagnitudePtr,
+    uint32_t *changedChannelPtr);
+const uint32_t *scalar_agcBank_getGains(struct agcBank *bankPtr);
+}
+
+// Bank parameters.
+#define CHANNEL_COUNT (203)
+#define OPERATING_POINT_IN_DBFS (-12)
+#define MAX_AMPLIFIER_GAIN_IN_DB (46)
+#define SIGNAL_MAGNITUDE_BIT_COUNT (12)
+#define NUMBER_OF_STEPS (5000)
+
+/**************************************************************************
+
+  Name: computeMagnitude
+
+  Purpose: The purpose of this function is to compute the magnitude
+  that the ADC of a channel presents for an input signal level and an
+  amplifier gain.  The ADC saturates at full scale.
+
+  Calling Sequence: signalMagnitude = computeMagnitude(inputLevelInDbFs,
+                                                       gainInDb)
+
+  Inputs:
+
+    inputLevelInDbFs - The level at the amplifier input, referenced to
+    full scale.
+
+    gainInDb - The gain of the amplifier.
+
+  Outputs:
+
+    signalMagnitude - The signal magnitude.
+
+**************************************************************************/
+static uint32_t computeMagnitude(int32_t inputLevelInDbFs,uint32_t gainInDb)
+{
+  double fullScale;
+  double magnitude;
+
+  fullScale = (double)((1U << SIGNAL_MAGNITUDE_BIT_COUNT) - 1);
+
+  magnitude = fullScale * pow(10.0,(inputLevelInDbFs + (double)gainInDb) / 20);
+
+  if (magnitude > fullScale)
+  {
+    magnitude = fullScale;
+  } // if
+
+  return ((uint32_t)(magnitude + 0.5));
+
+} // computeMagnitude
+
+//************************************************************
+// Mainline code.
+//************************************************************
+int main(int argc,char **argv)
+{
+  uint32_t i;
+  uint32_t step;
+  uint32_t channel;
+  uint32_t value;
+  uint32_t vectorChangedCount;
+  uint32_t scalarChangedCount;
+  uint32_t mismatchCount;
+  uint64_t changeCount;
+  int32_t inputLevelInDbFs[CHANNEL_COUNT];
+  uint32_t vectorMagnitude[CHANNEL_COUNT];
+  uint32_t scalarMagnitude[CHANNEL_COUNT];
+  uint32_t vectorChanged[CHANNEL_COUNT];
+  uint32_t scalarChanged[CHANNEL_COUNT];
+  const uint32_t *vectorGainPtr;
+  const uint32_t *scalarGainPtr;
+  float alpha;
+  struct agcBank *vectorBankPtr;
+  struct agcBank *scalarBankPtr;
+  static const float alphas[] = {0.001f,0.05f,0.1f,0.3f,0.5f,0.7f,0.8f,0.998f};
+
+  // Make the runs repeatable.
+  srand(1);
+
+  vectorBankPtr = agcBank_create(CHANNEL_COUNT);
+  scalarBankPtr = scalar_agcBank_create(CHANNEL_COUNT);
+
+  if ((vectorBankPtr == NULL) || (scalarBankPtr == NULL))
+  {
+    fprintf(stderr,"Could not create the banks\n");
+    return (1);
+  } // if
+
+  agcBank_init(vectorBankPtr,
+               OPERATING_POINT_IN_DBFS,
+               MAX_AMPLIFIER_GAIN_IN_DB,
+               SIGNAL_MAGNITUDE_BIT_COUNT);
+
+  scalar_agcBank_init(scalarBankPtr,
+                      OPERATING_POINT_IN_DBFS,
+                      MAX_AMPLIFIER_GAIN_IN_DB,
+                      SIGNAL_MAGNITUDE_BIT_COUNT);
+
+  // Give every channel its own configuration.
+  for (channel = 0; channel < CHANNEL_COUNT; channel++)
+  {
+    value = -(rand() % 30);
+    agcBank_setOperatingPoint(vectorBankPtr,channel,(int32_t)value);
+    scalar_agcBank_setOperatingPoint(scalarBankPtr,channel,(int32_t)value);
+
+    alpha = alphas[rand() % (sizeof(alphas) / sizeof(alphas[0]))];
+    agcBank_setAgcFilterCoefficient(vectorBankPtr,channel,alpha);
+    scalar_agcBank_setAgcFilterCoefficient(scalarBankPtr,channel,alpha);
+
+    value = rand() % 4;
+    agcBank_setDeadband(vectorBankPtr,channel,value);
+    scalar_agcBank_setDeadband(scalarBankPtr,channel,value);
+
+    value = rand() % 4;
+    agcBank_setBlankingLimit(vectorBankPtr,channel,value);
+    scalar_agcBank_setBlankingLimit(scalarBankPtr,channel,value);
+
+    inputLevelInDbFs[channel] = -(rand() % 80);
+  } // for
+
+  mismatchCount = 0;
+  changeCount = 0;
+
+  vectorGainPtr = agcBank_getGains(vectorBankPtr);
+  scalarGainPtr = scalar_agcBank_getGains(scalarBankPtr);
+
+  for (step = 0; (step < NUMBER_OF_STEPS) && (mismatchCount == 0); step++)
+  {
+    for (channel = 0; channel < CHANNEL_COUNT; channel++)
+    {
+      // Occasional level steps, which drive the gains to the rails too.
+      if ((rand() % 200) == 0)
+      {
+        inputLevelInDbFs[channel] = -(rand() % 80);
+      } // if
+
+      // Each bank sees the signal through its own amplifier.
+      value = rand() % 3;
+
+      vectorMagnitude[channel] =
+        computeMagnitude(inputLevelInDbFs[channel] + value - 1,
+                         vectorGainPtr[channel]);
+      scalarMagnitude[channel] =
+        computeMagnitude(inputLevelInDbFs[channel] + value - 1,
+                         scalarGainPtr[channel]);
+    } // for
+
+    // Occasionally, someone else changes a gain or a blanking limit.
+    if ((rand() % 10) == 0)
+    {
+      channel = rand() % CHANNEL_COUNT;
+      value = rand() % (MAX_AMPLIFIER_GAIN_IN_DB + 1);
+
+      agcBank_setGainInDb(vectorBankPtr,channel,value);
+      scalar_agcBank_setGainInDb(scalarBankPtr,channel,value);
+    } // if
+
+    if ((rand() % 50) == 0)
+    {
+      channel = rand() % CHANNEL_COUNT;
+      value = rand() % 4;
+
+      agcBank_setBlankingLimit(vectorBankPtr,channel,value);
+      scalar_agcBank_setBlankingLimit(scalarBankPtr,channel,value);
+    } // if
+
+    vectorChangedCount = agcBank_run(vectorBankPtr,
+                                     vectorMagnitude,
+                                     vectorChanged);
+    scalarChangedCount = scalar_agcBank_run(scalarBankPtr,
+                                            scalarMagnitude,
+                                            scalarChanged);
+
+    changeCount += vectorChangedCount;
+
+    if (vectorChangedCount != scalarChangedCount)
+    {
+      printf("step %u: %u channels changed, the scalar bank changed %u\n",
+             step,vectorChangedCount,scalarChangedCount);
+      mismatchCount++;
+    } // if
+    else
+    {
+      for (i = 0; i < vectorChangedCount; i++)
+      {
+        if (vectorChanged[i] != scalarChanged[i])
+        {
+          mismatchCount++;
+        } // if
+      } // for
+    } // else
+
+    for (channel = 0; channel < CHANNEL_COUNT; channel++)
+    {
+      if (vectorGainPtr[channel] != scalarGainPtr[channel])
+      {
+        printf("step %u channel %u: gain %u, scalar gain %u\n",
+               step,channel,vectorGainPtr[channel],scalarGainPtr[channel]);
+        mismatchCount++;
+      } // if
+    } // for
+  } // for
+
+#if defined(__x86_64__) || defined(__i386__)
+  if (!__builtin_cpu_supports("avx2"))
+  {
+    printf("This processor has no AVX2, so both banks are scalar\n");
+  } // if
+#endif
+
+  printf("%u steps of %u channels, %llu gain changes, %u mismatches\n",
+         step,CHANNEL_COUNT,(unsigned long long)changeCount,mismatchCount);
+
+  agcBank_destroy(vectorBankPtr);
+  scalar_agcBank_destroy(scalarBankPtr);
+
+  if (mismatchCount == 0)
+  {
+    printf("PASS\n");
+  } // if
+  else
+  {
+    printf("FAIL\n");
+  } // else
+
+  return ((mismatchCount == 0) ? 0 : 1);
+
+} // main
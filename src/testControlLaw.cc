@@ -0,0 +1,378 @@
+//*******************************************************************
+// File: testControlLaw.cc
+// This program compares the fixed-point build of the AGC with the
+// floating point build.  buildTestControlLaw.sh compiles
+// AutomaticGainControl.c both ways and renames the functions of the
+// fixed-point build to fixedPoint_agcInstance_xxx(), so both builds
+// run in this program.  Each build closes a loop around a simulated
+// amplifier, both loops are given the same sequence of input signal
+// levels, and the settings that the two AGCs give their amplifiers are
+// compared on every step, for a range of filter coefficients and
+// deadbands, and for an amplifier with a continuous gain range and one
+// with gain steps.  The rails, the deadband and the blanking are those
+// of the library, so nothing of runHarris() is re-implemented here.
+//
+// When the loops split by 1dB, the deadband can make one of them write
+// the amplifier an invocation before the other, and its blanking then
+// runs an invocation ahead.  While the gain slews after a level change,
+// the settings can differ by many decibels for a few invocations, so
+// the largest difference is only measured once the input level has been
+// steady for SETTLING_STEPS steps.  The program exits with a status of
+// 0 if the two builds agree within the tolerances that are documented
+// in agcControlLaw.h, and it exits with a status of 1 otherwise.
+//*******************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "AutomaticGainControl.h"
+
+extern "C"
+{
+// The fixed-point build of the AGC.
+struct agcInstance *fixedPoint_agcInstance_create(void);
+void fixedPoint_agcInstance_destroy(struct agcInstance *agcPtr);
+int fixedPoint_agcInstance_init(struct agcInstance *agcPtr,
+    int32_t operatingPointInDbFs,
+    uint32_t maxAmplifierGainInDb,
+    uint32_t signalMagnitudeBitCount,
+    void (*setGainCallbackPtr)(void *contextPtr,uint32_t gainIndB),
+    uint32_t (*getGainCallbackPtr)(void *contextPtr),
+    void *contextPtr);
+int fixedPoint_agcInstance_initWithGainSteps(struct agcInstance *agcPtr,
+    int32_t operatingPointInDbFs,
+    const uint32_t *gainStepInDbPtr,
+    uint32_t gainStepCount,
+    uint32_t signalMagnitudeBitCount,
+    void (*setGainStepCallbackPtr)(void *contextPtr,uint32_t gainStep),
+    uint32_t (*getGainStepCallbackPtr)(void *contextPtr),
+    void *contextPtr);
+int fixedPoint_agcInstance_setAgcFilterCoefficient(
+    struct agcInstance *agcPtr,
+    float coefficient);
+int fixedPoint_agcInstance_setDeadband(struct agcInstance *agcPtr,
+    uint32_t deadbandInDb);
+int fixedPoint_agcInstance_enable(struct agcInstance *agcPtr);
+void fixedPoint_agcInstance_acceptData(struct agcInstance *agcPtr,
+    uint32_t signalMagnitude);
+}
+
+// The tolerances that are being verified.  The difference is in
+// decibels, or in steps for the amplifier with gain steps.
+#define MAX_SETTING_DIFFERENCE (2)
+#define MAX_MISMATCH_FRACTION (0.1)
+#define SETTLING_STEPS (100)
+
+// Loop parameters.
+#define OPERATING_POINT_IN_DBFS (-12)
+#define MAX_AMPLIFIER_GAIN_IN_DB (46)
+#define SIGNAL_MAGNITUDE_BIT_COUNT (15)
+#define INITIAL_GAIN_IN_DB (24)
+#define NUMBER_OF_STEPS (100000)
+
+// A stepped amplifier whose minimum gain is not 0dB.
+static const uint32_t gainStepInDb[] = {6,12,18,24,30,36,42};
+
+#define GAIN_STEP_COUNT (sizeof(gainStepInDb) / sizeof(gainStepInDb[0]))
+
+// The amplifier that an AGC controls.
+struct amplifier
+{
+  // The gain table, or NULL if any whole number of decibels can be set.
+  const uint32_t *gainStepInDbPtr;
+
+  // What the AGC last set, in decibels or as a step index.
+  uint32_t setting;
+
+  uint32_t gainInDb;
+};
+
+/**************************************************************************
+
+  Name: setGainCallback
+
+  Purpose: The purpose of this function is to set the gain of an
+  amplifier on behalf of an AGC.
+
+  Calling Sequence: setGainCallback(contextPtr,setting)
+
+  Inputs:
+
+    contextPtr - A pointer to the amplifier.
+
+    setting - The gain in decibels, or the index of a gain step.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void setGainCallback(void *contextPtr,uint32_t setting)
+{
+  struct amplifier *amplifierPtr;
+
+  amplifierPtr = (struct amplifier *)contextPtr;
+
+  amplifierPtr->setting = setting;
+  amplifierPtr->gainInDb = setting;
+
+  if (amplifierPtr->gainStepInDbPtr != NULL)
+  {
+    amplifierPtr->gainInDb = amplifierPtr->gainStepInDbPtr[setting];
+  } // if
+
+  return;
+
+} // setGainCallback
+
+/**************************************************************************
+
+  Name: getGainCallback
+
+  Purpose: The purpose of this function is to report the gain of an
+  amplifier to an AGC.
+
+  Calling Sequence: setting = getGainCallback(contextPtr)
+
+  Inputs:
+
+    contextPtr - A pointer to the amplifier.
+
+  Outputs:
+
+    setting - The gain in decibels, or the index of a gain step.
+
+**************************************************************************/
+static uint32_t getGainCallback(void *contextPtr)
+{
+
+  return (((struct amplifier *)contextPtr)->setting);
+
+} // getGainCallback
+
+/**************************************************************************
+
+  Name: computeMagnitude
+
+  Purpose: The purpose of this function is to compute the magnitude
+  that the ADC presents for an input signal level and an amplifier
+  gain.  The ADC saturates at full scale.
+
+  Calling Sequence: signalMagnitude = computeMagnitude(inputLevelInDbFs,
+                                                       gainInDb)
+
+  Inputs:
+
+    inputLevelInDbFs - The level at the amplifier input, referenced to
+    full scale.
+
+    gainInDb - The gain of the amplifier.
+
+  Outputs:
+
+    signalMagnitude - The signal magnitude.
+
+**************************************************************************/
+static uint32_t computeMagnitude(double inputLevelInDbFs,uint32_t gainInDb)
+{
+  double fullScale;
+  double magnitude;
+
+  fullScale = (double)((1U << SIGNAL_MAGNITUDE_BIT_COUNT) - 1);
+
+  magnitude = fullScale * pow(10.0,(inputLevelInDbFs + gainInDb) / 20);
+
+  if (magnitude > fullScale)
+  {
+    magnitude = fullScale;
+  } // if
+
+  if (magnitude < 1)
+  {
+    magnitude = 1;
+  } // if
+
+  return ((uint32_t)(magnitude + 0.5));
+
+} // computeMagnitude
+
+//************************************************************
+// Mainline code.
+//************************************************************
+int main(int argc,char **argv)
+{
+  uint32_t i;
+  uint32_t step;
+  uint32_t deadbandInDb;
+  uint32_t stepsAtLevel;
+  uint32_t mismatchCount;
+  uint32_t maxSettingDifference;
+  uint32_t settingDifference;
+  int stepped;
+  int success;
+  double inputLevelInDbFs;
+  double noiseInDb;
+  float alpha;
+  struct amplifier floatAmplifier;
+  struct amplifier fixedAmplifier;
+  struct agcInstance *floatAgcPtr;
+  struct agcInstance *fixedAgcPtr;
+  static const float alphas[] = {0.001f,0.05f,0.1f,0.3f,0.5f,0.7f,0.8f,0.998f};
+
+  success = 1;
+
+  // Make the runs repeatable.
+  srand(1);
+
+  floatAgcPtr = agcInstance_create();
+  fixedAgcPtr = fixedPoint_agcInstance_create();
+
+  if ((floatAgcPtr == NULL) || (fixedAgcPtr == NULL))
+  {
+    fprintf(stderr,"Could not create the AGC instances\n");
+    return (1);
+  } // if
+
+  for (stepped = 0; stepped <= 1; stepped++)
+  {
+    for (i = 0; i < (sizeof(alphas) / sizeof(alphas[0])); i++)
+    {
+      for (deadbandInDb = 0; deadbandInDb <= 2; deadbandInDb++)
+      {
+        alpha = alphas[i];
+
+        floatAmplifier.gainStepInDbPtr = NULL;
+        floatAmplifier.setting = INITIAL_GAIN_IN_DB;
+        floatAmplifier.gainInDb = INITIAL_GAIN_IN_DB;
+
+        if (stepped)
+        {
+          // The initial gain is step 3.
+          floatAmplifier.gainStepInDbPtr = gainStepInDb;
+          floatAmplifier.setting = 3;
+
+          agcInstance_initWithGainSteps(floatAgcPtr,
+                                        OPERATING_POINT_IN_DBFS,
+                                        gainStepInDb,
+                                        GAIN_STEP_COUNT,
+                                        SIGNAL_MAGNITUDE_BIT_COUNT,
+                                        setGainCallback,
+                                        getGainCallback,
+                                        &floatAmplifier);
+
+          fixedAmplifier = floatAmplifier;
+
+          fixedPoint_agcInstance_initWithGainSteps(fixedAgcPtr,
+                                                   OPERATING_POINT_IN_DBFS,
+                                                   gainStepInDb,
+                                                   GAIN_STEP_COUNT,
+                                                   SIGNAL_MAGNITUDE_BIT_COUNT,
+                                                   setGainCallback,
+                                                   getGainCallback,
+                                                   &fixedAmplifier);
+        } // if
+        else
+        {
+          agcInstance_init(floatAgcPtr,
+                           OPERATING_POINT_IN_DBFS,
+                           MAX_AMPLIFIER_GAIN_IN_DB,
+                           SIGNAL_MAGNITUDE_BIT_COUNT,
+                           setGainCallback,
+                           getGainCallback,
+                           &floatAmplifier);
+
+          fixedAmplifier = floatAmplifier;
+
+          fixedPoint_agcInstance_init(fixedAgcPtr,
+                                      OPERATING_POINT_IN_DBFS,
+                                      MAX_AMPLIFIER_GAIN_IN_DB,
+                                      SIGNAL_MAGNITUDE_BIT_COUNT,
+                                      setGainCallback,
+                                      getGainCallback,
+                                      &fixedAmplifier);
+        } // else
+
+        agcInstance_setAgcFilterCoefficient(floatAgcPtr,alpha);
+        agcInstance_setDeadband(floatAgcPtr,deadbandInDb);
+        agcInstance_enable(floatAgcPtr);
+
+        fixedPoint_agcInstance_setAgcFilterCoefficient(fixedAgcPtr,alpha);
+        fixedPoint_agcInstance_setDeadband(fixedAgcPtr,deadbandInDb);
+        fixedPoint_agcInstance_enable(fixedAgcPtr);
+
+        mismatchCount = 0;
+        maxSettingDifference = 0;
+        stepsAtLevel = 0;
+        inputLevelInDbFs = -40;
+
+        for (step = 0; step < NUMBER_OF_STEPS; step++)
+        {
+          // Occasional level steps with a little noise on top.
+          if ((rand() % 500) == 0)
+          {
+            inputLevelInDbFs = -(rand() % 80);
+            stepsAtLevel = 0;
+          } // if
+
+          stepsAtLevel++;
+
+          noiseInDb = (rand() % 3) - 1;
+
+          agcInstance_acceptData(floatAgcPtr,
+            computeMagnitude(inputLevelInDbFs + noiseInDb,
+                             floatAmplifier.gainInDb));
+
+          fixedPoint_agcInstance_acceptData(fixedAgcPtr,
+            computeMagnitude(inputLevelInDbFs + noiseInDb,
+                             fixedAmplifier.gainInDb));
+
+          settingDifference =
+            (floatAmplifier.setting > fixedAmplifier.setting) ?
+            floatAmplifier.setting - fixedAmplifier.setting :
+            fixedAmplifier.setting - floatAmplifier.setting;
+
+          if (settingDifference != 0)
+          {
+            mismatchCount++;
+          } // if
+
+          if ((stepsAtLevel > SETTLING_STEPS) &&
+              (settingDifference > maxSettingDifference))
+          {
+            maxSettingDifference = settingDifference;
+          } // if
+        } // for
+
+        printf("%s alpha %5.3f deadband %u dB: "
+               "%u of %u settings differ, settled difference %u %s\n",
+               stepped ? "steps " : "linear",
+               alpha,deadbandInDb,mismatchCount,
+               NUMBER_OF_STEPS,maxSettingDifference,
+               stepped ? "steps" : "dB");
+
+        if ((maxSettingDifference > MAX_SETTING_DIFFERENCE) ||
+            (mismatchCount > (NUMBER_OF_STEPS * MAX_MISMATCH_FRACTION)))
+        {
+          success = 0;
+        } // if
+      } // for
+    } // for
+  } // for
+
+  agcInstance_destroy(floatAgcPtr);
+  fixedPoint_agcInstance_destroy(fixedAgcPtr);
+
+  if (success)
+  {
+    printf("PASS\n");
+  } // if
+  else
+  {
+    printf("FAIL\n");
+  } // else
+
+  return (success ? 0 : 1);
+
+} // main
@@ -0,0 +1,143 @@
+//*******************************************************************
+// File: traceToCsv.cc
+// This program converts a trace file that was written by an AGC
+// trace recorder into comma separated values, with one line per
+// invocation of the AGC.  The levels are named as they are in the
+// paper by Harris et. al: x is the signal level before amplification,
+// y is the amplified signal level, e is the gain error, and g is the
+// filtered gain.
+//
+// Usage: traceToCsv traceFile > trace.csv
+//*******************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "agcTraceRecorder.h"
+
+// The number of records that are read at a time.
+#define RECORDS_PER_READ (4096)
+
+/**************************************************************************
+
+  Name: isHeaderValid
+
+  Purpose: The purpose of this function is to verify that a trace file
+  header was written by a compatible trace recorder.
+
+  Calling Sequence: valid = isHeaderValid(headerPtr)
+
+  Inputs:
+
+    headerPtr - A pointer to the header.
+
+  Outputs:
+
+    valid - A flag that indicates whether or not the header is valid.
+    A value of 1 indicates that it is valid, and a value of 0 indicates
+    that it is not.
+
+**************************************************************************/
+static int isHeaderValid(const struct agcTraceFileHeader *headerPtr)
+{
+  int valid;
+
+  valid = 1;
+
+  if (memcmp(headerPtr->magic,AGC_TRACE_MAGIC,sizeof(headerPtr->magic)) != 0)
+  {
+    fprintf(stderr,"Not an AGC trace file.\n");
+    valid = 0;
+  } // if
+  else
+  {
+    if (headerPtr->version != AGC_TRACE_VERSION)
+    {
+      fprintf(stderr,"Unsupported trace version %u.\n",headerPtr->version);
+      valid = 0;
+    } // if
+    else
+    {
+      if (headerPtr->recordSize != sizeof(struct agcTraceRecord))
+      {
+        fprintf(stderr,"Unexpected record size %u.\n",headerPtr->recordSize);
+        valid = 0;
+      } // if
+    } // else
+  } // else
+
+  return (valid);
+
+} // isHeaderValid
+
+//************************************************************
+// Mainline code.
+//************************************************************
+int main(int argc,char **argv)
+{
+  FILE *filePtr;
+  size_t i;
+  size_t count;
+  struct agcTraceFileHeader header;
+  static struct agcTraceRecord records[RECORDS_PER_READ];
+
+  if (argc != 2)
+  {
+    fprintf(stderr,"Usage: %s traceFile\n",argv[0]);
+    return (1);
+  } // if
+
+  filePtr = fopen(argv[1],"rb");
+
+  if (filePtr == NULL)
+  {
+    fprintf(stderr,"Could not open %s.\n",argv[1]);
+    return (1);
+  } // if
+
+  if (fread(&header,sizeof(header),1,filePtr) != 1)
+  {
+    fprintf(stderr,"Could not read the header.\n");
+    fclose(filePtr);
+    return (1);
+  } // if
+
+  if (!isHeaderValid(&header))
+  {
+    fclose(filePtr);
+    return (1);
+  } // if
+
+  printf("time,x,y,e,g,gainInDb,blankingCounter,"
+         "blanked,hardwareWrite,deadband,minClamp,maxClamp,overload\n");
+
+  while ((count = fread(records,
+                        sizeof(struct agcTraceRecord),
+                        RECORDS_PER_READ,
+                        filePtr)) != 0)
+  {
+    for (i = 0; i < count; i++)
+    {
+      printf("%llu,%d,%d,%d,%.5f,%u,%u,%d,%d,%d,%d,%d,%d\n",
+             (unsigned long long)records[i].time,
+             records[i].normalizedSignalLevelInDbFs,
+             records[i].signalInDbFs,
+             records[i].gainError,
+             (double)records[i].filteredGainQ16 / 65536.0,
+             records[i].gainInDb,
+             records[i].blankingCounter,
+             (records[i].flags & AGC_TRACE_BLANKED) != 0,
+             (records[i].flags & AGC_TRACE_HARDWARE_WRITE) != 0,
+             (records[i].flags & AGC_TRACE_DEADBAND) != 0,
+             (records[i].flags & AGC_TRACE_MIN_GAIN_CLAMP) != 0,
+             (records[i].flags & AGC_TRACE_MAX_GAIN_CLAMP) != 0,
+             (records[i].flags & AGC_TRACE_OVERLOAD) != 0);
+    } // for
+  } // while
+
+  fclose(filePtr);
+
+  return (0);
+
+} // main
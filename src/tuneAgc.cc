@@ -0,0 +1,798 @@
+//*******************************************************************
+// File: tuneAgc.cc
+// This program searches for good AGC parameters.  Each candidate set
+// of parameters (filter coefficient, deadband, blanking limit and
+// operating point) is evaluated by running the AGC in a closed loop
+// around the simulated receiver of agcSimulator.h.  The input is either
+// one of the standard scenarios, or the signal levels of a trace file
+// that was written by an agcTraceRecorder.
+//
+// The candidates are either a grid of all combinations of the given
+// values, or random samples within their ranges.  They are independent,
+// so a pool of worker threads takes them one at a time from a shared
+// counter, each running its own AGC instance and simulator.
+//
+// Three objectives are minimized: the response time (the mean time to
+// converge after an event, where an event that never converges counts
+// for as long as it was tracked), the number of hardware writes, and
+// the steady-state error.  The candidates that are not dominated by
+// any other candidate form the Pareto front, which is printed as one
+// JSON object per line, ordered by response time:
+//
+//   {"alpha":0.300,"deadbandDb":1,"blankingLimit":4,
+//    "operatingPointDbFs":-12,"responseMs":24.1,"writesPerRun":130.6,
+//    "steadyStateErrorDb":0.82,"inBandFraction":0.985}
+//
+// Candidates that never reach a steady state are left off the front.
+//
+// Usage: tuneAgc [options] [scenario]
+//
+//   scenario         step, fading, bursty or noise-only (default step).
+//   -f traceFile     Use the levels of a trace file instead.
+//   -T blockUs       Block duration of the trace file (default 1000).
+//   -A alphas        Comma separated filter coefficients.
+//   -D deadbands     Comma separated deadbands.
+//   -B limits        Comma separated blanking limits.
+//   -O points        Comma separated operating points.
+//   -n count         Random search with this many candidates, within
+//                    the ranges of the lists, instead of the grid.
+//   -r runs          Runs per candidate (default 5).
+//   -j threads       Worker threads (default: all processors).
+//*******************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "AutomaticGainControl.h"
+#include "agcSimulator.h"
+#include "agcTraceRecorder.h"
+
+// The most values that a parameter list may have.
+#define MAX_LIST_LENGTH (32)
+
+// Trace levels that change by this much are events.
+#define TRACE_EVENT_THRESHOLD_IN_DB (10)
+
+// One set of parameters, and how well it did.
+struct candidate
+{
+  float alpha;
+  uint32_t deadbandInDb;
+  uint32_t blankingLimit;
+  int32_t operatingPointInDbFs;
+
+  double responseTimeInMs;
+  double writesPerRun;
+  double steadyStateErrorInDb;
+  double inBandFraction;
+  int reachedSteadyState;
+};
+
+// The work that is shared by the worker threads.
+struct tuningJob
+{
+  struct candidate *candidatePtr;
+  uint32_t candidateCount;
+
+  // The next candidate to evaluate.
+  uint32_t nextCandidate;
+
+  struct agcSimulatorConfig config;
+  struct agcScenario scenario;
+  uint32_t runCount;
+};
+
+/**************************************************************************
+
+  Name: setGainCallback
+
+  Purpose: The purpose of this function is to connect the AGC's set
+  gain callback to a simulator.
+
+  Calling Sequence: setGainCallback(contextPtr,gainInDb)
+
+  Inputs:
+
+    contextPtr - A pointer to the simulator.
+
+    gainInDb - The gain in decibels.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void setGainCallback(void *contextPtr,uint32_t gainInDb)
+{
+
+  agcSimulator_setGain((struct agcSimulator *)contextPtr,gainInDb);
+
+  return;
+
+} // setGainCallback
+
+/**************************************************************************
+
+  Name: getGainCallback
+
+  Purpose: The purpose of this function is to connect the AGC's get
+  gain callback to a simulator.
+
+  Calling Sequence: gainInDb = getGainCallback(contextPtr)
+
+  Inputs:
+
+    contextPtr - A pointer to the simulator.
+
+  Outputs:
+
+    gainInDb - The gain in decibels.
+
+**************************************************************************/
+static uint32_t getGainCallback(void *contextPtr)
+{
+
+  return (agcSimulator_getGain((struct agcSimulator *)contextPtr));
+
+} // getGainCallback
+
+/**************************************************************************
+
+  Name: evaluateCandidate
+
+  Purpose: The purpose of this function is to run the closed loop for
+  each seed with the parameters of a candidate, and to record the
+  average results in the candidate.
+
+  Calling Sequence: evaluateCandidate(jobPtr,candidatePtr)
+
+  Inputs:
+
+    jobPtr - A pointer to the job.
+
+    candidatePtr - A pointer to the candidate.
+
+  Outputs:
+
+    None.
+
+**************************************************************************/
+static void evaluateCandidate(const struct tuningJob *jobPtr,
+    struct candidate *candidatePtr)
+{
+  uint32_t run;
+  uint32_t signalMagnitude;
+  uint64_t timeInUs;
+  uint64_t blockCount;
+  uint64_t inBandBlockCount;
+  uint64_t steadyStateBlockCount;
+  double totalResponseTimeInUs;
+  double totalWrites;
+  double totalSquaredError;
+  struct agcSimulatorConfig config;
+  struct agcSimulatorResults results;
+  struct agcInstance *agcPtr;
+  struct agcSimulator *simulatorPtr;
+
+  config = jobPtr->config;
+  config.operatingPointInDbFs = candidatePtr->operatingPointInDbFs;
+
+  blockCount = 0;
+  inBandBlockCount = 0;
+  steadyStateBlockCount = 0;
+  totalResponseTimeInUs = 0;
+  totalWrites = 0;
+  totalSquaredError = 0;
+
+  agcPtr = agcInstance_create();
+
+  for (run = 0; run < jobPtr->runCount; run++)
+  {
+    config.seed = run + 1;
+
+    simulatorPtr = agcSimulator_create(&config,&jobPtr->scenario);
+
+    agcInstance_init(agcPtr,
+                     candidatePtr->operatingPointInDbFs,
+                     config.maxGainInDb,
+                     config.signalMagnitudeBitCount,
+                     setGainCallback,
+                     getGainCallback,
+                     simulatorPtr);
+
+    agcInstance_setAgcFilterCoefficient(agcPtr,candidatePtr->alpha);
+    agcInstance_setDeadband(agcPtr,candidatePtr->deadbandInDb);
+    agcInstance_setBlankingLimit(agcPtr,candidatePtr->blankingLimit);
+    agcInstance_enable(agcPtr);
+
+    while (agcSimulator_step(simulatorPtr,&signalMagnitude,&timeInUs))
+    {
+      agcInstance_acceptDataAt(agcPtr,signalMagnitude,timeInUs);
+    } // while
+
+    agcSimulator_getResults(simulatorPtr,&results);
+    agcSimulator_destroy(simulatorPtr);
+
+    blockCount += results.blockCount;
+    inBandBlockCount += results.inBandBlockCount;
+    steadyStateBlockCount += results.steadyStateBlockCount;
+    totalResponseTimeInUs += results.meanResponseTimeInUs;
+    totalWrites += (double)results.hardwareWriteCount;
+    totalSquaredError += results.steadyStateErrorInDb *
+      results.steadyStateErrorInDb * results.steadyStateBlockCount;
+  } // for
+
+  agcInstance_destroy(agcPtr);
+
+  candidatePtr->responseTimeInMs =
+    (totalResponseTimeInUs / jobPtr->runCount) * 1e-3;
+  candidatePtr->writesPerRun = totalWrites / jobPtr->runCount;
+  candidatePtr->inBandFraction = (double)inBandBlockCount / blockCount;
+  candidatePtr->reachedSteadyState = (steadyStateBlockCount != 0);
+  candidatePtr->steadyStateErrorInDb = 0;
+
+  if (candidatePtr->reachedSteadyState)
+  {
+    candidatePtr->steadyStateErrorInDb =
+      sqrt(totalSquaredError / steadyStateBlockCount);
+  } // if
+
+  return;
+
+} // evaluateCandidate
+
+/**************************************************************************
+
+  Name: runWorker
+
+  Purpose: The purpose of this function is to be the entry point of a
+  worker thread.  The thread evaluates candidates until there are none
+  left.
+
+  Calling Sequence: runWorker(argPtr)
+
+  Inputs:
+
+    argPtr - A pointer to the job.
+
+  Outputs:
+
+    NULL.
+
+**************************************************************************/
+static void *runWorker(void *argPtr)
+{
+  uint32_t i;
+  struct tuningJob *jobPtr;
+
+  jobPtr = (struct tuningJob *)argPtr;
+
+  while ((i = __atomic_fetch_add(&jobPtr->nextCandidate,
+                                 1,
+                                 __ATOMIC_RELAXED)) < jobPtr->candidateCount)
+  {
+    evaluateCandidate(jobPtr,&jobPtr->candidatePtr[i]);
+  } // while
+
+  return (NULL);
+
+} // runWorker
+
+/**************************************************************************
+
+  Name: dominates
+
+  Purpose: The purpose of this function is to determine whether or not
+  one candidate dominates another, which is the case when it is no
+  worse in every objective and better in at least one.
+
+  Calling Sequence: result = dominates(aPtr,bPtr)
+
+  Inputs:
+
+    aPtr - A pointer to the first candidate.
+
+    bPtr - A pointer to the second candidate.
+
+  Outputs:
+
+    result - A flag that indicates whether or not the first candidate
+    dominates the second.
+
+**************************************************************************/
+static int dominates(const struct candidate *aPtr,
+    const struct candidate *bPtr)
+{
+  int noWorse;
+  int better;
+
+  noWorse = (aPtr->responseTimeInMs <= bPtr->responseTimeInMs) &&
+            (aPtr->writesPerRun <= bPtr->writesPerRun) &&
+            (aPtr->steadyStateErrorInDb <= bPtr->steadyStateErrorInDb);
+
+  better = (aPtr->responseTimeInMs < bPtr->responseTimeInMs) ||
+           (aPtr->writesPerRun < bPtr->writesPerRun) ||
+           (aPtr->steadyStateErrorInDb < bPtr->steadyStateErrorInDb);
+
+  return (noWorse && better);
+
+} // dominates
+
+/**************************************************************************
+
+  Name: compareResponseTime
+
+  Purpose: The purpose of this function is to order candidates by
+  response time for qsort().
+
+  Calling Sequence: result = compareResponseTime(aPtr,bPtr)
+
+  Inputs:
+
+    aPtr - A pointer to the first candidate.
+
+    bPtr - A pointer to the second candidate.
+
+  Outputs:
+
+    result - Less than, equal to, or greater than zero.
+
+**************************************************************************/
+static int compareResponseTime(const void *aPtr,const void *bPtr)
+{
+  double a;
+  double b;
+
+  a = ((const struct candidate *)aPtr)->responseTimeInMs;
+  b = ((const struct candidate *)bPtr)->responseTimeInMs;
+
+  return ((a > b) - (a < b));
+
+} // compareResponseTime
+
+/**************************************************************************
+
+  Name: printParetoFront
+
+  Purpose: The purpose of this function is to print the candidates that
+  are not dominated by any other candidate.
+
+  Calling Sequence: frontSize = printParetoFront(candidatePtr,
+                                                 candidateCount)
+
+  Inputs:
+
+    candidatePtr - A pointer to the evaluated candidates.  They are
+    sorted by response time.
+
+    candidateCount - The number of candidates.
+
+  Outputs:
+
+    frontSize - The number of candidates on the front.
+
+**************************************************************************/
+static uint32_t printParetoFront(struct candidate *candidatePtr,
+    uint32_t candidateCount)
+{
+  uint32_t i;
+  uint32_t j;
+  uint32_t frontSize;
+  int dominated;
+
+  qsort(candidatePtr,candidateCount,sizeof(struct candidate),
+        compareResponseTime);
+
+  frontSize = 0;
+
+  for (i = 0; i < candidateCount; i++)
+  {
+    dominated = !candidatePtr[i].reachedSteadyState;
+
+    for (j = 0; (j < candidateCount) && !dominated; j++)
+    {
+      if (candidatePtr[j].reachedSteadyState)
+      {
+        dominated = dominates(&candidatePtr[j],&candidatePtr[i]);
+      } // if
+    } // for
+
+    if (!dominated)
+    {
+      printf("{\"alpha\":%.3f,\"deadbandDb\":%u,\"blankingLimit\":%u,"
+             "\"operatingPointDbFs\":%d,\"responseMs\":%.1f,"
+             "\"writesPerRun\":%.1f,\"steadyStateErrorDb\":%.2f,"
+             "\"inBandFraction\":%.3f}\n",
+             candidatePtr[i].alpha,
+             candidatePtr[i].deadbandInDb,
+             candidatePtr[i].blankingLimit,
+             candidatePtr[i].operatingPointInDbFs,
+             candidatePtr[i].responseTimeInMs,
+             candidatePtr[i].writesPerRun,
+             candidatePtr[i].steadyStateErrorInDb,
+             candidatePtr[i].inBandFraction);
+
+      frontSize++;
+    } // if
+  } // for
+
+  return (frontSize);
+
+} // printParetoFront
+
+/**************************************************************************
+
+  Name: parseList
+
+  Purpose: The purpose of this function is to parse a comma separated
+  list of numbers.
+
+  Calling Sequence: count = parseList(textPtr,valuePtr)
+
+  Inputs:
+
+    textPtr - The list.
+
+    valuePtr - Storage for up to MAX_LIST_LENGTH values.
+
+  Outputs:
+
+    count - The number of values, or 0 if the list is invalid.
+
+**************************************************************************/
+static uint32_t parseList(const char *textPtr,float *valuePtr)
+{
+  uint32_t count;
+  char *endPtr;
+
+  count = 0;
+
+  while ((*textPtr != '\0') && (count < MAX_LIST_LENGTH))
+  {
+    valuePtr[count] = strtof(textPtr,&endPtr);
+
+    if (endPtr == textPtr)
+    {
+      return (0);
+    } // if
+
+    count++;
+
+    textPtr = (*endPtr == ',') ? endPtr + 1 : endPtr;
+  } // while
+
+  return (count);
+
+} // parseList
+
+/**************************************************************************
+
+  Name: loadTrace
+
+  Purpose: The purpose of this function is to read the signal levels
+  before amplification, x(n), from a trace file.
+
+  Calling Sequence: levelPtr = loadTrace(fileNamePtr,countPtr)
+
+  Inputs:
+
+    fileNamePtr - The name of the trace file.
+
+    countPtr - A pointer to storage for the number of levels.
+
+  Outputs:
+
+    levelPtr - The levels, which the caller must free.  A value of NULL
+    indicates that the file could not be read.
+
+**************************************************************************/
+static float *loadTrace(const char *fileNamePtr,uint32_t *countPtr)
+{
+  FILE *filePtr;
+  float *levelPtr;
+  uint32_t capacity;
+  struct agcTraceFileHeader header;
+  struct agcTraceRecord record;
+
+  levelPtr = NULL;
+  *countPtr = 0;
+
+  filePtr = fopen(fileNamePtr,"rb");
+
+  if (filePtr == NULL)
+  {
+    return (NULL);
+  } // if
+
+  if ((fread(&header,sizeof(header),1,filePtr) == 1) &&
+      (memcmp(header.magic,AGC_TRACE_MAGIC,sizeof(header.magic)) == 0) &&
+      (header.version == AGC_TRACE_VERSION) &&
+      (header.recordSize == sizeof(struct agcTraceRecord)))
+  {
+    capacity = 0;
+
+    while (fread(&record,sizeof(record),1,filePtr) == 1)
+    {
+      if (*countPtr == capacity)
+      {
+        capacity = (capacity == 0) ? 65536 : capacity * 2;
+        levelPtr = (float *)realloc(levelPtr,capacity * sizeof(float));
+      } // if
+
+      levelPtr[(*countPtr)++] = record.normalizedSignalLevelInDbFs;
+    } // while
+  } // if
+
+  fclose(filePtr);
+
+  return (levelPtr);
+
+} // loadTrace
+
+//************************************************************
+// Mainline code.
+//************************************************************
+int main(int argc,char **argv)
+{
+  int option;
+  uint32_t i;
+  uint32_t a;
+  uint32_t d;
+  uint32_t b;
+  uint32_t o;
+  uint32_t threadCount;
+  uint32_t randomCount;
+  uint32_t alphaCount;
+  uint32_t deadbandCount;
+  uint32_t blankingCount;
+  uint32_t operatingPointCount;
+  uint32_t frontSize;
+  uint32_t levelCount;
+  uint32_t blockDurationInUs;
+  float alphas[MAX_LIST_LENGTH] = {0.1f,0.2f,0.3f,0.5f,0.7f,0.9f};
+  float deadbands[MAX_LIST_LENGTH] = {0,1,2,3};
+  float blankingLimits[MAX_LIST_LENGTH] = {0,1,2,4,8};
+  float operatingPoints[MAX_LIST_LENGTH] = {-18,-12,-6};
+  float *levelPtr;
+  const char *traceFileNamePtr;
+  const char *scenarioNamePtr;
+  struct tuningJob job;
+  struct timespec startTime;
+  struct timespec stopTime;
+  pthread_t *threadPtr;
+
+  alphaCount = 6;
+  deadbandCount = 4;
+  blankingCount = 5;
+  operatingPointCount = 3;
+
+  agcSimulator_getDefaultConfig(&job.config);
+  job.runCount = 5;
+
+  threadCount = (uint32_t)sysconf(_SC_NPROCESSORS_ONLN);
+  randomCount = 0;
+  traceFileNamePtr = NULL;
+  blockDurationInUs = 1000;
+  levelPtr = NULL;
+
+  while ((option = getopt(argc,argv,"f:T:A:D:B:O:n:r:j:")) != -1)
+  {
+    switch (option)
+    {
+      case 'f':
+      {
+        traceFileNamePtr = optarg;
+        break;
+      } // case
+
+      case 'T':
+      {
+        blockDurationInUs = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'A':
+      {
+        alphaCount = parseList(optarg,alphas);
+        break;
+      } // case
+
+      case 'D':
+      {
+        deadbandCount = parseList(optarg,deadbands);
+        break;
+      } // case
+
+      case 'B':
+      {
+        blankingCount = parseList(optarg,blankingLimits);
+        break;
+      } // case
+
+      case 'O':
+      {
+        operatingPointCount = parseList(optarg,operatingPoints);
+        break;
+      } // case
+
+      case 'n':
+      {
+        randomCount = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'r':
+      {
+        job.runCount = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      case 'j':
+      {
+        threadCount = (uint32_t)atoi(optarg);
+        break;
+      } // case
+
+      default:
+      {
+        fprintf(stderr,"Usage: %s [-f traceFile] [-T blockUs] "
+                "[-A alphas] [-D deadbands] [-B limits] [-O points] "
+                "[-n count] [-r runs] [-j threads] [scenario]\n",
+                argv[0]);
+        return (1);
+      } // case
+    } // switch
+  } // while
+
+  if ((alphaCount == 0) || (deadbandCount == 0) || (blankingCount == 0) ||
+      (operatingPointCount == 0))
+  {
+    fprintf(stderr,"Invalid parameter list.\n");
+    return (1);
+  } // if
+
+  threadCount = (threadCount == 0) ? 1 : threadCount;
+  job.runCount = (job.runCount == 0) ? 1 : job.runCount;
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Set up the input.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  if (traceFileNamePtr != NULL)
+  {
+    levelPtr = loadTrace(traceFileNamePtr,&levelCount);
+
+    if ((levelPtr == NULL) || (blockDurationInUs == 0))
+    {
+      fprintf(stderr,"Could not read the trace file %s.\n",
+              traceFileNamePtr);
+      return (1);
+    } // if
+
+    memset(&job.scenario,0,sizeof(job.scenario));
+    job.scenario.type = AGC_SCENARIO_RECORDED;
+    job.scenario.recordedLevelsPtr = levelPtr;
+    job.scenario.recordedLevelCount = levelCount;
+    job.scenario.eventThresholdInDb = TRACE_EVENT_THRESHOLD_IN_DB;
+    job.scenario.durationInUs = (uint64_t)levelCount * blockDurationInUs;
+    job.config.blockDurationInUs = blockDurationInUs;
+
+    // The recording is the same on every run.
+    job.runCount = 1;
+  } // if
+  else
+  {
+    scenarioNamePtr = (optind < argc) ? argv[optind] : "step";
+
+    if (!agcSimulator_getScenario(scenarioNamePtr,&job.scenario))
+    {
+      fprintf(stderr,"Unknown scenario: %s\n",scenarioNamePtr);
+      return (1);
+    } // if
+  } // else
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Generate the candidates.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  if (randomCount != 0)
+  {
+    job.candidateCount = randomCount;
+  } // if
+  else
+  {
+    job.candidateCount = alphaCount * deadbandCount * blankingCount *
+      operatingPointCount;
+  } // else
+
+  job.candidatePtr =
+    (struct candidate *)calloc(job.candidateCount,sizeof(struct candidate));
+  job.nextCandidate = 0;
+
+  if (randomCount != 0)
+  {
+    // Make the search repeatable.
+    srand(1);
+
+    for (i = 0; i < randomCount; i++)
+    {
+      job.candidatePtr[i].alpha = alphas[0] +
+        ((alphas[alphaCount - 1] - alphas[0]) * rand() / (float)RAND_MAX);
+      job.candidatePtr[i].deadbandInDb = (uint32_t)deadbands[0] +
+        rand() % ((uint32_t)(deadbands[deadbandCount - 1] - deadbands[0]) + 1);
+      job.candidatePtr[i].blankingLimit = (uint32_t)blankingLimits[0] +
+        rand() % ((uint32_t)(blankingLimits[blankingCount - 1] -
+                             blankingLimits[0]) + 1);
+      job.candidatePtr[i].operatingPointInDbFs =
+        (int32_t)operatingPoints[rand() % operatingPointCount];
+    } // for
+  } // if
+  else
+  {
+    i = 0;
+
+    for (a = 0; a < alphaCount; a++)
+    {
+      for (d = 0; d < deadbandCount; d++)
+      {
+        for (b = 0; b < blankingCount; b++)
+        {
+          for (o = 0; o < operatingPointCount; o++)
+          {
+            job.candidatePtr[i].alpha = alphas[a];
+            job.candidatePtr[i].deadbandInDb = (uint32_t)deadbands[d];
+            job.candidatePtr[i].blankingLimit = (uint32_t)blankingLimits[b];
+            job.candidatePtr[i].operatingPointInDbFs =
+              (int32_t)operatingPoints[o];
+            i++;
+          } // for
+        } // for
+      } // for
+    } // for
+  } // else
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  // Evaluate the candidates with a pool of worker threads.
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+  clock_gettime(CLOCK_MONOTONIC,&startTime);
+
+  threadPtr = new pthread_t[threadCount];
+
+  for (i = 0; i < threadCount; i++)
+  {
+    pthread_create(&threadPtr[i],NULL,runWorker,&job);
+  } // for
+
+  for (i = 0; i < threadCount; i++)
+  {
+    pthread_join(threadPtr[i],NULL);
+  } // for
+
+  delete[] threadPtr;
+
+  clock_gettime(CLOCK_MONOTONIC,&stopTime);
+  //_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/_/
+
+  frontSize = printParetoFront(job.candidatePtr,job.candidateCount);
+
+  fprintf(stderr,"%u candidates, %u runs each, %u threads, %.2f seconds, "
+          "%u on the Pareto front\n",
+          job.candidateCount,
+          job.runCount,
+          threadCount,
+          (double)(stopTime.tv_sec - startTime.tv_sec) +
+            ((double)(stopTime.tv_nsec - startTime.tv_nsec) * 1e-9),
+          frontSize);
+
+  free(job.candidatePtr);
+  free(levelPtr);
+
+  return (0);
+
+} // main